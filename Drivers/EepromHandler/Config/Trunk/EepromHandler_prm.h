@@ -87,6 +87,15 @@
 /// define the page write time
 #define EEPROMHANDLER_PAGE_WRITE_MSECS              ( 10 )
 
+/// define the macro to enable the page write-back cache ( dirty pages are only
+/// written on replacement or EepromHandler_Flush )
+#define EEPROMHANDLER_ENABLE_PAGE_CACHE             ( 0 )
+
+#if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+/// define the number of cached pages
+#define EEPROMHANDLER_PAGE_CACHE_NUM_PAGES          ( 4 )
+#endif
+
 #endif  // _EEPROMHANDLER_PRM_H
 
 /**@} EOF EepromHandler_prm.h */
@@ -38,9 +38,35 @@
   #define BLOCK_WRITEMOD_BIT_MASK( addr )     ( addr % ( EEPROMHANDLER_BLK_SIZE * 8 ))
 #endif // EEPROMHANDLER_ENABLE_BACKGROUND_WRITES
 
+#if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+  #if (( EEPROMHANDLER_ENABLE_EMULATION == 1 ) || ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 1 ))
+    #error The page cache can not be used with emulation or background writes in EepromHandler_prm.h
+  #endif
+  #if (( EEPROMHANDLER_BLK_SIZE & ( EEPROMHANDLER_BLK_SIZE - 1 )) != 0 )
+    #error The page cache requires the block size to be a power of two in EepromHandler_prm.h
+  #endif
+
+  /// define the macros to get the page base address/offset
+  #define PAGE_BASE_ADDR( addr )              (( U16 )(( addr ) & ~( EEPROMHANDLER_BLK_SIZE - 1 )))
+  #define PAGE_OFFSET( addr )                 (( U16 )(( addr ) & ( EEPROMHANDLER_BLK_SIZE - 1 )))
+#endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
+#if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+/// define the cached page structure
+typedef struct _CACHEPAGE
+{
+  U16   wBaseAddr;                          ///< page base address
+  U16   wLastUse;                           ///< use stamp for replacement
+  U16   wDirtyStart;                        ///< first modified offset
+  U16   wDirtyEnd;                          ///< last modified offset + 1, 0 if clean
+  BOOL  bValid;                             ///< page is loaded
+  U8    anData[ EEPROMHANDLER_BLK_SIZE ];   ///< page data
+} CACHEPAGE, *PCACHEPAGE;
+#define CACHEPAGE_SIZE    sizeof( CACHEPAGE )
+#endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
 
 // global parameter declarations ----------------------------------------------
 
@@ -52,6 +78,10 @@ static  BOOL      bCheckForBusyRequired;
 #if ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 1 )
   static  U8        anBlockModifiedStatus[ BLOCK_WRITEMOD_SIZE ];
 #endif // EEPROMHANDLER_ENABLE_BACKGROUND_WRITES
+#if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+  static  CACHEPAGE atCache[ EEPROMHANDLER_PAGE_CACHE_NUM_PAGES ];
+  static  U16       wCacheUseStamp;
+#endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
 
 // command handlers
 #if ( EEPROMHANDLER_ENABLE_DEBUGCOMMANDS == 1 )
@@ -66,6 +96,18 @@ static  BOOL      bCheckForBusyRequired;
   static  EEPROMERR  WriteBlock( U16 wAddress, U8 nBlkLength, PU8 pnData );
 #endif // EEPROMHANDLER_ENABLE_EMULATION
 
+#if (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 0 ))
+  static  EEPROMERR  ReadDevice( U16 wAddress, U16 wLength, PU8 pnData );
+#endif // EEPROMHANDLER_ENABLE_EMULATION
+
+#if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+  static  EEPROMERR  ReadCached( U16 wAddress, U16 wLength, PU8 pnData );
+  static  EEPROMERR  WriteCached( U16 wAddress, U16 wLength, PU8 pnData );
+  static  PCACHEPAGE FindPage( U16 wBaseAddr );
+  static  EEPROMERR  AllocPage( U16 wBaseAddr, BOOL bLoad, PCACHEPAGE* pptPage );
+  static  EEPROMERR  WritePage( PCACHEPAGE ptPage );
+#endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
+
 #if (( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 1 ) || ( EEPROMHANDLER_ENABLE_EMULATION == 0 ))
   static  BOOL       CheckForBusy( void );
 #endif // EEPROMHANDLER_ENABLE_BACKGROUND_WRITES
@@ -111,6 +153,12 @@ void EepromHandler_Initialize( void )
     memset( anEeprom, 0xFF, EEPROMHANDLER_DEV_SIZE );
   #endif // EEPROMHANDLER_ENABLE_EMULATION
   
+  #if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+    // invalidate the cache
+    memset( atCache, 0, sizeof( atCache ));
+    wCacheUseStamp = 0;
+  #endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
+
   // call the local initialization
   EepromHandler_LclInitialize( );
 }
@@ -304,40 +352,20 @@ EEPROMERR EepromHandler_RdLong( U16 wAddress, PU32 puData )
 EEPROMERR EepromHandler_RdBlock( U16 wAddress, U16 wLength, PU8 pnData )
 {
   EEPROMERR   eError = EEPROM_ERR_NONE;
-  #if (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 0 ))
-    U32         uTime;
-  #endif // EEPROMHANDLER_ENABLE_EMULATION
 
   // check to see if valid address
   if(( wAddress + wLength ) < EEPROMHANDLER_DEV_SIZE )
   {
-    #if (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 0 ))
-      // get the current time
-      uTime = EepromHandler_GetSystemTime( ) + WAIT_FOR_BUSY_DONE_TIME;
-
-      // wait till done
-      while(( bCheckForBusyRequired = CheckForBusy( )) == TRUE )
-      {
-        // check for timeout
-        if ( EepromHandler_GetSystemTime( ) >= uTime )
-        {
-          // timeout occured - flag error
-          eError = EEPROM_ERR_DEVBUSY;
-          break;
-        }
-      }
-    #endif // EEPROMHANDLER_ENABLE_EMULATION
-  
-    // do not execute if busy
-    if ( eError == EEPROM_ERR_NONE )
-    {
-      #if (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 0 ))
-        eError = ( EepromHandler_LclRdBlock( wAddress, wLength, pnData )) ? EEPROM_ERR_I2CERR : EEPROM_ERR_NONE;
-      #else
-        // copy from the local area
-        memcpy( pnData, &anEeprom[ wAddress ], wLength ); 
-      #endif // EEPROMHANDLER_ENABLE_EMULATION
-    }
+    #if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+      // read through the cache
+      eError = ReadCached( wAddress, wLength, pnData );
+    #elif (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 0 ))
+      // read the device
+      eError = ReadDevice( wAddress, wLength, pnData );
+    #else
+      // copy from the local area
+      memcpy( pnData, &anEeprom[ wAddress ], wLength ); 
+    #endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
   }  
   else
   {
@@ -438,14 +466,17 @@ EEPROMERR EepromHandler_WrLong( U16 wAddress, U32 uData )
 EEPROMERR EepromHandler_WrBlock( U16 wAddress, U16 wLength, PU8 pnData )
 {
   EEPROMERR eError = EEPROM_ERR_NONE;
-  #if (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 0 ))
+  #if (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 0 ) && ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 0 ))
     U8        nBlkLength;
   #endif // EEPROMHANDLER_ENABLE_EMULATION
   
   // check to see if valid address
   if(( wAddress + wLength ) < EEPROMHANDLER_DEV_SIZE )
   {
-    #if (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 0 ))
+    #if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+      // write into the cache
+      eError = WriteCached( wAddress, wLength, pnData );
+    #elif (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 0 ))
       // while we still have bytes to write
       while( wLength != 0 )
       {
@@ -544,6 +575,333 @@ EEPROMERR EepromHandler_WrBlock( U16 wAddress, U16 wLength, PU8 pnData )
   }
 #endif // EEPROMHANDLER_ENABLE_EMULATION
 
+#if (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) && ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 0 ))
+  /******************************************************************************
+   * @function ReadDevice
+   *
+   * @brief read a block from the EEPROM
+   *
+   * This function will wait for the last write to complete and then read a 
+   * block of data from the device
+   *
+   * @param[in]   wAddress    address to read from
+   * @param[in]   wLength     length to read
+   * @param[io]   pnData      pointer to the data storage
+   *
+   * @return      error enumeration
+   *
+   *****************************************************************************/
+  static EEPROMERR ReadDevice( U16 wAddress, U16 wLength, PU8 pnData )
+  {
+    EEPROMERR eError = EEPROM_ERR_NONE;
+    U32       uTime;
+
+    // get the current time
+    uTime = EepromHandler_GetSystemTime( ) + WAIT_FOR_BUSY_DONE_TIME;
+
+    // wait till done
+    while(( bCheckForBusyRequired = CheckForBusy( )) == TRUE )
+    {
+      // check for timeout
+      if ( EepromHandler_GetSystemTime( ) >= uTime )
+      {
+        // timeout occured - flag error
+        eError = EEPROM_ERR_DEVBUSY;
+        break;
+      }
+    }
+
+    // do not execute if busy
+    if ( eError == EEPROM_ERR_NONE )
+    {
+      // read the block
+      eError = ( EepromHandler_LclRdBlock( wAddress, wLength, pnData )) ? EEPROM_ERR_I2CERR : EEPROM_ERR_NONE;
+    }
+
+    // return the error
+    return( eError );
+  }
+#endif // EEPROMHANDLER_ENABLE_EMULATION
+
+#if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+  /******************************************************************************
+   * @function EepromHandler_Flush
+   *
+   * @brief write all modified pages
+   *
+   * This function will write each modified page in the cache to the device,
+   * this is the sync point for the cache
+   *
+   * @return      error enumeration
+   *
+   *****************************************************************************/
+  EEPROMERR EepromHandler_Flush( void )
+  {
+    EEPROMERR eError = EEPROM_ERR_NONE;
+    U8        nIdx;
+
+    // for each page
+    for ( nIdx = 0; ( nIdx < EEPROMHANDLER_PAGE_CACHE_NUM_PAGES ) && ( eError == EEPROM_ERR_NONE ); nIdx++ )
+    {
+      // write it
+      eError = WritePage( &atCache[ nIdx ] );
+    }
+
+    // return the error
+    return( eError );
+  }
+
+  /******************************************************************************
+   * @function ReadCached
+   *
+   * @brief read a block through the cache
+   *
+   * This function will read the block from the device unless every page it 
+   * covers is cached, then overlay the cached pages
+   *
+   * @param[in]   wAddress    address to read from
+   * @param[in]   wLength     length to read
+   * @param[io]   pnData      pointer to the data storage
+   *
+   * @return      error enumeration
+   *
+   *****************************************************************************/
+  static EEPROMERR ReadCached( U16 wAddress, U16 wLength, PU8 pnData )
+  {
+    EEPROMERR   eError = EEPROM_ERR_NONE;
+    U16         wEndAddr, wPageAddr, wStart, wEnd;
+    BOOL        bAllCached = TRUE;
+    U8          nIdx;
+    PCACHEPAGE  ptPage;
+
+    // compute the end address
+    wEndAddr = wAddress + wLength;
+
+    // determine if every page is cached
+    for ( wPageAddr = PAGE_BASE_ADDR( wAddress ); ( wPageAddr < wEndAddr ) && ( bAllCached == TRUE ); wPageAddr += EEPROMHANDLER_BLK_SIZE )
+    {
+      bAllCached = ( FindPage( wPageAddr ) != NULL ) ? TRUE : FALSE;
+    }
+
+    // if not, read the device
+    if ( bAllCached == FALSE )
+    {
+      eError = ReadDevice( wAddress, wLength, pnData );
+    }
+
+    // now overlay the cached pages
+    for ( nIdx = 0; ( nIdx < EEPROMHANDLER_PAGE_CACHE_NUM_PAGES ) && ( eError == EEPROM_ERR_NONE ); nIdx++ )
+    {
+      // get the page/compute the overlap
+      ptPage = &atCache[ nIdx ];
+      wStart = MAX( wAddress, ptPage->wBaseAddr );
+      wEnd = MIN( wEndAddr, ptPage->wBaseAddr + EEPROMHANDLER_BLK_SIZE );
+
+      // copy if valid and overlapped
+      if (( ptPage->bValid == TRUE ) && ( wStart < wEnd ))
+      {
+        memcpy( &pnData[ wStart - wAddress ], &ptPage->anData[ wStart - ptPage->wBaseAddr ], wEnd - wStart );
+        ptPage->wLastUse = ++wCacheUseStamp;
+      }
+    }
+
+    // return the error
+    return( eError );
+  }
+
+  /******************************************************************************
+   * @function WriteCached
+   *
+   * @brief write a block into the cache
+   *
+   * This function will merge the block into the cached pages, loading the
+   * pages that are not cached and not completely overwritten
+   *
+   * @param[in]   wAddress    address to write to
+   * @param[in]   wLength     length of the data to write
+   * @param[in]   pnData      pointer to the data to write
+   *
+   * @return      error enumeration
+   *
+   *****************************************************************************/
+  static EEPROMERR WriteCached( U16 wAddress, U16 wLength, PU8 pnData )
+  {
+    EEPROMERR   eError = EEPROM_ERR_NONE;
+    U16         wOffset, wBlkLength;
+    PCACHEPAGE  ptPage;
+
+    // while we still have bytes to write
+    while(( wLength != 0 ) && ( eError == EEPROM_ERR_NONE ))
+    {
+      // compute the offset/length in this page
+      wOffset = PAGE_OFFSET( wAddress );
+      wBlkLength = MIN( EEPROMHANDLER_BLK_SIZE - wOffset, wLength );
+
+      // find the page/allocate it if not found
+      if (( ptPage = FindPage( PAGE_BASE_ADDR( wAddress ))) == NULL )
+      {
+        eError = AllocPage( PAGE_BASE_ADDR( wAddress ), ( wBlkLength != EEPROMHANDLER_BLK_SIZE ), &ptPage );
+      }
+
+      if ( eError == EEPROM_ERR_NONE )
+      {
+        // only modify if different
+        if ( memcmp( &ptPage->anData[ wOffset ], pnData, wBlkLength ) != 0 )
+        {
+          // copy the data
+          memcpy( &ptPage->anData[ wOffset ], pnData, wBlkLength );
+
+          // extend the modified area
+          if ( ptPage->wDirtyEnd == 0 )
+          {
+            ptPage->wDirtyStart = wOffset;
+            ptPage->wDirtyEnd = wOffset + wBlkLength;
+          }
+          else
+          {
+            ptPage->wDirtyStart = MIN( ptPage->wDirtyStart, wOffset );
+            ptPage->wDirtyEnd = MAX( ptPage->wDirtyEnd, wOffset + wBlkLength );
+          }
+        }
+
+        // update the use stamp
+        ptPage->wLastUse = ++wCacheUseStamp;
+
+        // adjust the address/length/data pointer
+        wAddress += wBlkLength;
+        wLength -= wBlkLength;
+        pnData += wBlkLength;
+      }
+    }
+
+    // return the error
+    return( eError );
+  }
+
+  /******************************************************************************
+   * @function FindPage
+   *
+   * @brief find a cached page
+   *
+   * This function will search the cache for a page
+   *
+   * @param[in]   wBaseAddr   page base address
+   *
+   * @return      pointer to the page, NULL if not cached
+   *
+   *****************************************************************************/
+  static PCACHEPAGE FindPage( U16 wBaseAddr )
+  {
+    PCACHEPAGE  ptPage = NULL;
+    U8          nIdx;
+
+    // for each page
+    for ( nIdx = 0; ( nIdx < EEPROMHANDLER_PAGE_CACHE_NUM_PAGES ) && ( ptPage == NULL ); nIdx++ )
+    {
+      // check for a match
+      if (( atCache[ nIdx ].bValid == TRUE ) && ( atCache[ nIdx ].wBaseAddr == wBaseAddr ))
+      {
+        ptPage = &atCache[ nIdx ];
+      }
+    }
+
+    // return the page
+    return( ptPage );
+  }
+
+  /******************************************************************************
+   * @function AllocPage
+   *
+   * @brief allocate a cache page
+   *
+   * This function will replace an empty or the least recently used page, 
+   * writing it if modified, and optionally load the new page from the device.
+ * A page that is not loaded is marked as modified in full
+   *
+   * @param[in]   wBaseAddr   page base address
+   * @param[in]   bLoad       TRUE to load the page from the device
+   * @param[io]   pptPage     pointer to store the page pointer
+   *
+   * @return      error enumeration
+   *
+   *****************************************************************************/
+  static EEPROMERR AllocPage( U16 wBaseAddr, BOOL bLoad, PCACHEPAGE* pptPage )
+  {
+    EEPROMERR   eError;
+    PCACHEPAGE  ptPage = &atCache[ 0 ];
+    U8          nIdx;
+
+    // find an empty page or the oldest
+    for ( nIdx = 1; ( nIdx < EEPROMHANDLER_PAGE_CACHE_NUM_PAGES ) && ( ptPage->bValid == TRUE ); nIdx++ )
+    {
+      if (( atCache[ nIdx ].bValid == FALSE ) || (( U16 )( wCacheUseStamp - atCache[ nIdx ].wLastUse ) > ( U16 )( wCacheUseStamp - ptPage->wLastUse )))
+      {
+        ptPage = &atCache[ nIdx ];
+      }
+    }
+
+    // write the old page
+    if (( eError = WritePage( ptPage )) == EEPROM_ERR_NONE )
+    {
+      // invalidate it
+      ptPage->bValid = FALSE;
+
+      // load if required
+      if ( bLoad == TRUE )
+      {
+        eError = ReadDevice( wBaseAddr, EEPROMHANDLER_BLK_SIZE, ptPage->anData );
+      }
+
+      // if no error, set the new page
+      if ( eError == EEPROM_ERR_NONE )
+      {
+        // a page that is not loaded does not match the device, it is all modified
+        ptPage->wBaseAddr = wBaseAddr;
+        ptPage->wDirtyStart = 0;
+        ptPage->wDirtyEnd = ( bLoad == TRUE ) ? 0 : EEPROMHANDLER_BLK_SIZE;
+        ptPage->bValid = TRUE;
+        *( pptPage ) = ptPage;
+      }
+    }
+
+    // return the error
+    return( eError );
+  }
+
+  /******************************************************************************
+   * @function WritePage
+   *
+   * @brief write a cached page
+   *
+   * This function will write the modified area of a cached page to the device
+   * as one page write
+   *
+   * @param[in]   ptPage      pointer to the page
+   *
+   * @return      error enumeration
+   *
+   *****************************************************************************/
+  static EEPROMERR WritePage( PCACHEPAGE ptPage )
+  {
+    EEPROMERR eError = EEPROM_ERR_NONE;
+
+    // only write if valid and modified
+    if (( ptPage->bValid == TRUE ) && ( ptPage->wDirtyEnd != 0 ))
+    {
+      // write it
+      if (( eError = WriteBlock( ptPage->wBaseAddr + ptPage->wDirtyStart, ( U8 )( ptPage->wDirtyEnd - ptPage->wDirtyStart ), &ptPage->anData[ ptPage->wDirtyStart ] )) == EEPROM_ERR_NONE )
+      {
+        // clear the modified area
+        ptPage->wDirtyStart = 0;
+        ptPage->wDirtyEnd = 0;
+      }
+    }
+
+    // return the error
+    return( eError );
+  }
+#endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
+
 #if (( EEPROMHANDLER_ENABLE_EMULATION == 0 ) || ( EEPROMHANDLER_ENABLE_BACKGROUND_WRITES == 1 ))
   /******************************************************************************
    * @function CheckForBusy
@@ -84,6 +84,9 @@ extern  EEPROMERR  EepromHandler_WrByte( U16 wAddress, U8 nData );
 extern  EEPROMERR  EepromHandler_WrWord( U16 wAddress, U16 wData );
 extern  EEPROMERR  EepromHandler_WrLong( U16 wAddress, U32 uData );
 extern  EEPROMERR  EepromHandler_WrBlock( U16 wAddress, U16 wLength, PU8 pnData );
+#if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+extern  EEPROMERR  EepromHandler_Flush( void );
+#endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
 
 /**@} EOF EepromHandler.h */
 
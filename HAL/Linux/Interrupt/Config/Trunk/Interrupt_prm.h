@@ -0,0 +1,49 @@
+/******************************************************************************
+ * @file Interrupt_prm.h
+ *
+ * @brief interrupt parameter declarations
+ *
+ * This file declares the parameters for the interrupt manager
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ * 
+ *
+ * \addtogroup Interrupt
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instatiation
+#ifndef _INTERRUPT_PRM_H
+#define _INTERRUPT_PRM_H
+
+// Macros and Defines ---------------------------------------------------------
+/// define the macro to enable blocking signals in a critical section - set to 1 to enable
+#define INTERRUPT_ENABLE_SIGNALMASK       ( 1 )
+
+/// define the macro to enable the thread lock in a critical section - set to 1 to enable
+#define INTERRUPT_ENABLE_THREADLOCK       ( 0 )
+
+/// define the number of spins before the thread lock waits in the kernel
+#define INTERRUPT_LOCK_SPIN_COUNT         ( 100 )
+
+/// define the macro to enable the lock hold time statistics - set to 1 to enable
+#define INTERRUPT_ENABLE_HOLDSTATS        ( 0 )
+
+/// define the number of histogram buckets, each doubling the hold time in usecs
+#define INTERRUPT_HOLDSTATS_NUM_BUCKETS   ( 16 )
+
+/// define the number of critical section callers tracked
+#define INTERRUPT_HOLDSTATS_NUM_SITES     ( 32 )
+
+/**@} EOF Interrupt_prm.h */
+
+#endif  // _INTERRUPT_PRM_H
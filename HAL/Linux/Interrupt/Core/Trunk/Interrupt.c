@@ -21,6 +21,14 @@
  * @{
  *****************************************************************************/
 
+// system includes ------------------------------------------------------------
+#include <sched.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
 // local includes -------------------------------------------------------------
 #include "Interrupt/Interrupt.h"
 
@@ -28,6 +36,19 @@
 #include "Types/Types.h"
 
 // Macros and Defines ---------------------------------------------------------
+/// define the lock states
+#define LOCK_STATE_FREE           ( 0 )
+#define LOCK_STATE_LOCKED         ( 1 )
+#define LOCK_STATE_CONTENDED      ( 2 )
+
+/// define the nanoseconds per second/microsecond
+#define NSECS_PER_SEC             ( 1000000000ull )
+#define NSECS_PER_USEC            ( 1000ull )
+
+/// the thread lock is not recursive, a signal taken while its thread holds the lock would deadlock
+#if (( INTERRUPT_ENABLE_THREADLOCK == 1 ) && ( INTERRUPT_ENABLE_SIGNALMASK == 0 ))
+  #error The thread lock requires INTERRUPT_ENABLE_SIGNALMASK in Interrupt_prm.h
+#endif
 
 // enumerations ---------------------------------------------------------------
 
@@ -36,37 +57,100 @@
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
+static  __thread  U32       uNestLevel;       ///< critical section nesting level
+#if ( INTERRUPT_ENABLE_SIGNALMASK == 1 )
+static  __thread  sigset_t  tSavedMask;       ///< signal mask prior to outermost disable
+#endif // INTERRUPT_ENABLE_SIGNALMASK
+#if ( INTERRUPT_ENABLE_THREADLOCK == 1 )
+static  U32                 uLockWord;        ///< futex lock word
+#endif // INTERRUPT_ENABLE_THREADLOCK
+#if ( INTERRUPT_ENABLE_HOLDSTATS == 1 )
+static  __thread  U64       hHoldStartNsec;   ///< time of the outermost disable
+static  __thread  PVOID     pvHoldCaller;     ///< caller of the outermost disable
+static  U32                 auHoldBuckets[ INTERRUPT_HOLDSTATS_NUM_BUCKETS ];
+static  INTERRUPTHOLDSITE   atHoldSites[ INTERRUPT_HOLDSTATS_NUM_SITES ];
+#endif // INTERRUPT_ENABLE_HOLDSTATS
 
 // local function prototypes --------------------------------------------------
+#if ( INTERRUPT_ENABLE_THREADLOCK == 1 )
+static  void  LockAcquire( void );
+static  void  LockRelease( void );
+#endif // INTERRUPT_ENABLE_THREADLOCK
+#if ( INTERRUPT_ENABLE_HOLDSTATS == 1 )
+static  U64   GetMonotonicNsec( void );
+static  void  RecordHoldTime( PVOID pvCaller, U64 hHoldNsec );
+#endif // INTERRUPT_ENABLE_HOLDSTATS
 
 /******************************************************************************
  * @function Interrupt_Initializle
  *
  * @brief intialize the interrupt handler
  *
- * This function resets the stack level index
+ * This function resets the nesting level, the lock and the statistics
  *
  *****************************************************************************/
 void Interrupt_Initialize( void )
 {
+  // reset the nesting level
+  uNestLevel = 0;
+  
+  #if ( INTERRUPT_ENABLE_THREADLOCK == 1 )
+  // free the lock
+  __atomic_store_n( &uLockWord, LOCK_STATE_FREE, __ATOMIC_RELEASE );
+  #endif // INTERRUPT_ENABLE_THREADLOCK
+  
+  #if ( INTERRUPT_ENABLE_HOLDSTATS == 1 )
+  // clear the statistics
+  Interrupt_ResetHoldStats( );
+  #endif // INTERRUPT_ENABLE_HOLDSTATS
 }
 
-
 /******************************************************************************
  * @function Interrupt_Disable
  *
  * @brief disable the global interrupts
  *
- * This function will disable the interrupts and if there is room in the stack
- * store the previous function of the interrupt enable state
+ * This function will enter a critical section.  On the outermost call all
+ * signals are blocked, saving the previous mask, and the thread lock is 
+ * taken.  Nested calls only increment the nesting level.  The level is only
+ * set after the signals are blocked, so a signal can never see a nested level
+ * before the lock is held
  *
  *****************************************************************************/
 void Interrupt_Disable( void )
 {
-  U32 uFlags;
+  #if ( INTERRUPT_ENABLE_SIGNALMASK == 1 )
+  sigset_t  tBlockMask;
+  #endif // INTERRUPT_ENABLE_SIGNALMASK
   
-  // disable interrupt
-//  local_irq_save( uFlags );
+  // only the outermost call does the work
+  if ( uNestLevel == 0 )
+  {
+    #if ( INTERRUPT_ENABLE_SIGNALMASK == 1 )
+    // block all signals, signals first so a handler cannot deadlock on the lock
+    sigfillset( &tBlockMask );
+    pthread_sigmask( SIG_BLOCK, &tBlockMask, &tSavedMask );
+    #endif // INTERRUPT_ENABLE_SIGNALMASK
+    
+    // now enter the section
+    uNestLevel = 1;
+    
+    #if ( INTERRUPT_ENABLE_THREADLOCK == 1 )
+    // take the lock
+    LockAcquire( );
+    #endif // INTERRUPT_ENABLE_THREADLOCK
+    
+    #if ( INTERRUPT_ENABLE_HOLDSTATS == 1 )
+    // store the start time and caller
+    pvHoldCaller = __builtin_return_address( 0 );
+    hHoldStartNsec = GetMonotonicNsec( );
+    #endif // INTERRUPT_ENABLE_HOLDSTATS
+  }
+  else
+  {
+    // just nest
+    uNestLevel++;
+  }
 }
 
 /******************************************************************************
@@ -74,26 +158,276 @@ void Interrupt_Disable( void )
  *
  * @brief restores the previous state of the interrupt enable
  *
- * This function will restore the previous state if one is in the stack
- * otherwise it will just enable interrupts.
+ * This function will exit a critical section.  On the outermost call the
+ * lock is released, the level cleared while the signals are still blocked,
+ * and the previous signal mask is restored
  *
  * @return  the current interrupt enable state
  *
  *****************************************************************************/
 BOOL Interrupt_Enable( void )
 {
-  U32   uFlags;
-  BOOL  bIrqStatus = FALSE;
-  
-  // restore interrupts
-//  local_irq_restore( uFlags );
+  // only if in a critical section
+  if ( uNestLevel != 0 )
+  {
+    // check for outermost
+    if ( uNestLevel == 1 )
+    {
+      #if ( INTERRUPT_ENABLE_HOLDSTATS == 1 )
+      // record the hold time while still locked
+      RecordHoldTime( pvHoldCaller, GetMonotonicNsec( ) - hHoldStartNsec );
+      #endif // INTERRUPT_ENABLE_HOLDSTATS
+      
+      #if ( INTERRUPT_ENABLE_THREADLOCK == 1 )
+      // release the lock
+      LockRelease( );
+      #endif // INTERRUPT_ENABLE_THREADLOCK
+      
+      // leave the section
+      uNestLevel = 0;
+      
+      #if ( INTERRUPT_ENABLE_SIGNALMASK == 1 )
+      // restore the signals
+      pthread_sigmask( SIG_SETMASK, &tSavedMask, NULL );
+      #endif // INTERRUPT_ENABLE_SIGNALMASK
+    }
+    else
+    {
+      // just unnest
+      uNestLevel--;
+    }
+  }
   
   // return the state of the interrupts
-  return( bIrqStatus );
+  return(( uNestLevel == 0 ) ? TRUE : FALSE );
 }
 
-/**@} EOF Interrupt.c */
+#if ( INTERRUPT_ENABLE_HOLDSTATS == 1 )
+/******************************************************************************
+ * @function Interrupt_ResetHoldStats
+ *
+ * @brief reset the hold statistics
+ *
+ * This function clears the histogram and the caller table
+ *
+ *****************************************************************************/
+void Interrupt_ResetHoldStats( void )
+{
+  // clear them in a critical section
+  Interrupt_Disable( );
+  memset( auHoldBuckets, 0, sizeof( auHoldBuckets ));
+  memset( atHoldSites, 0, sizeof( atHoldSites ));
+  Interrupt_Enable( );
+}
+
+/******************************************************************************
+ * @function Interrupt_GetHoldHistogram
+ *
+ * @brief get the hold time histogram
+ *
+ * This function copies the histogram, bucket 0 holds times under 1 usec and
+ * each following bucket doubles the range, the last holding all longer times
+ *
+ * @param[io]   puBuckets   pointer to storage for INTERRUPT_HOLDSTATS_NUM_BUCKETS
+ *
+ *****************************************************************************/
+void Interrupt_GetHoldHistogram( PU32 puBuckets )
+{
+  // copy them in a critical section
+  Interrupt_Disable( );
+  memcpy( puBuckets, auHoldBuckets, sizeof( auHoldBuckets ));
+  Interrupt_Enable( );
+}
+
+/******************************************************************************
+ * @function Interrupt_GetHoldSite
+ *
+ * @brief get the statistics for a caller
+ *
+ * This function copies the statistics of an entry in the caller table
+ *
+ * @param[in]   nIndex    index of the entry
+ * @param[io]   ptSite    pointer to the storage for the entry
+ *
+ * @return      TRUE if the entry is in use, FALSE if not
+ *
+ *****************************************************************************/
+BOOL Interrupt_GetHoldSite( U8 nIndex, PINTERRUPTHOLDSITE ptSite )
+{
+  BOOL bStatus = FALSE;
+  
+  // check for a valid index
+  if ( nIndex < INTERRUPT_HOLDSTATS_NUM_SITES )
+  {
+    // copy it in a critical section
+    Interrupt_Disable( );
+    memcpy( ptSite, &atHoldSites[ nIndex ], INTERRUPTHOLDSITE_SIZE );
+    Interrupt_Enable( );
+    
+    // set the status
+    bStatus = ( ptSite->pvCaller != NULL ) ? TRUE : FALSE;
+  }
+  
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function Interrupt_PrintHoldStats
+ *
+ * @brief print the hold statistics
+ *
+ * This function prints the histogram and the caller table
+ *
+ *****************************************************************************/
+void Interrupt_PrintHoldStats( void )
+{
+  U32               auBuckets[ INTERRUPT_HOLDSTATS_NUM_BUCKETS ];
+  INTERRUPTHOLDSITE tSite;
+  U8                nIdx;
+  
+  // print the histogram
+  Interrupt_GetHoldHistogram( auBuckets );
+  PRINTF_P( "critical section hold times\n" );
+  for ( nIdx = 0; nIdx < INTERRUPT_HOLDSTATS_NUM_BUCKETS; nIdx++ )
+  {
+    PRINTF_P( "  < %8lu usec : %lu\n", ( unsigned long )( 1ul << nIdx ), ( unsigned long )auBuckets[ nIdx ] );
+  }
+  
+  // print the callers
+  PRINTF_P( "critical section callers\n" );
+  for ( nIdx = 0; nIdx < INTERRUPT_HOLDSTATS_NUM_SITES; nIdx++ )
+  {
+    if ( Interrupt_GetHoldSite( nIdx, &tSite ))
+    {
+      PRINTF_P( "  %p : count %lu, max %lu nsec, avg %lu nsec\n", tSite.pvCaller, ( unsigned long )tSite.uCount, ( unsigned long )tSite.uMaxNsec, ( unsigned long )( tSite.hTotalNsec / tSite.uCount ));
+    }
+  }
+}
+#endif // INTERRUPT_ENABLE_HOLDSTATS
 
+#if ( INTERRUPT_ENABLE_THREADLOCK == 1 )
+/******************************************************************************
+ * @function LockAcquire
+ *
+ * @brief acquire the thread lock
+ *
+ * This function will spin a limited number of times trying to take the lock,
+ * yielding the processor to the holder between tries, and then wait in the
+ * kernel, marking the lock as contended
+ *
+ *****************************************************************************/
+static void LockAcquire( void )
+{
+  U32   uExpected;
+  U32   uSpin;
+  BOOL  bLocked = FALSE;
+  
+  // spin first, contention is expected to be short
+  for ( uSpin = 0; ( uSpin < INTERRUPT_LOCK_SPIN_COUNT ) && ( bLocked == FALSE ); uSpin++ )
+  {
+    uExpected = LOCK_STATE_FREE;
+    if ( __atomic_compare_exchange_n( &uLockWord, &uExpected, LOCK_STATE_LOCKED, FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ))
+    {
+      // got it
+      bLocked = TRUE;
+    }
+    else
+    {
+      // let the holder run
+      sched_yield( );
+    }
+  }
+  
+  // if not taken, mark it contended and wait till free
+  if ( bLocked == FALSE )
+  {
+    while ( __atomic_exchange_n( &uLockWord, LOCK_STATE_CONTENDED, __ATOMIC_ACQUIRE ) != LOCK_STATE_FREE )
+    {
+      syscall( SYS_futex, &uLockWord, FUTEX_WAIT_PRIVATE, LOCK_STATE_CONTENDED, NULL, NULL, 0 );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function LockRelease
+ *
+ * @brief release the thread lock
+ *
+ * This function will free the lock, waking a waiter if it was contended
+ *
+ *****************************************************************************/
+static void LockRelease( void )
+{
+  // free it, wake a waiter if contended
+  if ( __atomic_exchange_n( &uLockWord, LOCK_STATE_FREE, __ATOMIC_RELEASE ) == LOCK_STATE_CONTENDED )
+  {
+    syscall( SYS_futex, &uLockWord, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
+  }
+}
+#endif // INTERRUPT_ENABLE_THREADLOCK
 
+#if ( INTERRUPT_ENABLE_HOLDSTATS == 1 )
+/******************************************************************************
+ * @function GetMonotonicNsec
+ *
+ * @brief get the monotonic time
+ *
+ * This function returns the monotonic clock in nanoseconds
+ * 
+ * @return  the monotonic time in nanoseconds
+ *
+ *****************************************************************************/
+static U64 GetMonotonicNsec( void )
+{
+  struct timespec tTime;
+  
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  
+  // return it in nanoseconds
+  return(( U64 )tTime.tv_sec * NSECS_PER_SEC + tTime.tv_nsec );
+}
 
+/******************************************************************************
+ * @function RecordHoldTime
+ *
+ * @brief record a hold time
+ *
+ * This function adds the hold time to the histogram and to the caller's
+ * entry, creating it if there is room.  Must be called with the lock held
+ *
+ * @param[in]   pvCaller    address of the caller
+ * @param[in]   hHoldNsec   hold time in nanoseconds
+ *
+ *****************************************************************************/
+static void RecordHoldTime( PVOID pvCaller, U64 hHoldNsec )
+{
+  U64 hUsecs;
+  U8  nBucket, nIdx;
+  
+  // compute the bucket
+  hUsecs = hHoldNsec / NSECS_PER_USEC;
+  for ( nBucket = 0; ( hUsecs != 0 ) && ( nBucket < ( INTERRUPT_HOLDSTATS_NUM_BUCKETS - 1 )); nBucket++ )
+  {
+    hUsecs >>= 1;
+  }
+  auHoldBuckets[ nBucket ]++;
+  
+  // find the caller or an empty entry
+  for ( nIdx = 0; nIdx < INTERRUPT_HOLDSTATS_NUM_SITES; nIdx++ )
+  {
+    if (( atHoldSites[ nIdx ].pvCaller == pvCaller ) || ( atHoldSites[ nIdx ].pvCaller == NULL ))
+    {
+      // update it
+      atHoldSites[ nIdx ].pvCaller = pvCaller;
+      atHoldSites[ nIdx ].uCount++;
+      atHoldSites[ nIdx ].hTotalNsec += hHoldNsec;
+      atHoldSites[ nIdx ].uMaxNsec = MAX( atHoldSites[ nIdx ].uMaxNsec, ( U32 )MIN( hHoldNsec, 0xFFFFFFFFull ));
+      break;
+    }
+  }
+}
+#endif // INTERRUPT_ENABLE_HOLDSTATS
 
+/**@} EOF Interrupt.c */
@@ -25,15 +25,37 @@
 #ifndef _INTERRUPT_H
 #define _INTERRUPT_H
 
+// local includes -------------------------------------------------------------
+#include "Interrupt/Interrupt_prm.h"
+
 // library includes -----------------------------------------------------------
 #include "Types/Types.h"
 
 // enumerations ---------------------------------------------------------------
 
+// structures -----------------------------------------------------------------
+#if ( INTERRUPT_ENABLE_HOLDSTATS == 1 )
+/// define the critical section caller statistics
+typedef struct _INTERRUPTHOLDSITE
+{
+  PVOID   pvCaller;       ///< address of the caller of the outermost disable
+  U32     uCount;         ///< number of times held
+  U32     uMaxNsec;       ///< maximum hold time in nanoseconds
+  U64     hTotalNsec;     ///< total hold time in nanoseconds
+} INTERRUPTHOLDSITE, *PINTERRUPTHOLDSITE;
+#define INTERRUPTHOLDSITE_SIZE    sizeof( INTERRUPTHOLDSITE )
+#endif // INTERRUPT_ENABLE_HOLDSTATS
+
 // global function prototypes --------------------------------------------------
 extern  void   Interrupt_Initialize( void );
 extern  void   Interrupt_Disable( void );
 extern  BOOL   Interrupt_Enable( void );
+#if ( INTERRUPT_ENABLE_HOLDSTATS == 1 )
+extern  void   Interrupt_ResetHoldStats( void );
+extern  void   Interrupt_GetHoldHistogram( PU32 puBuckets );
+extern  BOOL   Interrupt_GetHoldSite( U8 nIndex, PINTERRUPTHOLDSITE ptSite );
+extern  void   Interrupt_PrintHoldStats( void );
+#endif // INTERRUPT_ENABLE_HOLDSTATS
 
 /**@} EOF Interrupt.h */
 
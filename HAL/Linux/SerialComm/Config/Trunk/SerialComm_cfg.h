@@ -33,6 +33,12 @@
 // library includes -----------------------------------------------------------
 
 // Macros and Defines ---------------------------------------------------------
+/// define the macro to enable the epoll event loop backend - set to 1 to enable
+/// SerialComm_ProcessEvents must be called from the idle loop in this mode
+#define SERIALCOMM_ENABLE_EPOLL         ( 0 )
+
+/// define the maximum number of events processed per call in the epoll backend
+#define SERIALCOMM_EPOLL_MAX_EVENTS     ( 16 )
 
 // enumerations ---------------------------------------------------------------
 /// declare the SERIALCOMM enuemrations
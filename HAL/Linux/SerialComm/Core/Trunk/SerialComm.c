@@ -22,13 +22,23 @@
  *****************************************************************************/
 
 // system includes ------------------------------------------------------------
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 #include <pthread.h>
+#include <signal.h>
 #include <termios.h>
+#include <sys/uio.h>
 
 // local includes -------------------------------------------------------------
 #include "SerialComm/SerialComm.h"
 
+#if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+#include <sys/epoll.h>
+#endif // SERIALCOMM_ENABLE_EPOLL
+
 // library includes -----------------------------------------------------------
+#include "Interrupt/Interrupt.h"
 
 // Macros and Defines ---------------------------------------------------------
 /// define the local buffer size
@@ -48,7 +58,10 @@ typedef struct _LCLCTL
   U16                     wBufSize;         ///< buffer size
   int                     iFileDescriptor;  ///< handle
   PVSERIALCOMMIRQCALLBACK pvCallback;       ///< event callback handler
-  
+  PVSERIALCOMMBLKCALLBACK pvBlkCallback;    ///< block callback handler
+  #if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+  BOOL                    bRcvPaused;       ///< receive interest removed while the buffer is full
+  #endif // SERIALCOMM_ENABLE_EPOLL
 } LCLCTL, *PLCLCTL;
 #define LCLCTL_SIZE           sizeof( LCLCTL )
 
@@ -56,12 +69,22 @@ typedef struct _LCLCTL
 
 // local parameter declarations -----------------------------------------------
 static  LCLCTL            atLclCtls[ SERIALCOMM_DEV_ENUM_MAX ];
+#if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+static  int               iEpollFd;
+#else
 static  int               iLclSignal;
 static  struct sigaction  tCurSigAction;
 static  struct sigaction  tPrvSigAction;
+#endif // SERIALCOMM_ENABLE_EPOLL
 
 // local function prototypes --------------------------------------------------
+static  void ReadDevice( PLCLCTL ptCtl );
+#if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+static  void SetRcvInterest( PLCLCTL ptCtl, BOOL bEnable );
+#endif // SERIALCOMM_ENABLE_EPOLL
+#if ( SERIALCOMM_ENABLE_EPOLL == 0 )
 static  void ReadHandler( int iSigNumber, siginfo_t *ptInfo, PVOID pvIgnored );
+#endif // SERIALCOMM_ENABLE_EPOLL
 
 // constant parameter initializations -----------------------------------------
 static const U32  auBaudConstants[ SERIALCOMM_BAUDRATE_MAX ] =
@@ -77,7 +100,10 @@ static const U32  auBaudConstants[ SERIALCOMM_BAUDRATE_MAX ] =
   B38400,
   B57600,
   B115200,
-  B230400
+  B230400,
+  B460800,
+  B921600,
+  B1000000
 };
 
 static const U32  auCharSize[ SERIALCOMM_WLEN_MAX ] =
@@ -103,16 +129,21 @@ void SerialComm_Initialize( void )
   PSERIALCOMMDEF    ptDef;
   PLCLCTL           ptCtl;
   struct termios    tOptions;
-  int               iCurSignal;
   BOOL              bFound;
+  #if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+  struct epoll_event  tEvent;
+  
+  // create the event loop
+  bFound = (( iEpollFd = epoll_create1( EPOLL_CLOEXEC )) >= 0 ) ? TRUE : FALSE;
+  #else
+  int               iCurSignal;
   
   // first see if we can get a signal
   iLclSignal = 0;
   bFound = FALSE;
     
   // loop through all available signals
-  for ( iCurSignal = SIGRTMIN; iCurSignal <= SIGRTMAX, bFound == FALSE; iCurSignal++ )
-  do
+  for ( iCurSignal = SIGRTMIN; ( iCurSignal <= SIGRTMAX ) && ( bFound == FALSE ); iCurSignal++ )
   {
     // get previous sig action
     sigaction( iCurSignal, 0, &tPrvSigAction );
@@ -136,7 +167,8 @@ void SerialComm_Initialize( void )
       // not empty - restore original
       sigaction( iLclSignal, &tPrvSigAction, 0 );
     }
-  };
+  }
+  #endif // SERIALCOMM_ENABLE_EPOLL
   
   // if found - process rest
   if ( bFound )
@@ -157,10 +189,18 @@ void SerialComm_Initialize( void )
       // open the port
       if (( ptCtl->iFileDescriptor = open( ptDef->pszChanName, O_RDWR | O_NOCTTY | O_NONBLOCK )) != -1 )
       {
+        #if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+        // add it to the event loop, storing the device to avoid a search
+        memset( &tEvent, 0, sizeof( tEvent ));
+        tEvent.events = EPOLLIN;
+        tEvent.data.u32 = eSerialComm;
+        epoll_ctl( iEpollFd, EPOLL_CTL_ADD, ptCtl->iFileDescriptor, &tEvent );
+        #else
         // set up for event driven
         fcntl( ptCtl->iFileDescriptor, F_SETSIG, iLclSignal );
         fcntl( ptCtl->iFileDescriptor, F_SETOWN, getpid( ));
-        fcntl( ptCtl->iFileDescriptor, F_SETFL, O_ASYNC | ) | NONBLOCK );
+        fcntl( ptCtl->iFileDescriptor, F_SETFL, fcntl( ptCtl->iFileDescriptor, F_GETFL ) | O_ASYNC | O_NONBLOCK );
+        #endif // SERIALCOMM_ENABLE_EPOLL
         
         // get the default options
         tcgetattr( ptCtl->iFileDescriptor, &tOptions );
@@ -196,7 +236,15 @@ void SerialComm_Initialize( void )
         tcsetattr( ptCtl->iFileDescriptor, TCSANOW, &tOptions );
         
         // now check for callback or local buffer
-        if ( ptDef->pvCallback != NULL )
+        if ( ptDef->pvBlkCallback != NULL )
+        {
+          // store the block callback in the control
+          ptCtl->pvBlkCallback = ptDef->pvBlkCallback;
+          
+          // set the ok status
+          ptCtl->bChannelOk = TRUE;
+        }
+        else if ( ptDef->pvCallback != NULL )
         {
           // store the callback in the control
           ptCtl->pvCallback = ptDef->pvCallback;
@@ -246,8 +294,18 @@ SERIALCOMMERR SerialComm_Close( SERIALCOMMDEVENUM eDev )
     // get a pointer
     ptCtl = &atLclCtls[ eDev ];
     
+    #if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+    // remove it from the event loop
+    epoll_ctl( iEpollFd, EPOLL_CTL_DEL, ptCtl->iFileDescriptor, NULL );
+    #endif // SERIALCOMM_ENABLE_EPOLL
+    
     // close the comm port
-    close( ptCtl->iFileDescriptor );
+    if ( close( ptCtl->iFileDescriptor ) == 0 )
+    {
+      // set good status
+      eStatus = SERIALCOMM_ERR_NONE;
+    }
+    ptCtl->bChannelOk = FALSE;
   }
   else
   {
@@ -307,10 +365,26 @@ SERIALCOMMERR SerialComm_Read( SERIALCOMMDEVENUM eDev, PU8 pnData, U16 wLength,
           // roll-over back to 0
           ptCtl->wRcvRdIndex = 0;
         }
-        
-        // adjust the count
-        ptCtl->wBufCount--;
       }
+      
+      // adjust the count with the read handler locked out
+      Interrupt_Disable( );
+      ptCtl->wBufCount -= *( pwBytesRead );
+      
+      #if ( SERIALCOMM_ENABLE_EPOLL == 0 )
+      // the signal is not raised again for data left in the driver while the
+      // buffer was full, so drain it into the freed space
+      ReadDevice( ptCtl );
+      #endif // SERIALCOMM_ENABLE_EPOLL
+      Interrupt_Enable( );
+      
+      #if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+      // if the receive interest was removed, there is now room so re-arm it
+      if ( ptCtl->bRcvPaused )
+      {
+        SetRcvInterest( ptCtl, TRUE );
+      }
+      #endif // SERIALCOMM_ENABLE_EPOLL
     }
   }
   else
@@ -395,30 +469,74 @@ SERIALCOMMERR SerialComm_Ioctl( SERIALCOMMDEVENUM eDev, SERIALCOMMACTION eAction
   return( eError );
 }
 
+#if ( SERIALCOMM_ENABLE_EPOLL == 1 )
 /******************************************************************************
- * @function ReadThread 
+ * @function SerialComm_ProcessEvents
  *
- * @brief background read thread
+ * @brief process the event loop
  *
- * This function sits in a loop and attempts to read characters from the serial
- * port, decodes them and will set the receive message semaphore if a valid
- * message is received
+ * This function will poll the event loop without blocking and read all
+ * devices that have data ready
  *
- * @param[in]   pvArg     pointer to an argument
+ *****************************************************************************/
+void SerialComm_ProcessEvents( void )
+{
+  struct epoll_event  atEvents[ SERIALCOMM_EPOLL_MAX_EVENTS ];
+  int                 iNumEvents, iIdx;
+  SERIALCOMMDEVENUM   eDev;
+  
+  // get the ready devices
+  if (( iNumEvents = epoll_wait( iEpollFd, atEvents, SERIALCOMM_EPOLL_MAX_EVENTS, 0 )) > 0 )
+  {
+    // for each event
+    for ( iIdx = 0; iIdx < iNumEvents; iIdx++ )
+    {
+      // get the device/read it
+      eDev = ( SERIALCOMMDEVENUM )atEvents[ iIdx ].data.u32;
+      if (( eDev < SERIALCOMM_DEV_ENUM_MAX ) && ( atEvents[ iIdx ].events & EPOLLIN ))
+      {
+        ReadDevice( &atLclCtls[ eDev ] );
+      }
+    }
+  }
+}
+
+/******************************************************************************
+ * @function SerialComm_GetPollDescriptor
+ *
+ * @brief get the poll descriptor
+ *
+ * This function returns the event loop descriptor, which becomes readable
+ * when any device has data, so the idle loop can block on it
+ *
+ * @return      the event loop descriptor
+ *
+ *****************************************************************************/
+int SerialComm_GetPollDescriptor( void )
+{
+  // return the descriptor
+  return( iEpollFd );
+}
+#else
+/******************************************************************************
+ * @function ReadHandler
  *
- * @return      pointer to a void
+ * @brief signal read handler
+ *
+ * This function finds the device that raised the signal and reads it
+ *
+ * @param[in]   iSigNumber  signal number
+ * @param[in]   ptInfo      pointer to the signal information
+ * @param[in]   pvIgnored   not used
  *
  *****************************************************************************/
 static  void ReadHandler( int iSigNumber, siginfo_t *ptInfo, PVOID pvIgnored )
 {
-  U8                anLclBuffer[ LCL_BUF_SIZE ];
-  U8                nBufIndex;
-  int               iBytesRead;
   PLCLCTL           ptCtl;
   SERIALCOMMDEVENUM eDev;
   
   // is this an incoming signal
-  if ( ptInfo->si_code = POLL_IN )
+  if ( ptInfo->si_code == POLL_IN )
   {
     // there is some data - find the device
     for ( eDev = 0; eDev < SERIALCOMM_DEV_ENUM_MAX; eDev++ )
@@ -429,30 +547,8 @@ static  void ReadHandler( int iSigNumber, siginfo_t *ptInfo, PVOID pvIgnored )
       // this is our device
       if ( ptCtl->iFileDescriptor == ptInfo->si_fd )
       {
-        // read characters
-        if (( iBytesRead = read( ptCtl->iFileDescriptor, ( PVOID )anLclBuffer, LCL_BUF_SIZE )) > 0 )
-        {
-          // now for each byte process
-          for( nBufIndex = 0; nBufIndex < iBytesRead; nBufIndex++ )
-          {
-            // check for callback or local buffer
-            if ( ptCtl->pvCallback != NULL )
-            {
-              // process it
-              ptCtl->pvCallback( anLclBuffer[ nBufIndex ] );
-            }
-            else
-            {
-              // add to queue if room
-              if ( ptCtl->wBufCount < ptCtl->wBufSize )
-              {
-                // stuff it/increment pointer/count
-                ptCtl->pnRcvBuffer[ ptCtl->wRcvWrIndex++ ] = anLclBuffer[ nBufIndex ];
-                ptCtl->wBufCount++;
-              }
-            }
-          }
-        }
+        // read it
+        ReadDevice( ptCtl );
         
         // break out of loop
         break;
@@ -460,6 +556,123 @@ static  void ReadHandler( int iSigNumber, siginfo_t *ptInfo, PVOID pvIgnored )
     }
   }
 }
+#endif // SERIALCOMM_ENABLE_EPOLL
 
-/**@} EOF SerialComm.c */
+/******************************************************************************
+ * @function ReadDevice
+ *
+ * @brief read a device
+ *
+ * This function reads all available data from a device.  Buffered devices
+ * read directly into the free space of the receive buffer, leaving any 
+ * excess in the driver until SerialComm_Read makes room.  Callback devices read a local
+ * buffer at a time and pass it as a block or byte at a time
+ *
+ * @param[in]   ptCtl     pointer to the control structure
+ *
+ *****************************************************************************/
+static void ReadDevice( PLCLCTL ptCtl )
+{
+  U8            anLclBuffer[ LCL_BUF_SIZE ];
+  struct iovec  atVecs[ 2 ];
+  int           iNumVecs, iBytesRead, iIdx;
+  U16           wFree, wFirst;
+  
+  // check for callback or local buffer
+  if (( ptCtl->pvCallback != NULL ) || ( ptCtl->pvBlkCallback != NULL ))
+  {
+    // read till empty
+    while (( iBytesRead = read( ptCtl->iFileDescriptor, ( PVOID )anLclBuffer, LCL_BUF_SIZE )) > 0 )
+    {
+      // check for block callback
+      if ( ptCtl->pvBlkCallback != NULL )
+      {
+        // pass the whole block
+        ptCtl->pvBlkCallback( anLclBuffer, ( U16 )iBytesRead );
+      }
+      else
+      {
+        // now for each byte process
+        for ( iIdx = 0; iIdx < iBytesRead; iIdx++ )
+        {
+          ptCtl->pvCallback( anLclBuffer[ iIdx ] );
+        }
+      }
+      
+      // exit if drained
+      if ( iBytesRead < LCL_BUF_SIZE )
+      {
+        break;
+      }
+    }
+  }
+  else if ( ptCtl->pnRcvBuffer != NULL )
+  {
+    // read while there is room
+    while (( wFree = ptCtl->wBufSize - ptCtl->wBufCount ) != 0 )
+    {
+      // compute the free space up to the end of the buffer, and any wrapped space
+      wFirst = MIN( wFree, ptCtl->wBufSize - ptCtl->wRcvWrIndex );
+      atVecs[ 0 ].iov_base = ptCtl->pnRcvBuffer + ptCtl->wRcvWrIndex;
+      atVecs[ 0 ].iov_len = wFirst;
+      atVecs[ 1 ].iov_base = ptCtl->pnRcvBuffer;
+      atVecs[ 1 ].iov_len = wFree - wFirst;
+      iNumVecs = ( wFree > wFirst ) ? 2 : 1;
+      
+      // read directly into the buffer
+      if (( iBytesRead = readv( ptCtl->iFileDescriptor, atVecs, iNumVecs )) <= 0 )
+      {
+        break;
+      }
+      
+      // adjust the index/count
+      ptCtl->wRcvWrIndex = ( ptCtl->wRcvWrIndex + iBytesRead ) % ptCtl->wBufSize;
+      ptCtl->wBufCount += iBytesRead;
+      
+      // exit if drained
+      if ( iBytesRead < wFree )
+      {
+        break;
+      }
+    }
+    
+    #if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+    // if the buffer is full, stop watching the device until it is read, as 
+    // the excess left in the driver would keep the level triggered event set
+    if ( ptCtl->wBufCount == ptCtl->wBufSize )
+    {
+      SetRcvInterest( ptCtl, FALSE );
+    }
+    #endif // SERIALCOMM_ENABLE_EPOLL
+  }
+}
 
+#if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+/******************************************************************************
+ * @function SetRcvInterest
+ *
+ * @brief set the receive interest
+ *
+ * This function will add or remove the receive interest for a device in the
+ * event loop
+ *
+ * @param[in]   ptCtl     pointer to the control structure
+ * @param[in]   bEnable   TRUE to watch for receive data, FALSE to stop
+ *
+ *****************************************************************************/
+static void SetRcvInterest( PLCLCTL ptCtl, BOOL bEnable )
+{
+  struct epoll_event  tEvent;
+  
+  // modify the event, keeping the device in the data
+  memset( &tEvent, 0, sizeof( tEvent ));
+  tEvent.events = ( bEnable ) ? EPOLLIN : 0;
+  tEvent.data.u32 = ( U32 )( ptCtl - atLclCtls );
+  epoll_ctl( iEpollFd, EPOLL_CTL_MOD, ptCtl->iFileDescriptor, &tEvent );
+  
+  // set the paused flag
+  ptCtl->bRcvPaused = !bEnable;
+}
+#endif // SERIALCOMM_ENABLE_EPOLL
+
+/**@} EOF SerialComm.c */
@@ -71,6 +71,10 @@ extern  SERIALCOMMERR SerialComm_Close( SERIALCOMMDEVENUM eDev );
 extern  SERIALCOMMERR SerialComm_Write( SERIALCOMMDEVENUM eDev, PU8 pnData, U16 wLength, PU16 pwBytesWritten );
 extern  SERIALCOMMERR SerialComm_Read( SERIALCOMMDEVENUM eDev, PU8 pnData, U16 wLength, PU16 pwBytesRead );
 extern  SERIALCOMMERR SerialComm_Ioctl( SERIALCOMMDEVENUM eDev, SERIALCOMMACTION eAction, PVOID pvData );
+#if ( SERIALCOMM_ENABLE_EPOLL == 1 )
+extern  void          SerialComm_ProcessEvents( void );
+extern  int           SerialComm_GetPollDescriptor( void );
+#endif // SERIALCOMM_ENABLE_EPOLL
 
 /**@} EOF SerialComm.h */
 
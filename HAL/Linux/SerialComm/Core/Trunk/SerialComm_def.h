@@ -39,7 +39,21 @@
   .eWordLen = len, \
   .eStopBits = stop, \
   .wRxBufSize = rxbuf, \
-  .pvCallback = ( PVSERIALCOMMIRQCALLBACK )callback \
+  .pvCallback = ( PVSERIALCOMMIRQCALLBACK )callback, \
+  .pvBlkCallback = NULL \
+ }
+
+/// define the helper macro to create a ASYNC SERIALCOMM with a block callback
+#define SERIALCOMM_DEFBLK( chan, baud, parity, len, stop, blkcallback ) \
+ { \
+  .pszChanName = chan, \
+  .eBaudRate = baud, \
+  .eParity = parity, \
+  .eWordLen = len, \
+  .eStopBits = stop, \
+  .wRxBufSize = 0, \
+  .pvCallback = NULL, \
+  .pvBlkCallback = ( PVSERIALCOMMBLKCALLBACK )blkcallback \
  }
  
 // enumerations ---------------------------------------------------------------
@@ -58,6 +72,9 @@ typedef enum _SERIALCOMMBAUDRATE
   SERIALCOMM_BAUDRATE_57600,
   SERIALCOMM_BAUDRATE_115200,
   SERIALCOMM_BAUDRATE_230400,
+  SERIALCOMM_BAUDRATE_460800,
+  SERIALCOMM_BAUDRATE_921600,
+  SERIALCOMM_BAUDRATE_1000000,
   SERIALCOMM_BAUDRATE_MAX
 } SERIALCOMMBAUDRATE;
 
@@ -92,6 +109,9 @@ typedef enum _SERIALCOMMPARITY
 /// define the callback function
 typedef void ( *PVSERIALCOMMIRQCALLBACK )( U8 );
 
+/// define the block callback function
+typedef void ( *PVSERIALCOMMBLKCALLBACK )( PU8, U16 );
+
 /// define the SERIALCOMM control structure
 typedef struct _SERIALCOMMDEF
 {
@@ -102,6 +122,7 @@ typedef struct _SERIALCOMMDEF
   SERIALCOMMSTOP          eStopBits;    ///< stop bits
   U16                     wRxBufSize;   ///< receive buffer size
   PVSERIALCOMMIRQCALLBACK pvCallback;   ///< event callback handler
+  PVSERIALCOMMBLKCALLBACK pvBlkCallback;  ///< block callback handler
 } SERIALCOMMDEF, *PSERIALCOMMDEF;
 #define SERIALCOMMDEF_SIZE    sizeof( SERIALCOMMDEF )
 
@@ -40,4 +40,43 @@ const CODE PVSYSTEMTICKFUNC apvSystemTickFunctions[ ] =
   NULL
 };
 
+#if ( SYSTEMTICK_ENABLE_TICKLESS == 1 )
+/******************************************************************************
+ * @function SystemTick_LocalGetNextTimeout
+ *
+ * @brief get the next timeout
+ *
+ * This function returns the number of ticks until the next scheduled timer
+ *
+ * @return      number of ticks, SYSTEMTICK_NEXTTIMEOUT_NONE if none
+ *
+ *****************************************************************************/
+U32 SystemTick_LocalGetNextTimeout( void )
+{
+  U32 uTicks;
+  
+  // get the next timeout from the task manager
+  uTicks = TaskManager_GetNextTimeout( );
+  
+  // return the ticks
+  return(( uTicks == TASK_NEXTTIMEOUT_NONE ) ? SYSTEMTICK_NEXTTIMEOUT_NONE : uTicks );
+}
+
+/******************************************************************************
+ * @function SystemTick_LocalCheckTasksPending
+ *
+ * @brief check for tasks pending
+ *
+ * This function returns TRUE if any task has an event pending
+ *
+ * @return      TRUE if tasks pending
+ *
+ *****************************************************************************/
+BOOL SystemTick_LocalCheckTasksPending( void )
+{
+  // return the task manager state
+  return( TaskManager_CheckTasksPending( TASK_SCHD_ILLEGAL ));
+}
+#endif // SYSTEMTICK_ENABLE_TICKLESS
+
 /**@} EOF SystemTick_cfg.c */
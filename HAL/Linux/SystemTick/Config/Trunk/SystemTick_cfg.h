@@ -29,15 +29,25 @@
 
 // library includes -----------------------------------------------------------
 #include "Types/Types.h"
+#include "SystemTick/SystemTick_prm.h"
 
 // Macros and Defines ---------------------------------------------------------
 /// define the system tick functions
 typedef void ( *PVSYSTEMTICKFUNC )( void );
 
+/// define the value returned when no timeout is pending
+#define SYSTEMTICK_NEXTTIMEOUT_NONE   ( 0xFFFFFFFF )
+
 // global parameter declarations -----------------------------------------------
 /// declare the system tick structure
 extern  const CODE PVSYSTEMTICKFUNC apvSystemTickFunctions[ ];
 
+// global function prototypes --------------------------------------------------
+#if ( SYSTEMTICK_ENABLE_TICKLESS == 1 )
+extern  U32   SystemTick_LocalGetNextTimeout( void );
+extern  BOOL  SystemTick_LocalCheckTasksPending( void );
+#endif // SYSTEMTICK_ENABLE_TICKLESS
+
 /**@} EOF Micro_cfg.c */
 
 #endif // _MICRO_CFG_H
@@ -29,6 +29,11 @@
 /// define the system tick rate in HZ
 #define SYSTEMTICK_RATE_HZ	1000
 
+/// define the macro to enable tickless idle - set to 1 to enable
+/// SystemTick_IdleProcess must be added to the idle functions and 
+/// SystemTick_Sleep called from the sleep mode function
+#define SYSTEMTICK_ENABLE_TICKLESS  ( 0 )
+
 /**@} EOF SystemTick_prm.h */
 
 #endif  // _SYSTEMTICK_PRM_H
@@ -22,10 +22,16 @@
  *****************************************************************************/
 
 // system includes
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
 #include <signal.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/time.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/timerfd.h>
 
 // library includes
 #include "Types/Types.h"
@@ -35,14 +41,28 @@
 #include "SystemTick/SystemTick.h"
 #include "SystemTick/SystemTick_cfg.h"
 
+// Macros and Defines ---------------------------------------------------------
+/// define the nanoseconds per second/microsecond
+#define NSECS_PER_SEC             ( 1000000000ull )
+#define NSECS_PER_USEC            ( 1000ull )
+
 // local parameter declarations -----------------------------------------------
 static  U64               hSystemTime;
 static  U32               uTickRateUsec;
 static  U32               uDelayTime;
+#if ( SYSTEMTICK_ENABLE_TICKLESS == 1 )
+static  int               iTimerFd;
+static  U64               hLastTickNsec;
+#else
 static  struct sigaction  tOldAction;
+#endif // SYSTEMTICK_ENABLE_TICKLESS
 
 // local function prototypes
 static void SysTickHandler( int iSigNum );
+#if ( SYSTEMTICK_ENABLE_TICKLESS == 1 )
+static void ProcessElapsedTicks( void );
+static U64  GetMonotonicNsec( void );
+#endif // SYSTEMTICK_ENABLE_TICKLESS
 
 /******************************************************************************
  * @function SystemTick_Initialize
@@ -54,8 +74,10 @@ static void SysTickHandler( int iSigNum );
  *****************************************************************************/
 void SystemTick_Initialize( void )
 {
+  #if ( SYSTEMTICK_ENABLE_TICKLESS == 0 )
   struct sigaction tSigAction;
   struct itimerval tTimer;
+  #endif // SYSTEMTICK_ENABLE_TICKLESS
 
   // clear the system time
   hSystemTime = 0;
@@ -63,6 +85,17 @@ void SystemTick_Initialize( void )
   // compute the tick rate in microseconds
   uTickRateUsec = ( 1000000ul / SYSTEMTICK_RATE_HZ );
   
+  #if ( SYSTEMTICK_ENABLE_TICKLESS == 1 )
+  // create the one shot timer
+  if (( iTimerFd = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC )) < 0 )
+  {
+    // error
+    puts( "timerfd_create error\n" );
+  }
+  
+  // set the time of the last tick
+  hLastTickNsec = GetMonotonicNsec( );
+  #else
   // Configure the timer to expire after desired rate
   tTimer.it_value.tv_sec = 0;
   tTimer.it_value.tv_usec = uTickRateUsec;
@@ -86,6 +119,7 @@ void SystemTick_Initialize( void )
     // error
     puts( "setitime error\n" );
   }
+  #endif // SYSTEMTICK_ENABLE_TICKLESS
 }
 
 /******************************************************************************
@@ -98,6 +132,14 @@ void SystemTick_Initialize( void )
  *****************************************************************************/
 void SystemTick_Close( void )
 {
+  #if ( SYSTEMTICK_ENABLE_TICKLESS == 1 )
+  // close the timer
+  if ( iTimerFd >= 0 )
+  {
+    close( iTimerFd );
+    iTimerFd = -1;
+  }
+  #else
   struct itimerval tTimer;
 
  // Configure the timer to expire after desired rate
@@ -119,6 +161,7 @@ void SystemTick_Close( void )
      printf("\nsigaction() error\n");
    }
  }
+ #endif // SYSTEMTICK_ENABLE_TICKLESS
 }
 
 /******************************************************************************
@@ -203,6 +246,134 @@ BOOL SystemTick_IsDelayExpired( void )
   return(( uDelayTime == 0 ) ? TRUE : FALSE );
 }
 
+#if ( SYSTEMTICK_ENABLE_TICKLESS == 1 )
+/******************************************************************************
+ * @function SystemTick_IdleProcess
+ *
+ * @brief tickless idle process
+ *
+ * This function will process all ticks that have elapsed since the last call
+ * 
+ *****************************************************************************/
+void SystemTick_IdleProcess( void )
+{
+  // process the ticks
+  ProcessElapsedTicks( );
+}
+
+/******************************************************************************
+ * @function SystemTick_Sleep
+ *
+ * @brief sleep until the next deadline
+ *
+ * This function will block all signals, and if no tasks are pending, program
+ * the one shot timer for the next scheduled timeout and wait for either the
+ * timer or a signal.  The signal mask is restored atomically by ppoll so an
+ * event posted from a signal handler cannot be missed
+ * 
+ *****************************************************************************/
+void SystemTick_Sleep( void )
+{
+  sigset_t          tBlockMask, tOldMask;
+  struct itimerspec tTimerSpec;
+  struct pollfd     tPollFd;
+  U32               uTicks;
+  U64               hDeadline, hExpirations;
+  
+  // block all signals
+  sigfillset( &tBlockMask );
+  sigprocmask( SIG_BLOCK, &tBlockMask, &tOldMask );
+  
+  // process any elapsed ticks
+  ProcessElapsedTicks( );
+  
+  // only sleep if nothing is pending
+  if (( iTimerFd >= 0 ) && ( !SystemTick_LocalCheckTasksPending( )))
+  {
+    // get the next deadline, zero disarms the timer
+    memset( &tTimerSpec, 0, sizeof( tTimerSpec ));
+    if (( uTicks = SystemTick_LocalGetNextTimeout( )) != SYSTEMTICK_NEXTTIMEOUT_NONE )
+    {
+      // compute the absolute time of the deadline
+      hDeadline = hLastTickNsec + (( U64 )uTicks * uTickRateUsec * NSECS_PER_USEC );
+      tTimerSpec.it_value.tv_sec = hDeadline / NSECS_PER_SEC;
+      tTimerSpec.it_value.tv_nsec = hDeadline % NSECS_PER_SEC;
+    }
+    timerfd_settime( iTimerFd, TFD_TIMER_ABSTIME, &tTimerSpec, NULL );
+    
+    // wait for the timer or a signal
+    tPollFd.fd = iTimerFd;
+    tPollFd.events = POLLIN;
+    tPollFd.revents = 0;
+    ppoll( &tPollFd, 1, NULL, &tOldMask );
+    
+    // clear the expirations
+    if ( read( iTimerFd, &hExpirations, sizeof( hExpirations )) < 0 )
+    {
+      // no expirations, woken by a signal
+      hExpirations = 0;
+    }
+  }
+  
+  // restore the signals
+  sigprocmask( SIG_SETMASK, &tOldMask, NULL );
+  
+  // process the ticks
+  ProcessElapsedTicks( );
+}
+
+/******************************************************************************
+ * @function ProcessElapsedTicks
+ *
+ * @brief process the elapsed ticks
+ *
+ * This function will compute the number of whole ticks since the last tick
+ * and call the tick handler for each of them, keeping the tick time aligned
+ * so no drift accumulates
+ * 
+ *****************************************************************************/
+static void ProcessElapsedTicks( void )
+{
+  U64 hTickNsec, hElapsed;
+  U32 uTicks;
+  
+  // compute the number of ticks
+  hTickNsec = ( U64 )uTickRateUsec * NSECS_PER_USEC;
+  hElapsed = GetMonotonicNsec( ) - hLastTickNsec;
+  uTicks = ( U32 )( hElapsed / hTickNsec );
+  hLastTickNsec += ( U64 )uTicks * hTickNsec;
+  
+  // process each tick
+  while ( uTicks-- != 0 )
+  {
+    Interrupt_Disable( );
+    SysTickHandler( SIGALRM );
+    Interrupt_Enable( );
+  }
+}
+
+/******************************************************************************
+ * @function GetMonotonicNsec
+ *
+ * @brief get the monotonic time
+ *
+ * This function returns the monotonic clock in nanoseconds
+ * 
+ * @return  the monotonic time in nanoseconds
+ *
+ *****************************************************************************/
+static U64 GetMonotonicNsec( void )
+{
+  struct timespec tTime;
+  
+  // get the time
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  
+  // return it in nanoseconds
+  return(( U64 )tTime.tv_sec * NSECS_PER_SEC + tTime.tv_nsec );
+}
+#endif // SYSTEMTICK_ENABLE_TICKLESS
+
 /******************************************************************************
  * @function IrqHandler
  *
@@ -37,6 +37,10 @@ extern  U64   SystemTick_GetTimeUsec( void );
 extern  U32   SystemTick_GetTimeMsec( void );
 extern  void  SystemTick_DelayMsec( U16 wMilliSeconds );
 extern  BOOL  SystemTick_IsDelayExpired( void );
+#if ( SYSTEMTICK_ENABLE_TICKLESS == 1 )
+extern  void  SystemTick_IdleProcess( void );
+extern  void  SystemTick_Sleep( void );
+#endif // SYSTEMTICK_ENABLE_TICKLESS
 
 /**@} EOF SystemTick.h */
 
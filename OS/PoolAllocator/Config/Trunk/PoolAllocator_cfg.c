@@ -0,0 +1,50 @@
+/******************************************************************************
+ * @file PoolAllocator_cfg.c
+ *
+ * @brief pool allocator configuration implementation
+ *
+ * This file contains the list of pool configurations
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup PoolAllocator
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "PoolAllocator/PoolAllocator_cfg.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations ----------------------------------------------
+/// allocate the storage for each pool
+// POOLALLOC_BUFFER( name, block_size, num_blocks );
+
+
+/// create entry for each pool, smallest block size first
+const CODE POOLALLOCDEF  g_atPoolAllocDefs[ POOLALLOC_ENUM_MAX ] =
+{
+  // POOLALLOC_ENTRY( name, block_size, num_blocks ),
+};
+
+
+
+/**@} EOF PoolAllocator_cfg.c */
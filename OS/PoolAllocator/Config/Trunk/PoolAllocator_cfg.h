@@ -0,0 +1,58 @@
+/******************************************************************************
+ * @file PoolAllocator_cfg.h
+ *
+ * @brief pool allocator configuration declarations
+ *
+ * This file provides the pool enumerations.  Pools must be listed in order of
+ * increasing block size
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup PoolAllocator
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instatiation
+#ifndef _POOLALLOCATOR_CFG_H
+#define _POOLALLOCATOR_CFG_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "PoolAllocator/PoolAllocator_def.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+/// enumerate each pool, smallest block size first
+typedef enum _POOLALLOCENUM
+{
+  // add user defined pools here
+  
+  // do not remove the below entries
+  POOLALLOC_ENUM_MAX,
+  POOLALLOC_ENUM_ILLEGAL = 0xFF
+} POOLALLOCENUM;
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations -----------------------------------------------
+extern  const CODE POOLALLOCDEF  g_atPoolAllocDefs[ ];
+
+// global function prototypes --------------------------------------------------
+
+/**@} EOF PoolAllocator_cfg.h */
+
+#endif  // _POOLALLOCATOR_CFG_H
@@ -0,0 +1,297 @@
+/******************************************************************************
+ * @file  PoolAllocator.c 
+ *
+ * @brief pool allocator implementation
+ *
+ * This file provides the implementation of a fixed block pool allocator.  Each
+ * pool is a static array of equal sized blocks linked on a free list, so an
+ * allocation or free is a bounded walk of the pool list and never fragments
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup PoolAllocator
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+#include <string.h>
+
+// local includes -------------------------------------------------------------
+#include "PoolAllocator/PoolAllocator.h"
+
+// library includes -----------------------------------------------------------
+#include "Interrupt/Interrupt.h"
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// define the pool control structure
+typedef struct _POOLALLOCCTL
+{
+  PVOID   pvFreeList;       ///< pointer to the first free block
+  U16     wNumUsed;         ///< number of blocks in use
+  U16     wHighWater;       ///< maximum number of blocks ever in use
+  U16     wNumFailed;       ///< number of failed allocations
+} POOLALLOCCTL, *PPOOLALLOCCTL;
+#define POOLALLOCCTL_SIZE sizeof( POOLALLOCCTL )
+
+// local parameter declarations -----------------------------------------------
+static  POOLALLOCCTL  atPoolCtls[ POOLALLOC_ENUM_MAX ];
+
+// local function prototypes --------------------------------------------------
+
+// constant parameter initializations -----------------------------------------
+
+/******************************************************************************
+ * @function PoolAllocator_Initialize
+ *
+ * @brief pool initialization
+ *
+ * This function will link every block of each pool onto its free list and
+ * clear the statistics
+ *
+ *****************************************************************************/
+void PoolAllocator_Initialize( void )
+{
+  POOLALLOCENUM ePool;
+  PPOOLALLOCCTL ptCtl;
+  PPOOLALLOCDEF ptDef;
+  U16           wBlockSize, wNumBlocks, wBlock;
+  PU8           pnBlock, pnInUse;
+  
+  // for each pool in the list
+  for ( ePool = 0; ePool < POOLALLOC_ENUM_MAX; ePool++ )
+  {
+    // get a pointer to the control/definition structures
+    ptCtl = &atPoolCtls[ ePool ];
+    ptDef = ( PPOOLALLOCDEF )&g_atPoolAllocDefs[ ePool ];
+    
+    // get the block size/number of blocks/storage
+    wBlockSize = PGM_RDWORD( ptDef->wBlockSize );
+    wNumBlocks = PGM_RDWORD( ptDef->wNumBlocks );
+    pnBlock = ( PU8 )PGM_RDWORD( ptDef->pnPool );
+    pnInUse = ( PU8 )PGM_RDWORD( ptDef->pnInUse );
+    
+    // mark every block as free
+    memset( pnInUse, 0, POOLALLOC_INUSE_BYTES( wNumBlocks ));
+    
+    // link the blocks in address order
+    ptCtl->pvFreeList = ( wNumBlocks != 0 ) ? ( PVOID )pnBlock : NULL;
+    for ( wBlock = 1; wBlock <= wNumBlocks; wBlock++, pnBlock += wBlockSize )
+    {
+      *(( PVOID* )pnBlock ) = ( wBlock < wNumBlocks ) ? ( PVOID )( pnBlock + wBlockSize ) : NULL;
+    }
+    
+    // clear the statistics
+    ptCtl->wNumUsed = 0;
+    ptCtl->wHighWater = 0;
+    ptCtl->wNumFailed = 0;
+  }
+}
+
+/******************************************************************************
+ * @function PoolAllocator_Alloc
+ *
+ * @brief allocate a block
+ *
+ * This function will return a block from the smallest pool whose blocks can
+ * hold the requested size, moving up to the larger pools if that one is empty.
+ * A failure is charged to the smallest pool that would have fit, or to the
+ * largest pool if the request is too big for any of them
+ *
+ * @param[in]   uSize     the number of bytes required
+ *
+ * @return      pointer to the block or NULL if none available or none large
+ *              enough
+ *
+ *****************************************************************************/
+PVOID PoolAllocator_Alloc( U32 uSize )
+{
+  POOLALLOCENUM ePool;
+  POOLALLOCENUM eFitPool = POOLALLOC_ENUM_ILLEGAL;
+  PPOOLALLOCCTL ptCtl;
+  PPOOLALLOCDEF ptDef;
+  PVOID         pvBlock = NULL;
+  U16           wBlock;
+  
+  // disable interrupts
+  Interrupt_Disable( );
+  
+  // search for the first pool that fits and has a free block
+  for ( ePool = 0; ( ePool < POOLALLOC_ENUM_MAX ) && ( pvBlock == NULL ); ePool++ )
+  {
+    // does this pool fit
+    if (( U32 )PGM_RDWORD( g_atPoolAllocDefs[ ePool ].wBlockSize ) >= uSize )
+    {
+      // remember the best fit
+      if ( eFitPool == POOLALLOC_ENUM_ILLEGAL )
+      {
+        eFitPool = ePool;
+      }
+      
+      // get a pointer to the control
+      ptCtl = &atPoolCtls[ ePool ];
+      
+      // is there a free block
+      if (( pvBlock = ptCtl->pvFreeList ) != NULL )
+      {
+        // unlink it/update the statistics
+        ptCtl->pvFreeList = *(( PVOID* )pvBlock );
+        
+        // mark it in use
+        ptDef = ( PPOOLALLOCDEF )&g_atPoolAllocDefs[ ePool ];
+        wBlock = ( U16 )((( PU8 )pvBlock - ( PU8 )PGM_RDWORD( ptDef->pnPool )) / PGM_RDWORD( ptDef->wBlockSize ));
+        (( PU8 )PGM_RDWORD( ptDef->pnInUse ))[ wBlock >> 3 ] |= ( U8 )( 1 << ( wBlock & 0x07 ));
+        ptCtl->wNumUsed++;
+        ptCtl->wHighWater = MAX( ptCtl->wHighWater, ptCtl->wNumUsed );
+      }
+    }
+  }
+  
+  // check for failure
+  if (( pvBlock == NULL ) && ( POOLALLOC_ENUM_MAX != 0 ))
+  {
+    // charge it to the best fit or the largest pool
+    ePool = ( eFitPool != POOLALLOC_ENUM_ILLEGAL ) ? eFitPool : ( POOLALLOCENUM )( POOLALLOC_ENUM_MAX - 1 );
+    atPoolCtls[ ePool ].wNumFailed++;
+  }
+  
+  // re-enable interrupts
+  Interrupt_Enable( );
+  
+  // return the block
+  return( pvBlock );
+}
+
+/******************************************************************************
+ * @function PoolAllocator_Free
+ *
+ * @brief free a block
+ *
+ * This function will return a block to the pool that owns it.  A pointer
+ * that is not the start of a block or a block that is already free is
+ * rejected, leaving the free list and statistics untouched
+ *
+ * @param[in]   pvBlock   pointer to the block
+ *
+ * @return      TRUE if okay, FALSE if the block is not from any pool, is not
+ *              the start of a block or is not in use
+ *
+ *****************************************************************************/
+BOOL PoolAllocator_Free( PVOID pvBlock )
+{
+  BOOL          bStatus = FALSE;
+  BOOL          bFound = FALSE;
+  POOLALLOCENUM ePool;
+  PPOOLALLOCCTL ptCtl;
+  PPOOLALLOCDEF ptDef;
+  PU8           pnPool, pnInUse;
+  U16           wBlockSize;
+  U32           uOffset;
+  U16           wBlock;
+  U8            nMask;
+  
+  // search for the owning pool
+  for ( ePool = 0; ( ePool < POOLALLOC_ENUM_MAX ) && ( bFound == FALSE ); ePool++ )
+  {
+    // get a pointer to the control/definition structures
+    ptCtl = &atPoolCtls[ ePool ];
+    ptDef = ( PPOOLALLOCDEF )&g_atPoolAllocDefs[ ePool ];
+    
+    // get the storage/block size
+    pnPool = ( PU8 )PGM_RDWORD( ptDef->pnPool );
+    wBlockSize = PGM_RDWORD( ptDef->wBlockSize );
+    
+    // is the block inside this pool
+    if (( ( PU8 )pvBlock >= pnPool ) && (( PU8 )pvBlock < ( pnPool + (( U32 )wBlockSize * PGM_RDWORD( ptDef->wNumBlocks )))))
+    {
+      // compute the block index/bitmap mask
+      uOffset = ( U32 )(( PU8 )pvBlock - pnPool );
+      wBlock = ( U16 )( uOffset / wBlockSize );
+      nMask = ( U8 )( 1 << ( wBlock & 0x07 ));
+      pnInUse = ( PU8 )PGM_RDWORD( ptDef->pnInUse );
+      
+      // disable interrupts
+      Interrupt_Disable( );
+      
+      // is this the start of a block that is in use
+      if ((( uOffset % wBlockSize ) == 0 ) && (( pnInUse[ wBlock >> 3 ] & nMask ) != 0 ))
+      {
+        // mark it free/link it back on the free list
+        pnInUse[ wBlock >> 3 ] &= ~nMask;
+        *(( PVOID* )pvBlock ) = ptCtl->pvFreeList;
+        ptCtl->pvFreeList = pvBlock;
+        ptCtl->wNumUsed--;
+        
+        // set the status
+        bStatus = TRUE;
+      }
+      
+      // re-enable interrupts
+      Interrupt_Enable( );
+      
+      // stop searching
+      bFound = TRUE;
+    }
+  }
+  
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function PoolAllocator_GetStats
+ *
+ * @brief get the pool statistics
+ *
+ * This function will copy the size, usage and high water mark of a pool
+ *
+ * @param[in]   ePool     the pool enumeration
+ * @param[io]   ptStats   pointer to the statistics structure
+ *
+ * @return      TRUE if okay, FALSE if illegal pool enumeration
+ *
+ *****************************************************************************/
+BOOL PoolAllocator_GetStats( POOLALLOCENUM ePool, PPOOLALLOCSTATS ptStats )
+{
+  BOOL          bStatus = FALSE;
+  PPOOLALLOCCTL ptCtl;
+  PPOOLALLOCDEF ptDef;
+  
+  // check for a valid pool
+  if ( ePool < POOLALLOC_ENUM_MAX )
+  {
+    // get a pointer to the control/definition structures
+    ptCtl = &atPoolCtls[ ePool ];
+    ptDef = ( PPOOLALLOCDEF )&g_atPoolAllocDefs[ ePool ];
+    
+    // copy the statistics
+    ptStats->wBlockSize = PGM_RDWORD( ptDef->wBlockSize );
+    ptStats->wNumBlocks = PGM_RDWORD( ptDef->wNumBlocks );
+    Interrupt_Disable( );
+    ptStats->wNumUsed = ptCtl->wNumUsed;
+    ptStats->wHighWater = ptCtl->wHighWater;
+    ptStats->wNumFailed = ptCtl->wNumFailed;
+    Interrupt_Enable( );
+    
+    // set the status
+    bStatus = TRUE;
+  }
+  
+  // return the status
+  return( bStatus );
+}
+
+/**@} EOF PoolAllocator.c */
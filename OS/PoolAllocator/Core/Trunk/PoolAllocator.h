@@ -0,0 +1,61 @@
+/******************************************************************************
+ * @file PoolAllocator.h
+ *
+ * @brief pool allocator declarations
+ *
+ * This file declares the API's for the fixed block pool allocator
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup PoolAllocator
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instatiation
+#ifndef _POOLALLOCATOR_H
+#define _POOLALLOCATOR_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "PoolAllocator/PoolAllocator_cfg.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// define the pool statistics structure
+typedef struct _POOLALLOCSTATS
+{
+  U16   wBlockSize;       ///< size of each block
+  U16   wNumBlocks;       ///< number of blocks
+  U16   wNumUsed;         ///< number of blocks in use
+  U16   wHighWater;       ///< maximum number of blocks ever in use
+  U16   wNumFailed;       ///< number of failed allocations
+} POOLALLOCSTATS, *PPOOLALLOCSTATS;
+#define POOLALLOCSTATS_SIZE sizeof( POOLALLOCSTATS )
+
+// global parameter declarations -----------------------------------------------
+
+// global function prototypes --------------------------------------------------
+extern  void    PoolAllocator_Initialize( void );
+extern  PVOID   PoolAllocator_Alloc( U32 uSize );
+extern  BOOL    PoolAllocator_Free( PVOID pvBlock );
+extern  BOOL    PoolAllocator_GetStats( POOLALLOCENUM ePool, PPOOLALLOCSTATS ptStats );
+
+/**@} EOF PoolAllocator.h */
+
+#endif  // _POOLALLOCATOR_H
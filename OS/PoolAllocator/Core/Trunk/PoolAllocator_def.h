@@ -0,0 +1,77 @@
+/******************************************************************************
+ * @file PoolAllocator_def.h
+ *
+ * @brief pool allocator definition structures
+ *
+ * This file provides the structure and macros that allow the creation of a
+ * fixed block pool.
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration 
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * CyberIntegration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ * 
+ *
+ * \addtogroup PoolAllocator
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _POOLALLOCATOR_DEF_H
+#define _POOLALLOCATOR_DEF_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the macro to round a block size up to whole pointers
+#define POOLALLOC_BLOCK_WORDS( block_size ) \
+  ((( block_size ) + sizeof( PVOID ) - 1 ) / sizeof( PVOID ))
+
+/// define the macro to size the in-use bitmap of a pool
+#define POOLALLOC_INUSE_BYTES( num_blocks ) \
+  ((( num_blocks ) + 7 ) / 8 )
+
+/// define the macro to create the pool storage buffer/in-use bitmap
+#define POOLALLOC_BUFFER( name, block_size, num_blocks ) \
+  static PVOID apv ## name ## Pool[ POOLALLOC_BLOCK_WORDS( block_size ) * num_blocks ]; \
+  static U8    an ## name ## InUse[ POOLALLOC_INUSE_BYTES( num_blocks ) ]
+
+/// define the macro to create a pool entry
+#define POOLALLOC_ENTRY( name, block_size, num_blocks ) \
+  { .wBlockSize = POOLALLOC_BLOCK_WORDS( block_size ) * sizeof( PVOID ), \
+    .wNumBlocks = num_blocks, \
+    .pnPool = ( PU8 )&apv ## name ## Pool, \
+    .pnInUse = an ## name ## InUse, \
+  }
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// define the pool definition structure
+typedef struct _POOLALLOCDEF
+{
+  U16   wBlockSize;       ///< size of each block
+  U16   wNumBlocks;       ///< number of blocks
+  PU8   pnPool;           ///< pointer to the storage
+  PU8   pnInUse;          ///< pointer to the in-use bitmap
+} POOLALLOCDEF, *PPOOLALLOCDEF;
+#define POOLALLOCDEF_SIZE sizeof( POOLALLOCDEF )
+
+// global parameter declarations -----------------------------------------------
+
+// global function prototypes --------------------------------------------------
+
+/**@} EOF PoolAllocator_def.h */
+
+#endif  // _POOLALLOCATOR_DEF_H
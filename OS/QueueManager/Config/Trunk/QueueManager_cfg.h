@@ -27,6 +27,13 @@
 
 // system includes ------------------------------------------------------------
 
+/// define the macro for enabling single producer/single consumer queues
+/// this must precede the definitions include as it alters the definition
+#define QUEUEMANAGER_ENABLE_SPSC                        ( 0 )
+
+/// define the macro for enabling the zero copy reserve/commit, peek/release slots
+#define QUEUEMANAGER_ENABLE_ZEROCOPY                    ( 0 )
+
 // local includes -------------------------------------------------------------
 #include "QueueManager/QueueManager_def.h"
 
@@ -34,6 +34,17 @@
 /// define the macro foe creating events
 #define CREATE_QUEUE_EVENT( event, queue )    (( event << QUEUE_EVENT_SHIFT ) | queue )
 
+#if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+/// define the macros for the ordered index accesses
+#if defined( __GNUC__ )
+#define SPSC_LOAD_ACQUIRE( idx )              __atomic_load_n( &( idx ), __ATOMIC_ACQUIRE )
+#define SPSC_STORE_RELEASE( idx, val )        __atomic_store_n( &( idx ), ( val ), __ATOMIC_RELEASE )
+#else
+#define SPSC_LOAD_ACQUIRE( idx )              ( *( volatile XQUEUENUMENTRIES* )&( idx ))
+#define SPSC_STORE_RELEASE( idx, val )        ( *( volatile XQUEUENUMENTRIES* )&( idx ) = ( val ))
+#endif
+#endif
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
@@ -43,6 +54,18 @@ typedef struct _QUEUECTL
   XQUEUENUMENTRIES  xRdIdx;				///< queue read index
   XQUEUENUMENTRIES  xWrIdx;				///< queue write index
   XQUEUENUMENTRIES  xCount;				///< count	
+  #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+  BOOL              bSpsc;        ///< single producer/single consumer queue
+  XQUEUENUMENTRIES  xMask;        ///< index mask
+  XQUEUEENTRYSIZE   wSize;        ///< cached entry size
+  PU8               pnQueue;      ///< cached buffer pointer, NULL if illegal size
+  TASKSCHDENUMS     eTaskEnum;    ///< cached task enum
+  QUEUEEVNFLAGS     tEvents;      ///< cached event flags
+  #endif
+  #if ( QUEUEMANAGER_ENABLE_ZEROCOPY == 1 )
+  BOOL              bReserved;    ///< tail slot reserved
+  BOOL              bPeeked;      ///< head slot handed out by PeekSlot
+  #endif
 } QUEUECTL, *PQUEUECTL;
 #define	QUEUECTL_SIZE	sizeof( QUEUECTL )
 
@@ -50,6 +73,13 @@ typedef struct _QUEUECTL
 static	QUEUECTL	atQueueCtls[ QUEUE_ENUM_MAX ];
 
 // local function prototypes --------------------------------------------------
+static  XQUEUENUMENTRIES  GetCount( PQUEUECTL ptCtl );
+static  void              PostQueueEvent( QUEUEENUM eQueue, TASKSCHDENUMS eTaskEnum, U8 nEvent );
+#if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+static  QUEUESTATUS       SpscPut( QUEUEENUM eQueue, PQUEUECTL ptCtl, PU8 pnEntries, XQUEUENUMENTRIES xNumEntries, PXQUEUENUMENTRIES pxNumPut );
+static  QUEUESTATUS       SpscGet( QUEUEENUM eQueue, PQUEUECTL ptCtl, PU8 pnEntries, XQUEUENUMENTRIES xNumEntries, PXQUEUENUMENTRIES pxNumGot, BOOL bRemove );
+static  void              SpscCopy( PQUEUECTL ptCtl, XQUEUENUMENTRIES xIndex, PU8 pnData, XQUEUENUMENTRIES xNumEntries, BOOL bToQueue );
+#endif
 
 // constant parameter initializations -----------------------------------------
 
@@ -65,6 +95,10 @@ void QueueManager_Initialize( void )
 {
   QUEUEENUM eQueue;
   PQUEUECTL ptCtl;
+  #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+  PQUEUEDEF         ptDef;
+  XQUEUENUMENTRIES  xNumEntries;
+  #endif
   
   // for each queue in the list
   for ( eQueue = 0; eQueue < QUEUE_ENUM_MAX; eQueue++ )
@@ -76,6 +110,31 @@ void QueueManager_Initialize( void )
     ptCtl->xRdIdx = 0;
     ptCtl->xWrIdx = 0;
     ptCtl->xCount = 0;
+    #if ( QUEUEMANAGER_ENABLE_ZEROCOPY == 1 )
+    ptCtl->bReserved = FALSE;
+    ptCtl->bPeeked = FALSE;
+    #endif
+    
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // get a pointer to the definition
+    ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
+    
+    // cache the definition so the lock free path never touches program memory
+    ptCtl->bSpsc = PGM_RDBYTE( ptDef->bSpsc );
+    xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
+    ptCtl->xMask = xNumEntries - 1;
+    ptCtl->wSize = PGM_RDBYTE( ptDef->xEntrySize );
+    ptCtl->eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
+    ptCtl->tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
+    ptCtl->pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
+    
+    // the free running indices require a power of two number of entries
+    if (( ptCtl->bSpsc ) && (( xNumEntries == 0 ) || (( xNumEntries & ptCtl->xMask ) != 0 )))
+    {
+      // flag the queue as illegal
+      ptCtl->pnQueue = NULL;
+    }
+    #endif
   }
 }
 
@@ -113,70 +172,88 @@ QUEUESTATUS QueueManager_PutHead( QUEUEENUM eQueue, PU8 pnEntry )
     ptCtl = &atQueueCtls[ eQueue ];
     ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
     
-    // get the number of events
-    xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
-    
-    // is there room
-    if ( ptCtl->xCount < xNumEntries )
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // the head belongs to the consumer on a single producer/single consumer queue
+    if ( ptCtl->bSpsc )
     {
-      // get the size/event flags enables/task enum
-      wSize = PGM_RDBYTE( ptDef->xEntrySize );
-      tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
-      eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
+      eError = QUEUE_STATUS_ILLOPR;
+    }
+    else
+    #endif
+    #if ( QUEUEMANAGER_ENABLE_ZEROCOPY == 1 )
+    // a reserved slot may be the last free slot, a peeked slot must stay the head
+    if (( ptCtl->bReserved ) || ( ptCtl->bPeeked ))
+    {
+      eError = QUEUE_STATUS_RSVBSY;
+    }
+    else
+    #endif
+    {
+      // get the number of events
+      xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
+    
+      // is there room
+      if ( ptCtl->xCount < xNumEntries )
+      {
+        // get the size/event flags enables/task enum
+        wSize = PGM_RDBYTE( ptDef->xEntrySize );
+        tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
+        eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
       
-      // get the pointer to the queue
-      pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
+        // get the pointer to the queue
+        pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
       
-      // disable interrupts
-      Interrupt_Disable( );
+        // disable interrupts
+        Interrupt_Disable( );
       
-      // adjust the read pointer
-      if ( ptCtl->xRdIdx == 0 )
-      {
-        // reset the index to the end
-        ptCtl->xRdIdx = wSize - 1;
-      }
-      else
-      {
-        // increment the read index
-        ptCtl->xRdIdx++;
-      }
+        // adjust the read pointer
+        if ( ptCtl->xRdIdx == 0 )
+        {
+          // reset the index to the end
+          ptCtl->xRdIdx = xNumEntries - 1;
+        }
+        else
+        {
+          // decrement the read index
+          ptCtl->xRdIdx--;
+        }
       
-      // now copy the into the queue
-      memcpy(( pnQueue + ( ptCtl->xRdIdx * wSize )), pnEntry, wSize );
+        // now copy the into the queue
+        memcpy(( pnQueue + ( ptCtl->xRdIdx * wSize )), pnEntry, wSize );
       
-      // increment the count
-      ptCtl->xCount++;
+        // increment the count
+        ptCtl->xCount++;
       
-      // re-enable interrupts
-      Interrupt_Enable( );
+        // re-enable interrupts
+        Interrupt_Enable( );
       
-      // check get event
-      if ( tEvents.tBits.bPut )
-      {
-        // set the event
-        nEvent = QUEUE_EVENT_PUT;
-      }
+        // check get event
+        if ( tEvents.tBits.bPut )
+        {
+          // set the event
+          nEvent = QUEUE_EVENT_PUT;
+        }
       
-      // check for full
-      if (( ptCtl->xCount == xNumEntries ) && ( tEvents.tBits.bFull ))
-      {
-        // or the empty event
-        nEvent = QUEUE_EVENT_PUTFULL;
-      }
+        // check for full
+        if (( ptCtl->xCount == xNumEntries ) && ( tEvents.tBits.bFull ))
+        {
+          // or the empty event
+          nEvent = QUEUE_EVENT_PUTFULL;
+        }
       
-      // check if event is present
-      if ( nEvent != 0 )
+        // check if event is present
+        if ( nEvent != 0 )
+        {
+          // post the event
+          TaskManager_PostEvent( eTaskEnum, ( TASKARG )CREATE_QUEUE_EVENT( nEvent, eQueue ));
+        }
+      }
+      else
       {
-        // post the event
-        TaskManager_PostEvent( eTaskEnum, ( TASKARG )CREATE_QUEUE_EVENT( nEvent, eQueue ));
+        // return the queue full error
+        eError = QUEUE_STATUS_QUEFUL;
       }
     }
-    else
-    {
-      // return the queue full error
-      eError = QUEUE_STATUS_QUEFUL;
-    }
   }
   else
   {
@@ -221,66 +298,84 @@ QUEUESTATUS QueueManager_PutTail( QUEUEENUM eQueue, PU8 pnEntry )
     ptCtl = &atQueueCtls[ eQueue ];
     ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
     
-    // get the number of events
-    xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
-    
-    // is there room
-    if ( ptCtl->xCount < xNumEntries )
+    #if ( QUEUEMANAGER_ENABLE_ZEROCOPY == 1 )
+    // a reserved slot owns the tail until it is committed
+    if ( ptCtl->bReserved )
     {
-      // get the size/event flags enables/task enum
-      wSize = PGM_RDBYTE( ptDef->xEntrySize );
-      tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
-      eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
+      eError = QUEUE_STATUS_RSVBSY;
+    }
+    else
+    #endif
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // single producer/single consumer queues take the lock free path
+    if ( ptCtl->bSpsc )
+    {
+      eError = SpscPut( eQueue, ptCtl, pnEntry, 1, NULL );
+    }
+    else
+    #endif
+    {
+      // get the number of events
+      xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
+    
+      // is there room
+      if ( ptCtl->xCount < xNumEntries )
+      {
+        // get the size/event flags enables/task enum
+        wSize = PGM_RDBYTE( ptDef->xEntrySize );
+        tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
+        eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
       
-      // get the pointer to the queue
-      pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
+        // get the pointer to the queue
+        pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
       
-      // disable interrupts
-      Interrupt_Disable( );
+        // disable interrupts
+        Interrupt_Disable( );
       
-      // now copy the into the queue
-      memcpy(( pnQueue + ( ptCtl->xWrIdx * wSize )), pnEntry, wSize );
+        // now copy the into the queue
+        memcpy(( pnQueue + ( ptCtl->xWrIdx * wSize )), pnEntry, wSize );
       
-      // adjust the write index
-      ptCtl->xWrIdx++;
-      if ( ptCtl->xWrIdx >= xNumEntries )
-      {
-        // reset back to zero
-        ptCtl->xWrIdx = 0;
-      }
+        // adjust the write index
+        ptCtl->xWrIdx++;
+        if ( ptCtl->xWrIdx >= xNumEntries )
+        {
+          // reset back to zero
+          ptCtl->xWrIdx = 0;
+        }
       
-      // increment the count
-      ptCtl->xCount++;
+        // increment the count
+        ptCtl->xCount++;
       
-      // re-enable interrupts
-      Interrupt_Enable( );
+        // re-enable interrupts
+        Interrupt_Enable( );
       
-      // check get event
-      if ( tEvents.tBits.bPut )
-      {
-        // set the event
-        nEvent = QUEUE_EVENT_PUT;
-      }
+        // check get event
+        if ( tEvents.tBits.bPut )
+        {
+          // set the event
+          nEvent = QUEUE_EVENT_PUT;
+        }
       
-      // check for full
-      if (( ptCtl->xCount == xNumEntries ) && ( tEvents.tBits.bFull ))
-      {
-        // or the empty event
-        nEvent |= QUEUE_EVENT_PUTFULL;
-      }
+        // check for full
+        if (( ptCtl->xCount == xNumEntries ) && ( tEvents.tBits.bFull ))
+        {
+          // or the empty event
+          nEvent |= QUEUE_EVENT_PUTFULL;
+        }
       
-      // check if event is present
-      if ( nEvent != 0 )
+        // check if event is present
+        if ( nEvent != 0 )
+        {
+          // post the event
+          TaskManager_PostEvent( eTaskEnum, ( TASKARG )CREATE_QUEUE_EVENT( nEvent, eQueue ));
+        }
+      }
+      else
       {
-        // post the event
-        TaskManager_PostEvent( eTaskEnum, ( TASKARG )CREATE_QUEUE_EVENT( nEvent, eQueue ));
+        // return the queue full error
+        eError = QUEUE_STATUS_QUEFUL;
       }
     }
-    else
-    {
-      // return the queue full error
-      eError = QUEUE_STATUS_QUEFUL;
-    }
   }
   else
   {
@@ -293,19 +388,22 @@ QUEUESTATUS QueueManager_PutTail( QUEUEENUM eQueue, PU8 pnEntry )
 }
 
 /******************************************************************************
- * @function QueueManager_Get
+ * @function QueueManager_PutMany
  *
- * @brief gets an entry from the queue
+ * @brief puts a block of entries onto the tail of the queue
  *
- * This function will get a entry from the queue if one is available
+ * This function will put as many of the entries as will fit onto the tail of
+ * the queue under a single lock and post a single event for the whole block
  *
- * @param[in]   eQueue  the queue enumeration
- * @param[io]   pnEntry the pointer to store the queue entry in
+ * @param[in]   eQueue      the queue enumeration
+ * @param[in]   pnEntries   the pointer to the entries
+ * @param[in]   xNumEntries the number of entries
+ * @param[io]   pxNumPut    the pointer to store the number of entries put
  *
  * @return      a QUEUESTATUS value based on results
  *
  *****************************************************************************/
-QUEUESTATUS QueueManager_Get( QUEUEENUM eQueue, PU8 pnEntry )
+QUEUESTATUS QueueManager_PutMany( QUEUEENUM eQueue, PU8 pnEntries, XQUEUENUMENTRIES xNumEntries, PXQUEUENUMENTRIES pxNumPut )
 {
   QUEUESTATUS       eError = QUEUE_STATUS_NONE;
   PQUEUECTL		      ptCtl;
@@ -313,7 +411,8 @@ QUEUESTATUS QueueManager_Get( QUEUEENUM eQueue, PU8 pnEntry )
   QUEUEEVNFLAGS	    tEvents;
   TASKSCHDENUMS	    eTaskEnum;
   XQUEUEENTRYSIZE   wSize;
-  XQUEUENUMENTRIES  xNumEntries;
+  XQUEUENUMENTRIES  xMaxEntries;
+  XQUEUENUMENTRIES  xNumPut = 0;
   U8                nEvent = 0;
   PU8               pnQueue;
   
@@ -324,66 +423,85 @@ QUEUESTATUS QueueManager_Get( QUEUEENUM eQueue, PU8 pnEntry )
     ptCtl = &atQueueCtls[ eQueue ];
     ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
     
-    // get the number of events
-    xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
-    
-    // is there anything in the queue
-    if ( ptCtl->xCount != 0 )
+    #if ( QUEUEMANAGER_ENABLE_ZEROCOPY == 1 )
+    // a reserved slot owns the tail until it is committed
+    if ( ptCtl->bReserved )
+    {
+      eError = QUEUE_STATUS_RSVBSY;
+    }
+    else
+    #endif
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // single producer/single consumer queues take the lock free path
+    if ( ptCtl->bSpsc )
+    {
+      eError = SpscPut( eQueue, ptCtl, pnEntries, xNumEntries, &xNumPut );
+    }
+    else
+    #endif
     {
-      // get the size/event flags enables/task enum
+      // get the number of entries/size/event flags enables/task enum
+      xMaxEntries = PGM_RDBYTE( ptDef->xNumEntries );
       wSize = PGM_RDBYTE( ptDef->xEntrySize );
       tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
       eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
-      
+    
       // get the pointer to the queue
       pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
-      
+    
       // disable interrupts
       Interrupt_Disable( );
-      
-      // now copy the entry to the pointer
-      memcpy( pnEntry, ( pnQueue + ( ptCtl->xRdIdx * wSize )), wSize );
-      
-      // adjust the read index
-      ptCtl->xRdIdx++;
-      if ( ptCtl->xRdIdx >= xNumEntries )
+    
+      // copy as many entries as will fit
+      while (( xNumPut < xNumEntries ) && ( ptCtl->xCount < xMaxEntries ))
       {
-        // reset back to zero
-        ptCtl->xRdIdx = 0;
-      }
+        // copy the entry into the queue
+        memcpy(( pnQueue + ( ptCtl->xWrIdx * wSize )), ( pnEntries + ( xNumPut * wSize )), wSize );
       
-      // decrement  the count
-      ptCtl->xCount--;
+        // adjust the write index
+        ptCtl->xWrIdx++;
+        if ( ptCtl->xWrIdx >= xMaxEntries )
+        {
+          // reset back to zero
+          ptCtl->xWrIdx = 0;
+        }
       
+        // increment the count/number put
+        ptCtl->xCount++;
+        xNumPut++;
+      }
+    
       // re-enable interrupts
       Interrupt_Enable( );
-      
-      // check get event
-      if ( tEvents.tBits.bGet )
+    
+      // check for entries put
+      if ( xNumPut != 0 )
       {
-        // set the event
-        nEvent = QUEUE_EVENT_GET;
-      }
+        // check put event
+        if ( tEvents.tBits.bPut )
+        {
+          // set the event
+          nEvent = QUEUE_EVENT_PUT;
+        }
       
-      // check for empty
-      if (( ptCtl->xCount == 0 ) && ( tEvents.tBits.bEmpty ))
-      {
-        // or the empty event
-        nEvent |= QUEUE_EVENT_GETEMPTY;
-      }
+        // check for full
+        if (( ptCtl->xCount == xMaxEntries ) && ( tEvents.tBits.bFull ))
+        {
+          // or the full event
+          nEvent |= QUEUE_EVENT_PUTFULL;
+        }
       
-      // check if event is present
-      if ( nEvent != 0 )
+        // post one event for the block
+        PostQueueEvent( eQueue, eTaskEnum, nEvent );
+      }
+    
+      // check for not all entries put
+      if ( xNumPut < xNumEntries )
       {
-        // post the event
-        TaskManager_PostEvent( eTaskEnum, ( TASKARG )CREATE_QUEUE_EVENT( nEvent, eQueue ));
+        // return the queue full error
+        eError = QUEUE_STATUS_QUEFUL;
       }
     }
-    else
-    {
-      // return the queue empty error
-      eError = QUEUE_STATUS_QUEEMP;
-    }
   }
   else
   {
@@ -391,17 +509,23 @@ QUEUESTATUS QueueManager_Get( QUEUEENUM eQueue, PU8 pnEntry )
     eError = QUEUE_STATUS_ILLQUE;
   }
   
+  // check for a count pointer
+  if ( pxNumPut != NULL )
+  {
+    // return the number put
+    *( pxNumPut ) = xNumPut;
+  }
+  
   // return the status
   return( eError );
 }
 
 /******************************************************************************
- * @function QueueManager_Peek
+ * @function QueueManager_Get
  *
  * @brief gets an entry from the queue
  *
- * This function will get a entry from the queue if one is available but not 
- * remove from the queue
+ * This function will get a entry from the queue if one is available
  *
  * @param[in]   eQueue  the queue enumeration
  * @param[io]   pnEntry the pointer to store the queue entry in
@@ -409,13 +533,17 @@ QUEUESTATUS QueueManager_Get( QUEUEENUM eQueue, PU8 pnEntry )
  * @return      a QUEUESTATUS value based on results
  *
  *****************************************************************************/
-QUEUESTATUS QueueManager_Peek( QUEUEENUM eQueue, PU8 pnEntry )
+QUEUESTATUS QueueManager_Get( QUEUEENUM eQueue, PU8 pnEntry )
 {
-  QUEUESTATUS     eError = QUEUE_STATUS_NONE;
-  PQUEUECTL		    ptCtl;
-  PQUEUEDEF		    ptDef;
-  XQUEUEENTRYSIZE wSize;
-  PU8             pnQueue;
+  QUEUESTATUS       eError = QUEUE_STATUS_NONE;
+  PQUEUECTL		      ptCtl;
+  PQUEUEDEF		      ptDef;
+  QUEUEEVNFLAGS	    tEvents;
+  TASKSCHDENUMS	    eTaskEnum;
+  XQUEUEENTRYSIZE   wSize;
+  XQUEUENUMENTRIES  xNumEntries;
+  U8                nEvent = 0;
+  PU8               pnQueue;
   
   // check for a valid queue
   if ( eQueue < QUEUE_ENUM_MAX )
@@ -424,28 +552,75 @@ QUEUESTATUS QueueManager_Peek( QUEUEENUM eQueue, PU8 pnEntry )
     ptCtl = &atQueueCtls[ eQueue ];
     ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
     
-    // is there anything in the queue
-    if ( ptCtl->xCount != 0 )
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // single producer/single consumer queues take the lock free path
+    if ( ptCtl->bSpsc )
     {
-      // get the size/event flags enables/task enum
-      wSize = PGM_RDBYTE( ptDef->xEntrySize );
+      eError = SpscGet( eQueue, ptCtl, pnEntry, 1, NULL, TRUE );
+    }
+    else
+    #endif
+    {
+      // get the number of events
+      xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
+    
+      // is there anything in the queue
+      if ( ptCtl->xCount != 0 )
+      {
+        // get the size/event flags enables/task enum
+        wSize = PGM_RDBYTE( ptDef->xEntrySize );
+        tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
+        eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
       
-      // get the pointer to the queue
-      pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
+        // get the pointer to the queue
+        pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
       
-      // disable interrupts
-      Interrupt_Disable( );
+        // disable interrupts
+        Interrupt_Disable( );
       
-      // now copy the entry to the pointer
-      memcpy( pnEntry, ( pnQueue + ( ptCtl->xRdIdx * wSize )), wSize );
+        // now copy the entry to the pointer
+        memcpy( pnEntry, ( pnQueue + ( ptCtl->xRdIdx * wSize )), wSize );
       
-      // re-enable interrupts
-      Interrupt_Enable( );
-    }
-    else
-    {
-      // return the queue empty error
-      eError = QUEUE_STATUS_QUEEMP;
+        // adjust the read index
+        ptCtl->xRdIdx++;
+        if ( ptCtl->xRdIdx >= xNumEntries )
+        {
+          // reset back to zero
+          ptCtl->xRdIdx = 0;
+        }
+      
+        // decrement  the count
+        ptCtl->xCount--;
+      
+        // re-enable interrupts
+        Interrupt_Enable( );
+      
+        // check get event
+        if ( tEvents.tBits.bGet )
+        {
+          // set the event
+          nEvent = QUEUE_EVENT_GET;
+        }
+      
+        // check for empty
+        if (( ptCtl->xCount == 0 ) && ( tEvents.tBits.bEmpty ))
+        {
+          // or the empty event
+          nEvent |= QUEUE_EVENT_GETEMPTY;
+        }
+      
+        // check if event is present
+        if ( nEvent != 0 )
+        {
+          // post the event
+          TaskManager_PostEvent( eTaskEnum, ( TASKARG )CREATE_QUEUE_EVENT( nEvent, eQueue ));
+        }
+      }
+      else
+      {
+        // return the queue empty error
+        eError = QUEUE_STATUS_QUEEMP;
+      }
     }
   }
   else
@@ -459,26 +634,33 @@ QUEUESTATUS QueueManager_Peek( QUEUEENUM eQueue, PU8 pnEntry )
 }
 
 /******************************************************************************
- * @function QueueManager_Pop
+ * @function QueueManager_GetMany
  *
- * @brief removes an entry from the queue
+ * @brief gets a block of entries from the queue
  *
- * This function will pop an entry from the queue if one is there
+ * This function will get as many entries as are available up to the requested
+ * number under a single lock and post a single event for the whole block
  *
- * @param[in]   eQueue  the queue enumeration
+ * @param[in]   eQueue      the queue enumeration
+ * @param[io]   pnEntries   the pointer to store the entries in
+ * @param[in]   xNumEntries the maximum number of entries
+ * @param[io]   pxNumGot    the pointer to store the number of entries gotten
  *
  * @return      a QUEUESTATUS value based on results
  *
  *****************************************************************************/
-QUEUESTATUS QueueManager_Pop( QUEUEENUM eQueue )
+QUEUESTATUS QueueManager_GetMany( QUEUEENUM eQueue, PU8 pnEntries, XQUEUENUMENTRIES xNumEntries, PXQUEUENUMENTRIES pxNumGot )
 {
   QUEUESTATUS       eError = QUEUE_STATUS_NONE;
   PQUEUECTL		      ptCtl;
   PQUEUEDEF		      ptDef;
   QUEUEEVNFLAGS	    tEvents;
   TASKSCHDENUMS	    eTaskEnum;
-  XQUEUENUMENTRIES  xNumEntries;
+  XQUEUEENTRYSIZE   wSize;
+  XQUEUENUMENTRIES  xMaxEntries;
+  XQUEUENUMENTRIES  xNumGot = 0;
   U8                nEvent = 0;
+  PU8               pnQueue;
   
   // check for a valid queue
   if ( eQueue < QUEUE_ENUM_MAX )
@@ -487,52 +669,75 @@ QUEUESTATUS QueueManager_Pop( QUEUEENUM eQueue )
     ptCtl = &atQueueCtls[ eQueue ];
     ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
     
-    // get the number of events
-    xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
-    
-    // is there anything in the queue
-    if ( ptCtl->xCount != 0 )
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // single producer/single consumer queues take the lock free path
+    if ( ptCtl->bSpsc )
+    {
+      eError = SpscGet( eQueue, ptCtl, pnEntries, xNumEntries, &xNumGot, TRUE );
+    }
+    else
+    #endif
     {
-      // get the size/event flags enables/task enum
+      // get the number of entries/size/event flags enables/task enum
+      xMaxEntries = PGM_RDBYTE( ptDef->xNumEntries );
+      wSize = PGM_RDBYTE( ptDef->xEntrySize );
       tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
       eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
-      
+    
+      // get the pointer to the queue
+      pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
+    
       // disable interrupts
       Interrupt_Disable( );
-      
-      // adjust the read index
-      ptCtl->xRdIdx++;
-      if ( ptCtl->xRdIdx >= xNumEntries )
+    
+      // copy as many entries as are present
+      while (( xNumGot < xNumEntries ) && ( ptCtl->xCount != 0 ))
       {
-        // reset back to zero
-        ptCtl->xRdIdx = 0;
-      }
+        // copy the entry from the queue
+        memcpy(( pnEntries + ( xNumGot * wSize )), ( pnQueue + ( ptCtl->xRdIdx * wSize )), wSize );
       
-      // decrement  the count
-      ptCtl->xCount--;
+        // adjust the read index
+        ptCtl->xRdIdx++;
+        if ( ptCtl->xRdIdx >= xMaxEntries )
+        {
+          // reset back to zero
+          ptCtl->xRdIdx = 0;
+        }
       
+        // decrement the count/increment the number gotten
+        ptCtl->xCount--;
+        xNumGot++;
+      }
+    
       // re-enable interrupts
       Interrupt_Enable( );
-      
-      // check for empty
-      if (( ptCtl->xCount == 0 ) && ( tEvents.tBits.bEmpty ))
+    
+      // check for entries gotten
+      if ( xNumGot != 0 )
       {
-        // or the empty event
-        nEvent |= QUEUE_EVENT_GETEMPTY;
-      }
+        // check get event
+        if ( tEvents.tBits.bGet )
+        {
+          // set the event
+          nEvent = QUEUE_EVENT_GET;
+        }
       
-      // check if event is present
-      if ( nEvent != 0 )
+        // check for empty
+        if (( ptCtl->xCount == 0 ) && ( tEvents.tBits.bEmpty ))
+        {
+          // or the empty event
+          nEvent |= QUEUE_EVENT_GETEMPTY;
+        }
+      
+        // post one event for the block
+        PostQueueEvent( eQueue, eTaskEnum, nEvent );
+      }
+      else
       {
-        // post the event
-        TaskManager_PostEvent( eTaskEnum, ( TASKARG )CREATE_QUEUE_EVENT( nEvent, eQueue ));
+        // return the queue empty error
+        eError = QUEUE_STATUS_QUEEMP;
       }
     }
-    else
-    {
-      // return the queue empty error
-      eError = QUEUE_STATUS_QUEEMP;
-    }
   }
   else
   {
@@ -540,43 +745,79 @@ QUEUESTATUS QueueManager_Pop( QUEUEENUM eQueue )
     eError = QUEUE_STATUS_ILLQUE;
   }
   
+  // check for a count pointer
+  if ( pxNumGot != NULL )
+  {
+    // return the number gotten
+    *( pxNumGot ) = xNumGot;
+  }
+  
   // return the status
   return( eError );
 }
 
 /******************************************************************************
- * @function QueueManager_Flush
+ * @function QueueManager_Peek
  *
- * @brief flush all entries
+ * @brief gets an entry from the queue
  *
- * This function will flush all entries in the given queue and clear the indices
+ * This function will get a entry from the queue if one is available but not 
+ * remove from the queue
  *
  * @param[in]   eQueue  the queue enumeration
+ * @param[io]   pnEntry the pointer to store the queue entry in
  *
  * @return      a QUEUESTATUS value based on results
  *
  *****************************************************************************/
-QUEUESTATUS QueueManager_Flush( QUEUEENUM eQueue )
+QUEUESTATUS QueueManager_Peek( QUEUEENUM eQueue, PU8 pnEntry )
 {
-  QUEUESTATUS   eError = QUEUE_STATUS_NONE;
-  PQUEUECTL		  ptCtl;
+  QUEUESTATUS     eError = QUEUE_STATUS_NONE;
+  PQUEUECTL		    ptCtl;
+  PQUEUEDEF		    ptDef;
+  XQUEUEENTRYSIZE wSize;
+  PU8             pnQueue;
   
   // check for a valid queue
   if ( eQueue < QUEUE_ENUM_MAX )
   {
     // get a pointer to the control/definition structures
     ptCtl = &atQueueCtls[ eQueue ];
+    ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
     
-    // disable interrupts
-    Interrupt_Disable( );
-    
-    // clear the indices
-    ptCtl->xWrIdx = 0;
-    ptCtl->xRdIdx = 0;
-    ptCtl->xCount = 0;
-    
-    // re-enable interrupts
-    Interrupt_Enable( );
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // single producer/single consumer queues take the lock free path
+    if ( ptCtl->bSpsc )
+    {
+      eError = SpscGet( eQueue, ptCtl, pnEntry, 1, NULL, FALSE );
+    }
+    else
+    #endif
+    {
+      // is there anything in the queue
+      if ( ptCtl->xCount != 0 )
+      {
+        // get the size/event flags enables/task enum
+        wSize = PGM_RDBYTE( ptDef->xEntrySize );
+      
+        // get the pointer to the queue
+        pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
+      
+        // disable interrupts
+        Interrupt_Disable( );
+      
+        // now copy the entry to the pointer
+        memcpy( pnEntry, ( pnQueue + ( ptCtl->xRdIdx * wSize )), wSize );
+      
+        // re-enable interrupts
+        Interrupt_Enable( );
+      }
+      else
+      {
+        // return the queue empty error
+        eError = QUEUE_STATUS_QUEEMP;
+      }
+    }
   }
   else
   {
@@ -589,9 +830,164 @@ QUEUESTATUS QueueManager_Flush( QUEUEENUM eQueue )
 }
 
 /******************************************************************************
- * @function QueueManager_GetRemaining
+ * @function QueueManager_Pop
  *
- * @brief get the number of entries in the queue
+ * @brief removes an entry from the queue
+ *
+ * This function will pop an entry from the queue if one is there
+ *
+ * @param[in]   eQueue  the queue enumeration
+ *
+ * @return      a QUEUESTATUS value based on results
+ *
+ *****************************************************************************/
+QUEUESTATUS QueueManager_Pop( QUEUEENUM eQueue )
+{
+  QUEUESTATUS       eError = QUEUE_STATUS_NONE;
+  PQUEUECTL		      ptCtl;
+  PQUEUEDEF		      ptDef;
+  QUEUEEVNFLAGS	    tEvents;
+  TASKSCHDENUMS	    eTaskEnum;
+  XQUEUENUMENTRIES  xNumEntries;
+  U8                nEvent = 0;
+  
+  // check for a valid queue
+  if ( eQueue < QUEUE_ENUM_MAX )
+  {
+    // get a pointer to the control/definition structures
+    ptCtl = &atQueueCtls[ eQueue ];
+    ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
+    
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // single producer/single consumer queues take the lock free path
+    if ( ptCtl->bSpsc )
+    {
+      eError = SpscGet( eQueue, ptCtl, NULL, 1, NULL, TRUE );
+    }
+    else
+    #endif
+    {
+      // get the number of events
+      xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
+    
+      // is there anything in the queue
+      if ( ptCtl->xCount != 0 )
+      {
+        // get the size/event flags enables/task enum
+        tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
+        eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
+      
+        // disable interrupts
+        Interrupt_Disable( );
+      
+        // adjust the read index
+        ptCtl->xRdIdx++;
+        if ( ptCtl->xRdIdx >= xNumEntries )
+        {
+          // reset back to zero
+          ptCtl->xRdIdx = 0;
+        }
+      
+        // decrement  the count
+        ptCtl->xCount--;
+      
+        // re-enable interrupts
+        Interrupt_Enable( );
+      
+        // check for empty
+        if (( ptCtl->xCount == 0 ) && ( tEvents.tBits.bEmpty ))
+        {
+          // or the empty event
+          nEvent |= QUEUE_EVENT_GETEMPTY;
+        }
+      
+        // check if event is present
+        if ( nEvent != 0 )
+        {
+          // post the event
+          TaskManager_PostEvent( eTaskEnum, ( TASKARG )CREATE_QUEUE_EVENT( nEvent, eQueue ));
+        }
+      }
+      else
+      {
+        // return the queue empty error
+        eError = QUEUE_STATUS_QUEEMP;
+      }
+    }
+  }
+  else
+  {
+    // return the error
+    eError = QUEUE_STATUS_ILLQUE;
+  }
+  
+  // return the status
+  return( eError );
+}
+
+/******************************************************************************
+ * @function QueueManager_Flush
+ *
+ * @brief flush all entries
+ *
+ * This function will flush all entries in the given queue and clear the indices
+ *
+ * @param[in]   eQueue  the queue enumeration
+ *
+ * @return      a QUEUESTATUS value based on results
+ *
+ *****************************************************************************/
+QUEUESTATUS QueueManager_Flush( QUEUEENUM eQueue )
+{
+  QUEUESTATUS   eError = QUEUE_STATUS_NONE;
+  PQUEUECTL		  ptCtl;
+  
+  // check for a valid queue
+  if ( eQueue < QUEUE_ENUM_MAX )
+  {
+    // get a pointer to the control/definition structures
+    ptCtl = &atQueueCtls[ eQueue ];
+    
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // single producer/single consumer queues are flushed by the consumer
+    if ( ptCtl->bSpsc )
+    {
+      // move the read index up to the write index
+      SPSC_STORE_RELEASE( ptCtl->xRdIdx, SPSC_LOAD_ACQUIRE( ptCtl->xWrIdx ));
+    }
+    else
+    #endif
+    {
+      // disable interrupts
+      Interrupt_Disable( );
+    
+      // clear the indices
+      ptCtl->xWrIdx = 0;
+      ptCtl->xRdIdx = 0;
+      ptCtl->xCount = 0;
+      #if ( QUEUEMANAGER_ENABLE_ZEROCOPY == 1 )
+      ptCtl->bReserved = FALSE;
+      ptCtl->bPeeked = FALSE;
+      #endif
+    
+      // re-enable interrupts
+      Interrupt_Enable( );
+    }
+  }
+  else
+  {
+    // return the error
+    eError = QUEUE_STATUS_ILLQUE;
+  }
+  
+  // return the status
+  return( eError );
+}
+
+/******************************************************************************
+ * @function QueueManager_GetRemaining
+ *
+ * @brief get the number of entries in the queue
  *
  * This function will return the number of entries still in the queue
  *
@@ -609,7 +1005,7 @@ QUEUESTATUS QueueManager_GetRemaining( QUEUEENUM eQueue, PU8 pnRemaining )
   if ( eQueue < QUEUE_ENUM_MAX )
   {
     // set the remiaining equal to the count
-    *( pnRemaining ) = atQueueCtls[ eQueue ].xCount;
+    *( pnRemaining ) = GetCount( &atQueueCtls[ eQueue ] );
   }
   else
   {
@@ -639,6 +1035,7 @@ QUEUESTATUS QueueManager_GetStatus( QUEUEENUM eQueue )
   PQUEUECTL		      ptCtl;
   PQUEUEDEF		      ptDef;
   XQUEUENUMENTRIES  xNumEntries;
+  XQUEUENUMENTRIES  xCount;
   
   // check for a valid queue
   if ( eQueue < QUEUE_ENUM_MAX )
@@ -650,13 +1047,16 @@ QUEUESTATUS QueueManager_GetStatus( QUEUEENUM eQueue )
     // get the number of entries
     xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
     
+    // get the count
+    xCount = GetCount( ptCtl );
+    
     // is the queue empty
-    if ( ptCtl->xCount == 0 )
+    if ( xCount == 0 )
     {
       // set the queue empty status
       eError = QUEUE_STATUS_QUEEMP;
     }
-    else if ( ptCtl->xCount == xNumEntries )
+    else if ( xCount == xNumEntries )
     {
       // set the full error
       eError = QUEUE_STATUS_QUEFUL;
@@ -672,4 +1072,682 @@ QUEUESTATUS QueueManager_GetStatus( QUEUEENUM eQueue )
   return( eError );
 }
 
+#if ( QUEUEMANAGER_ENABLE_ZEROCOPY == 1 )
+/******************************************************************************
+ * @function QueueManager_Reserve
+ *
+ * @brief reserve the tail slot of the queue
+ *
+ * This function will return a pointer to the next free slot so the producer
+ * can build the entry in place.  The entry is not visible to the consumer and
+ * no other tail put is allowed until it is committed
+ *
+ * @param[in]   eQueue  the queue enumeration
+ * @param[io]   ppnSlot the pointer to store the slot pointer in
+ *
+ * @return      a QUEUESTATUS value based on results
+ *
+ *****************************************************************************/
+QUEUESTATUS QueueManager_Reserve( QUEUEENUM eQueue, PU8* ppnSlot )
+{
+  QUEUESTATUS       eError = QUEUE_STATUS_NONE;
+  PQUEUECTL		      ptCtl;
+  PQUEUEDEF		      ptDef;
+  XQUEUEENTRYSIZE   wSize;
+  XQUEUENUMENTRIES  xNumEntries;
+  PU8               pnQueue;
+  
+  // check for a valid queue
+  if ( eQueue < QUEUE_ENUM_MAX )
+  {
+    // get a pointer to the control/definition structures
+    ptCtl = &atQueueCtls[ eQueue ];
+    ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
+    
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // single producer/single consumer queues take the lock free path
+    if ( ptCtl->bSpsc )
+    {
+      // check for a legal queue/outstanding reservation/room
+      if ( ptCtl->pnQueue == NULL )
+      {
+        eError = QUEUE_STATUS_ILLQUE;
+      }
+      else if ( ptCtl->bReserved )
+      {
+        eError = QUEUE_STATUS_RSVBSY;
+      }
+      else if (( XQUEUENUMENTRIES )( ptCtl->xWrIdx - SPSC_LOAD_ACQUIRE( ptCtl->xRdIdx )) > ptCtl->xMask )
+      {
+        eError = QUEUE_STATUS_QUEFUL;
+      }
+      else
+      {
+        // hand out the slot at the write index
+        *( ppnSlot ) = ptCtl->pnQueue + (( ptCtl->xWrIdx & ptCtl->xMask ) * ptCtl->wSize );
+        ptCtl->bReserved = TRUE;
+      }
+    }
+    else
+    #endif
+    {
+      // get the number of entries/size/queue pointer
+      xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
+      wSize = PGM_RDBYTE( ptDef->xEntrySize );
+      pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
+    
+      // disable interrupts
+      Interrupt_Disable( );
+    
+      // check for an outstanding reservation/room
+      if ( ptCtl->bReserved )
+      {
+        eError = QUEUE_STATUS_RSVBSY;
+      }
+      else if ( ptCtl->xCount >= xNumEntries )
+      {
+        eError = QUEUE_STATUS_QUEFUL;
+      }
+      else
+      {
+        // hand out the slot at the write index
+        *( ppnSlot ) = pnQueue + ( ptCtl->xWrIdx * wSize );
+        ptCtl->bReserved = TRUE;
+      }
+    
+      // re-enable interrupts
+      Interrupt_Enable( );
+    }
+  }
+  else
+  {
+    // return the error
+    eError = QUEUE_STATUS_ILLQUE;
+  }
+  
+  // return the status
+  return( eError );
+}
+
+/******************************************************************************
+ * @function QueueManager_Commit
+ *
+ * @brief commit the reserved slot
+ *
+ * This function will make the reserved slot visible to the consumer and post
+ * the put events
+ *
+ * @param[in]   eQueue  the queue enumeration
+ *
+ * @return      a QUEUESTATUS value based on results
+ *
+ *****************************************************************************/
+QUEUESTATUS QueueManager_Commit( QUEUEENUM eQueue )
+{
+  QUEUESTATUS       eError = QUEUE_STATUS_NONE;
+  PQUEUECTL		      ptCtl;
+  PQUEUEDEF		      ptDef;
+  QUEUEEVNFLAGS	    tEvents;
+  TASKSCHDENUMS	    eTaskEnum;
+  XQUEUENUMENTRIES  xNumEntries;
+  U8                nEvent = 0;
+  
+  // check for a valid queue
+  if ( eQueue < QUEUE_ENUM_MAX )
+  {
+    // get a pointer to the control/definition structures
+    ptCtl = &atQueueCtls[ eQueue ];
+    ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
+    
+    // check for a reservation
+    if ( ptCtl->bReserved )
+    {
+      #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+      // single producer/single consumer queues take the lock free path
+      if ( ptCtl->bSpsc )
+      {
+        // clear the reservation/publish the entry
+        ptCtl->bReserved = FALSE;
+        SPSC_STORE_RELEASE( ptCtl->xWrIdx, ( XQUEUENUMENTRIES )( ptCtl->xWrIdx + 1 ));
+        
+        // check put event
+        if ( ptCtl->tEvents.tBits.bPut )
+        {
+          // set the event
+          nEvent = QUEUE_EVENT_PUT;
+        }
+        
+        // check for full
+        if ((( XQUEUENUMENTRIES )( ptCtl->xWrIdx - SPSC_LOAD_ACQUIRE( ptCtl->xRdIdx )) > ptCtl->xMask ) && ( ptCtl->tEvents.tBits.bFull ))
+        {
+          // set the full event
+          nEvent = QUEUE_EVENT_PUTFULL;
+        }
+        
+        // post the event
+        PostQueueEvent( eQueue, ptCtl->eTaskEnum, nEvent );
+      }
+      else
+      #endif
+      {
+        // get the number of entries/event flags enables/task enum
+        xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
+        tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
+        eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
+      
+        // disable interrupts
+        Interrupt_Disable( );
+      
+        // adjust the write index
+        ptCtl->xWrIdx++;
+        if ( ptCtl->xWrIdx >= xNumEntries )
+        {
+          // reset back to zero
+          ptCtl->xWrIdx = 0;
+        }
+      
+        // increment the count/clear the reservation
+        ptCtl->xCount++;
+        ptCtl->bReserved = FALSE;
+      
+        // re-enable interrupts
+        Interrupt_Enable( );
+      
+        // check put event
+        if ( tEvents.tBits.bPut )
+        {
+          // set the event
+          nEvent = QUEUE_EVENT_PUT;
+        }
+      
+        // check for full
+        if (( ptCtl->xCount == xNumEntries ) && ( tEvents.tBits.bFull ))
+        {
+          // set the full event
+          nEvent = QUEUE_EVENT_PUTFULL;
+        }
+      
+        // post the event
+        PostQueueEvent( eQueue, eTaskEnum, nEvent );
+      }
+    }
+    else
+    {
+      // nothing to commit
+      eError = QUEUE_STATUS_ILLOPR;
+    }
+  }
+  else
+  {
+    // return the error
+    eError = QUEUE_STATUS_ILLQUE;
+  }
+  
+  // return the status
+  return( eError );
+}
+
+/******************************************************************************
+ * @function QueueManager_PeekSlot
+ *
+ * @brief get a pointer to the head entry of the queue
+ *
+ * This function will return a pointer to the head entry so the consumer can
+ * parse it in place.  The entry remains valid until it is released
+ *
+ * @param[in]   eQueue  the queue enumeration
+ * @param[io]   ppnSlot the pointer to store the slot pointer in
+ *
+ * @return      a QUEUESTATUS value based on results
+ *
+ *****************************************************************************/
+QUEUESTATUS QueueManager_PeekSlot( QUEUEENUM eQueue, PU8* ppnSlot )
+{
+  QUEUESTATUS       eError = QUEUE_STATUS_NONE;
+  PQUEUECTL		      ptCtl;
+  PQUEUEDEF		      ptDef;
+  XQUEUEENTRYSIZE   wSize;
+  PU8               pnQueue;
+  
+  // check for a valid queue
+  if ( eQueue < QUEUE_ENUM_MAX )
+  {
+    // get a pointer to the control/definition structures
+    ptCtl = &atQueueCtls[ eQueue ];
+    ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
+    
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // single producer/single consumer queues take the lock free path
+    if ( ptCtl->bSpsc )
+    {
+      // check for a legal queue/entry
+      if ( ptCtl->pnQueue == NULL )
+      {
+        eError = QUEUE_STATUS_ILLQUE;
+      }
+      else if ( SPSC_LOAD_ACQUIRE( ptCtl->xWrIdx ) == ptCtl->xRdIdx )
+      {
+        eError = QUEUE_STATUS_QUEEMP;
+      }
+      else
+      {
+        // hand out the slot at the read index
+        *( ppnSlot ) = ptCtl->pnQueue + (( ptCtl->xRdIdx & ptCtl->xMask ) * ptCtl->wSize );
+        ptCtl->bPeeked = TRUE;
+      }
+    }
+    else
+    #endif
+    {
+      // is there anything in the queue
+      if ( ptCtl->xCount != 0 )
+      {
+        // get the size/queue pointer
+        wSize = PGM_RDBYTE( ptDef->xEntrySize );
+        pnQueue = ( PU8 )PGM_RDWORD( ptDef->pnQueue );
+      
+        // hand out the slot at the read index
+        *( ppnSlot ) = pnQueue + ( ptCtl->xRdIdx * wSize );
+        ptCtl->bPeeked = TRUE;
+      }
+      else
+      {
+        // return the queue empty error
+        eError = QUEUE_STATUS_QUEEMP;
+      }
+    }
+  }
+  else
+  {
+    // return the error
+    eError = QUEUE_STATUS_ILLQUE;
+  }
+  
+  // return the status
+  return( eError );
+}
+
+/******************************************************************************
+ * @function QueueManager_Release
+ *
+ * @brief release the head entry of the queue
+ *
+ * This function will remove the entry returned by PeekSlot and post the get
+ * events, it is illegal without an outstanding PeekSlot
+ *
+ * @param[in]   eQueue  the queue enumeration
+ *
+ * @return      a QUEUESTATUS value based on results
+ *
+ *****************************************************************************/
+QUEUESTATUS QueueManager_Release( QUEUEENUM eQueue )
+{
+  QUEUESTATUS       eError = QUEUE_STATUS_NONE;
+  PQUEUECTL		      ptCtl;
+  PQUEUEDEF		      ptDef;
+  QUEUEEVNFLAGS	    tEvents;
+  TASKSCHDENUMS	    eTaskEnum;
+  XQUEUENUMENTRIES  xNumEntries;
+  U8                nEvent = 0;
+  
+  // check for a valid queue
+  if ( eQueue < QUEUE_ENUM_MAX )
+  {
+    // get a pointer to the control/definition structures
+    ptCtl = &atQueueCtls[ eQueue ];
+    ptDef = ( PQUEUEDEF )&g_atQueueDefs[ eQueue ];
+    
+    // a slot must have been peeked
+    if ( !ptCtl->bPeeked )
+    {
+      eError = QUEUE_STATUS_ILLOPR;
+    }
+    else
+    #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+    // single producer/single consumer queues take the lock free path
+    if ( ptCtl->bSpsc )
+    {
+      ptCtl->bPeeked = FALSE;
+      eError = SpscGet( eQueue, ptCtl, NULL, 1, NULL, TRUE );
+    }
+    else
+    #endif
+    {
+      // is there anything in the queue
+      if ( ptCtl->xCount != 0 )
+      {
+        // get the number of entries/event flags enables/task enum
+        xNumEntries = PGM_RDBYTE( ptDef->xNumEntries );
+        tEvents.nByte = ( U8 )PGM_RDBYTE( ptDef->tEventFlags.nByte );
+        eTaskEnum = PGM_RDBYTE( ptDef->eTaskEnum );
+      
+        // disable interrupts
+        Interrupt_Disable( );
+      
+        // adjust the read index
+        ptCtl->xRdIdx++;
+        if ( ptCtl->xRdIdx >= xNumEntries )
+        {
+          // reset back to zero
+          ptCtl->xRdIdx = 0;
+        }
+      
+        // decrement the count/the peeked slot is gone
+        ptCtl->xCount--;
+        ptCtl->bPeeked = FALSE;
+      
+        // re-enable interrupts
+        Interrupt_Enable( );
+      
+        // check get event
+        if ( tEvents.tBits.bGet )
+        {
+          // set the event
+          nEvent = QUEUE_EVENT_GET;
+        }
+      
+        // check for empty
+        if (( ptCtl->xCount == 0 ) && ( tEvents.tBits.bEmpty ))
+        {
+          // set the empty event
+          nEvent = QUEUE_EVENT_GETEMPTY;
+        }
+      
+        // post the event
+        PostQueueEvent( eQueue, eTaskEnum, nEvent );
+      }
+      else
+      {
+        // return the queue empty error
+        eError = QUEUE_STATUS_QUEEMP;
+      }
+    }
+  }
+  else
+  {
+    // return the error
+    eError = QUEUE_STATUS_ILLQUE;
+  }
+  
+  // return the status
+  return( eError );
+}
+#endif
+
+/******************************************************************************
+ * @function GetCount
+ *
+ * @brief get the number of entries in a queue
+ *
+ * This function will return the current count for either queue type
+ *
+ * @param[in]   ptCtl   pointer to the queue control
+ *
+ * @return      the number of entries
+ *
+ *****************************************************************************/
+static XQUEUENUMENTRIES GetCount( PQUEUECTL ptCtl )
+{
+  XQUEUENUMENTRIES  xCount;
+  
+  // default to the locked count
+  xCount = ptCtl->xCount;
+  
+  #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+  // single producer/single consumer queues derive it from the indices
+  if ( ptCtl->bSpsc )
+  {
+    xCount = ( XQUEUENUMENTRIES )( SPSC_LOAD_ACQUIRE( ptCtl->xWrIdx ) - SPSC_LOAD_ACQUIRE( ptCtl->xRdIdx ));
+  }
+  #endif
+  
+  // return the count
+  return( xCount );
+}
+
+/******************************************************************************
+ * @function PostQueueEvent
+ *
+ * @brief post a queue event
+ *
+ * This function will post the event to the task if one is present
+ *
+ * @param[in]   eQueue      the queue enumeration
+ * @param[in]   eTaskEnum   the task to post to
+ * @param[in]   nEvent      the queue event
+ *
+ *****************************************************************************/
+static void PostQueueEvent( QUEUEENUM eQueue, TASKSCHDENUMS eTaskEnum, U8 nEvent )
+{
+  // check if event is present
+  if ( nEvent != 0 )
+  {
+    // post the event
+    TaskManager_PostEvent( eTaskEnum, ( TASKARG )CREATE_QUEUE_EVENT( nEvent, eQueue ));
+  }
+}
+
+#if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+/******************************************************************************
+ * @function SpscPut
+ *
+ * @brief put entries onto a single producer/single consumer queue
+ *
+ * This function will copy as many entries as will fit and then publish them
+ * with a single release store of the write index.  Only the producer may
+ * call this
+ *
+ * @param[in]   eQueue      the queue enumeration
+ * @param[in]   ptCtl       pointer to the queue control
+ * @param[in]   pnEntries   the pointer to the entries
+ * @param[in]   xNumEntries the number of entries
+ * @param[io]   pxNumPut    the pointer to store the number put, can be NULL
+ *
+ * @return      a QUEUESTATUS value based on results
+ *
+ *****************************************************************************/
+static QUEUESTATUS SpscPut( QUEUEENUM eQueue, PQUEUECTL ptCtl, PU8 pnEntries, XQUEUENUMENTRIES xNumEntries, PXQUEUENUMENTRIES pxNumPut )
+{
+  QUEUESTATUS       eError = QUEUE_STATUS_NONE;
+  XQUEUENUMENTRIES  xWrIdx, xFree;
+  XQUEUENUMENTRIES  xNumPut = 0;
+  U8                nEvent = 0;
+  
+  // check for a legal queue
+  if ( ptCtl->pnQueue != NULL )
+  {
+    // the write index is ours, the read index is the consumers
+    xWrIdx = ptCtl->xWrIdx;
+    xFree = ( XQUEUENUMENTRIES )(( ptCtl->xMask + 1 ) - ( XQUEUENUMENTRIES )( xWrIdx - SPSC_LOAD_ACQUIRE( ptCtl->xRdIdx )));
+    
+    // determine the number to put
+    xNumPut = ( xNumEntries < xFree ) ? xNumEntries : xFree;
+    if ( xNumPut != 0 )
+    {
+      // copy the entries and publish them
+      SpscCopy( ptCtl, xWrIdx, pnEntries, xNumPut, TRUE );
+      SPSC_STORE_RELEASE( ptCtl->xWrIdx, ( XQUEUENUMENTRIES )( xWrIdx + xNumPut ));
+      
+      // check put event
+      if ( ptCtl->tEvents.tBits.bPut )
+      {
+        // set the event
+        nEvent = QUEUE_EVENT_PUT;
+      }
+      
+      // check for full
+      if (( xNumPut == xFree ) && ( ptCtl->tEvents.tBits.bFull ))
+      {
+        // or the full event
+        nEvent |= QUEUE_EVENT_PUTFULL;
+      }
+      
+      // post one event for the block
+      PostQueueEvent( eQueue, ptCtl->eTaskEnum, nEvent );
+    }
+    
+    // check for not all entries put
+    if ( xNumPut < xNumEntries )
+    {
+      // return the queue full error
+      eError = QUEUE_STATUS_QUEFUL;
+    }
+  }
+  else
+  {
+    // return the error
+    eError = QUEUE_STATUS_ILLQUE;
+  }
+  
+  // check for a count pointer
+  if ( pxNumPut != NULL )
+  {
+    // return the number put
+    *( pxNumPut ) = xNumPut;
+  }
+  
+  // return the status
+  return( eError );
+}
+
+/******************************************************************************
+ * @function SpscGet
+ *
+ * @brief get entries from a single producer/single consumer queue
+ *
+ * This function will copy as many entries as are available and, if requested,
+ * release them back to the producer with a single store of the read index.
+ * Only the consumer may call this
+ *
+ * @param[in]   eQueue      the queue enumeration
+ * @param[in]   ptCtl       pointer to the queue control
+ * @param[io]   pnEntries   the pointer to store the entries in, NULL to discard
+ * @param[in]   xNumEntries the maximum number of entries
+ * @param[io]   pxNumGot    the pointer to store the number gotten, can be NULL
+ * @param[in]   bRemove     TRUE to remove the entries, FALSE to peek
+ *
+ * @return      a QUEUESTATUS value based on results
+ *
+ *****************************************************************************/
+static QUEUESTATUS SpscGet( QUEUEENUM eQueue, PQUEUECTL ptCtl, PU8 pnEntries, XQUEUENUMENTRIES xNumEntries, PXQUEUENUMENTRIES pxNumGot, BOOL bRemove )
+{
+  QUEUESTATUS       eError = QUEUE_STATUS_NONE;
+  XQUEUENUMENTRIES  xRdIdx, xUsed;
+  XQUEUENUMENTRIES  xNumGot = 0;
+  U8                nEvent = 0;
+  
+  // check for a legal queue
+  if ( ptCtl->pnQueue != NULL )
+  {
+    // the read index is ours, the write index is the producers
+    xRdIdx = ptCtl->xRdIdx;
+    xUsed = ( XQUEUENUMENTRIES )( SPSC_LOAD_ACQUIRE( ptCtl->xWrIdx ) - xRdIdx );
+    
+    // determine the number to get
+    xNumGot = ( xNumEntries < xUsed ) ? xNumEntries : xUsed;
+    if ( xNumGot != 0 )
+    {
+      // check for a destination
+      if ( pnEntries != NULL )
+      {
+        // copy the entries
+        SpscCopy( ptCtl, xRdIdx, pnEntries, xNumGot, FALSE );
+      }
+      
+      // check for remove
+      if ( bRemove )
+      {
+        // release the entries
+        SPSC_STORE_RELEASE( ptCtl->xRdIdx, ( XQUEUENUMENTRIES )( xRdIdx + xNumGot ));
+        
+        // check get event
+        if ( ptCtl->tEvents.tBits.bGet )
+        {
+          // set the event
+          nEvent = QUEUE_EVENT_GET;
+        }
+        
+        // check for empty
+        if (( xNumGot == xUsed ) && ( ptCtl->tEvents.tBits.bEmpty ))
+        {
+          // or the empty event
+          nEvent |= QUEUE_EVENT_GETEMPTY;
+        }
+        
+        // post one event for the block
+        PostQueueEvent( eQueue, ptCtl->eTaskEnum, nEvent );
+      }
+    }
+    else
+    {
+      // return the queue empty error
+      eError = QUEUE_STATUS_QUEEMP;
+    }
+  }
+  else
+  {
+    // return the error
+    eError = QUEUE_STATUS_ILLQUE;
+  }
+  
+  // check for a count pointer
+  if ( pxNumGot != NULL )
+  {
+    // return the number gotten
+    *( pxNumGot ) = xNumGot;
+  }
+  
+  // return the status
+  return( eError );
+}
+
+/******************************************************************************
+ * @function SpscCopy
+ *
+ * @brief copy entries to/from a single producer/single consumer queue
+ *
+ * This function will copy a block of entries, splitting the copy in two when
+ * it wraps past the end of the buffer
+ *
+ * @param[in]   ptCtl       pointer to the queue control
+ * @param[in]   xIndex      free running index of the first entry
+ * @param[io]   pnData      pointer to the callers entries
+ * @param[in]   xNumEntries number of entries
+ * @param[in]   bToQueue    TRUE to copy into the queue, FALSE to copy out
+ *
+ *****************************************************************************/
+static void SpscCopy( PQUEUECTL ptCtl, XQUEUENUMENTRIES xIndex, PU8 pnData, XQUEUENUMENTRIES xNumEntries, BOOL bToQueue )
+{
+  XQUEUENUMENTRIES  xFirst;
+  U32               uFirstBytes, uRestBytes;
+  PU8               pnSlot;
+  
+  // mask the index/get the number of entries up to the end of the buffer
+  xIndex &= ptCtl->xMask;
+  xFirst = ( XQUEUENUMENTRIES )(( ptCtl->xMask + 1 ) - xIndex );
+  if ( xFirst > xNumEntries )
+  {
+    // all fit before the wrap
+    xFirst = xNumEntries;
+  }
+  
+  // compute the byte counts/slot pointer
+  uFirstBytes = ( U32 )xFirst * ptCtl->wSize;
+  uRestBytes = ( U32 )( xNumEntries - xFirst ) * ptCtl->wSize;
+  pnSlot = ptCtl->pnQueue + (( U32 )xIndex * ptCtl->wSize );
+  
+  // copy in the requested direction
+  if ( bToQueue )
+  {
+    memcpy( pnSlot, pnData, uFirstBytes );
+    memcpy( ptCtl->pnQueue, pnData + uFirstBytes, uRestBytes );
+  }
+  else
+  {
+    memcpy( pnData, pnSlot, uFirstBytes );
+    memcpy( pnData + uFirstBytes, ptCtl->pnQueue, uRestBytes );
+  }
+}
+#endif
+
 /**@} EOF QueueManager.c */
@@ -42,6 +42,8 @@ typedef enum _QUEUESTATUS
   QUEUE_STATUS_ILLQUE,       // illegal queue
   QUEUE_STATUS_QUEFUL,       // queue full
   QUEUE_STATUS_QUEEMP,       // queue empty
+  QUEUE_STATUS_ILLOPR,       // illegal operation for this queue type/state
+  QUEUE_STATUS_RSVBSY,       // a reserved slot is waiting to be committed or a peeked slot released
 } QUEUESTATUS;
 
 // structures -----------------------------------------------------------------
@@ -52,12 +54,20 @@ typedef enum _QUEUESTATUS
 extern  void        QueueManager_Initialize( void );
 extern  QUEUESTATUS QueueManager_PutHead( QUEUEENUM eQueue, PU8 pnEntry );
 extern  QUEUESTATUS QueueManager_PutTail( QUEUEENUM eQueue, PU8 pnEntry );
+extern  QUEUESTATUS QueueManager_PutMany( QUEUEENUM eQueue, PU8 pnEntries, XQUEUENUMENTRIES xNumEntries, PXQUEUENUMENTRIES pxNumPut );
 extern  QUEUESTATUS QueueManager_Get( QUEUEENUM eQueue, PU8 pnEntry );
+extern  QUEUESTATUS QueueManager_GetMany( QUEUEENUM eQueue, PU8 pnEntries, XQUEUENUMENTRIES xNumEntries, PXQUEUENUMENTRIES pxNumGot );
 extern  QUEUESTATUS QueueManager_Peek( QUEUEENUM eQueue, PU8 pnEntry );
 extern  QUEUESTATUS QueueManager_Pop( QUEUEENUM eQueue );
 extern  QUEUESTATUS QueueManager_Flush( QUEUEENUM eQueue );
 extern  QUEUESTATUS QueueManager_GetRemaining( QUEUEENUM eQueue, PU8 pnRemaining );
 extern  QUEUESTATUS QueueManager_GetStatus( QUEUEENUM eQueue );  
+#if ( QUEUEMANAGER_ENABLE_ZEROCOPY == 1 )
+extern  QUEUESTATUS QueueManager_Reserve( QUEUEENUM eQueue, PU8* ppnSlot );
+extern  QUEUESTATUS QueueManager_Commit( QUEUEENUM eQueue );
+extern  QUEUESTATUS QueueManager_PeekSlot( QUEUEENUM eQueue, PU8* ppnSlot );
+extern  QUEUESTATUS QueueManager_Release( QUEUEENUM eQueue );
+#endif
 
 /**@} EOF QueueManager.h */
 
@@ -54,6 +54,24 @@
     }, \
   }  
 
+#if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+/// define the macro to create a single producer/single consumer queue entry
+/// the number of entries must be a power of two
+#define QUEUE_SPSCENTRY( task, entry_size, num_entries, name, empflg, putflg, getflg, fullflg ) \
+  { .eTaskEnum = task, \
+    .xEntrySize = entry_size, \
+    .xNumEntries = num_entries, \
+    .pnQueue = ( PU8 )&an ## name ## Queue, \
+    .tEventFlags.tBits = \
+    { .bEmpty = empflg, \
+      .bPut = putflg, \
+      .bGet = getflg, \
+      .bFull = fullflg, \
+    }, \
+    .bSpsc = TRUE, \
+  }  
+#endif
+
 /// define the queue entry type
 #if ( QUEUEMAMAGER_ENABLE_LARGE_ENTRY_SIZE )
 typedef U16   XQUEUEENTRYSIZE;
@@ -63,9 +81,9 @@ typedef U8    XQUEUEENTRYSIZE;
 
 /// define the queue number of entries type
 #if ( QUEUEMANAGER_ENABLE_LARGE_NUMBER_ENTRIES )
-typedef U16   XQUEUENUMENTRIES;
+typedef U16   XQUEUENUMENTRIES, *PXQUEUENUMENTRIES;
 #else
-typedef U8    XQUEUENUMENTRIES;
+typedef U8    XQUEUENUMENTRIES, *PXQUEUENUMENTRIES;
 #endif
 
 /// define the queue event shift value
@@ -125,6 +143,9 @@ typedef struct 	_QUEUEDEF
   XQUEUEENTRYSIZE   xEntrySize;		///< size of each entry
   QUEUEEVNFLAGS     tEventFlags;	///< event flags
   PU8			          pnQueue;		  ///< pointer to the buffer
+  #if ( QUEUEMANAGER_ENABLE_SPSC == 1 )
+  BOOL              bSpsc;        ///< single producer/single consumer queue
+  #endif
 } QUEUEDEF, *PQUEUEDEF;
 #define QUEUEDEF_SIZE sizeof( QUEUEDEF )
 
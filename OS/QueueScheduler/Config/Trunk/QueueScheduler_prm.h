@@ -0,0 +1,45 @@
+/******************************************************************************
+ * @file QueueScheduler_prm.h
+ *
+ * @brief Queue Scheduler parameter declarations
+ *
+ * This file provides the parameter declarations for the queue scheduler
+ *
+ * @copyright Copyright (c) 2017 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ * 
+ *
+ * \addtogroup QueueScheduler
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _QUEUESCHEDULER_PRM_H
+#define _QUEUESCHEDULER_PRM_H
+
+// Macros and Defines ---------------------------------------------------------
+/// define the macros to include the optional functions
+#define QUEUESCHEDULER_INCLUDE_PUTHEAD            ( TRUE )
+#define QUEUESCHEDULER_INCLUDE_PEEK               ( TRUE )
+#define QUEUESCHEDULER_INCLUDE_POP                ( TRUE )
+#define QUEUESCHEDULER_INCLUDE_FLUSH              ( TRUE )
+#define QUEUESCHEDULER_INCLUDE_GETREMAINING       ( TRUE )
+#define QUEUESCHEDULER_INCLUDE_GETSTATUS          ( TRUE )
+
+/// define the macro to include the zero copy reserve/commit, peek/release slots
+#define QUEUESCHEDULER_INCLUDE_ZEROCOPY           ( FALSE )
+
+/// define the macro to allocate queues from the pool allocator
+#define QUEUESCHEDULER_ENABLE_POOL_ALLOCATOR      ( FALSE )
+
+/**@} EOF QueueScheduler_prm.h */
+
+#endif  // _QUEUESCHEDULER_PRM_H
@@ -29,10 +29,20 @@
 
 // library includes -----------------------------------------------------------
 #include "Interrupt/Interrupt.h"
+#if ( QUEUESCHEDULER_ENABLE_POOL_ALLOCATOR == TRUE )
+#include "PoolAllocator/PoolAllocator.h"
+#endif
 
 // Macros and Defines ---------------------------------------------------------/// define the macro to map the control pointer
 #define MAP_HANDLE_TO_POINTER( handle )   (( PQUEUECTL )handle )
 
+/// define the macro to allocate a queue block
+#if ( QUEUESCHEDULER_ENABLE_POOL_ALLOCATOR == TRUE )
+  #define QUEUE_ALLOC( size )             PoolAllocator_Alloc( size )
+#else
+  #define QUEUE_ALLOC( size )             malloc( size )
+#endif
+
 /// define the macro foe creating events
 #define CREATE_QUEUE_EVENT( event, queue )    (( event << QUEUE_EVENT_SHIFT ) | queue )
 
@@ -91,6 +101,10 @@ typedef struct _QUEUECTL
   U8										nCount;					///< count	
 	PU8										pnStorage;			///< pointer to the queue storage
 	U8										nEnum;					///< enumeration
+	#if ( QUEUESCHEDULER_INCLUDE_ZEROCOPY == TRUE )
+	BOOL									bReserved;			///< tail slot reserved
+	BOOL									bPeeked;				///< head slot handed out by PeekSlot
+	#endif
 } QUEUECTL, *PQUEUECTL;
 #define	QUEUECTL_SIZE	sizeof( QUEUECTL )
 
@@ -138,52 +152,49 @@ PQUEUESCHEDULERHANDLE	QueueScheduler_Create( PTASKSCHEDULERHANDLE ptTask, U8 nNu
 {
   PQUEUECTL  ptNewQueue, ptCurQueue, ptLstQueue;
   
-  // allocate space for new task
-  if (( ptNewQueue = malloc( QUEUECTL_SIZE )) != NULL )
+  // allocate the control structure and the storage as one block
+  if (( ptNewQueue = QUEUE_ALLOC( QUEUECTL_SIZE + (( U32 )nNumEntries * wEntrySize ))) != NULL )
   {
-    // now allocate space for the number of entries
-    if (( ptNewQueue->pnStorage = ( PU8 )malloc( nNumEntries * wEntrySize )) != NULL )
+    // the storage follows the control structure
+    ptNewQueue->pnStorage                 = ( PU8 )( ptNewQueue + 1 );
+    
+    // now initialize the control structure
+    ptNewQueue->ptSignature               = ptNewQueue;
+    ptNewQueue->ptNextQueue               = NULL;
+    ptNewQueue->ptTask                    = ptTask;
+    ptNewQueue->tEventFlags.tBits.bEmpty  = bEmptyEnb;
+    ptNewQueue->tEventFlags.tBits.bPut		= bPutEnb;
+    ptNewQueue->tEventFlags.tBits.bGet		= bGetEnb;
+    ptNewQueue->tEventFlags.tBits.bFull		= bFullEnb;
+    ptNewQueue->nNumEntries               = nNumEntries;
+    ptNewQueue->wEntrySize                = wEntrySize;
+    ptNewQueue->nRdIdx                    = 0;
+    ptNewQueue->nWrIdx                    = 0;
+    ptNewQueue->nCount                    = 0;
+    #if ( QUEUESCHEDULER_INCLUDE_ZEROCOPY == TRUE )
+    ptNewQueue->bReserved                 = FALSE;
+    ptNewQueue->bPeeked                   = FALSE;
+    #endif
+    
+    // now insert in list
+    if ( ptFirstQueue == NULL )
     {
-			// now initialize the control structure
-			ptNewQueue->ptSignature               = ptNewQueue;
-			ptNewQueue->ptNextQueue               = NULL;
-			ptNewQueue->ptTask                    = ptTask;
-			ptNewQueue->tEventFlags.tBits.bEmpty  = bEmptyEnb;
-			ptNewQueue->tEventFlags.tBits.bPut		= bPutEnb;
-			ptNewQueue->tEventFlags.tBits.bGet		= bGetEnb;
-			ptNewQueue->tEventFlags.tBits.bFull		= bFullEnb;
-			ptNewQueue->nNumEntries               = nNumEntries;
-			ptNewQueue->wEntrySize                = wEntrySize;
-			ptNewQueue->nRdIdx                    = 0;
-			ptNewQueue->nWrIdx                    = 0;
-			ptNewQueue->nCount                    = 0;
-			
-			// now insert in list
-			if ( ptFirstQueue == NULL )
-			{
-				// add it
-				ptFirstQueue = ptNewQueue;
-				ptNewQueue->nEnum = 1;
-			}
-			else
-			{
-				// search for the entry point
-				for ( ptCurQueue = ptFirstQueue, ptLstQueue = NULL; ptCurQueue != NULL; ptLstQueue = ptCurQueue, ptCurQueue = ptCurQueue->ptNextQueue );
-
-				// check for null
-				if ( ptCurQueue == NULL )
-				{
-					// add at end
-					ptLstQueue->ptNextQueue = ptNewQueue;
-					ptNewQueue->nEnum = ptLstQueue->nEnum + 1;
-				}
-			}
-		}
+      // add it
+      ptFirstQueue = ptNewQueue;
+      ptNewQueue->nEnum = 1;
+    }
     else
     {
-      // error - not enough room
-      free( ptNewQueue );
-      ptNewQueue = NULL;
+      // search for the entry point
+      for ( ptCurQueue = ptFirstQueue, ptLstQueue = NULL; ptCurQueue != NULL; ptLstQueue = ptCurQueue, ptCurQueue = ptCurQueue->ptNextQueue );
+
+      // check for null
+      if ( ptCurQueue == NULL )
+      {
+        // add at end
+        ptLstQueue->ptNextQueue = ptNewQueue;
+        ptNewQueue->nEnum = ptLstQueue->nEnum + 1;
+      }
     }
   }
   
@@ -282,6 +293,15 @@ QUEUESTATUS QueueScheduler_PutTail( PQUEUESCHEDULERHANDLE ptQueue, PU8 pnEntry )
   // first validate that the task is valid
   if ( ptSelQueue == ptSelQueue->ptSignature )
   {
+		#if ( QUEUESCHEDULER_INCLUDE_ZEROCOPY == TRUE )
+		// a reserved slot owns the tail until it is committed
+		if ( ptSelQueue->bReserved )
+		{
+			// return the reservation busy error
+			eError = QUEUE_STATUS_RSVBSY;
+		}
+		else
+		#endif
 		// check for room
 		if ( ptSelQueue->nCount < ptSelQueue->nNumEntries )
 		{
@@ -350,6 +370,15 @@ QUEUESTATUS QueueScheduler_PutTail( PQUEUESCHEDULERHANDLE ptQueue, PU8 pnEntry )
     // first validate that the task is valid
     if ( ptSelQueue == ptSelQueue->ptSignature )
     {
+      #if ( QUEUESCHEDULER_INCLUDE_ZEROCOPY == TRUE )
+      // a reserved slot may be the last free slot, a peeked slot must stay the head
+      if (( ptSelQueue->bReserved ) || ( ptSelQueue->bPeeked ))
+      {
+        // return the reservation busy error
+        eError = QUEUE_STATUS_RSVBSY;
+      }
+      else
+      #endif
       // check for room
       if ( ptSelQueue->nCount < ptSelQueue->nNumEntries )
       {
@@ -364,8 +393,8 @@ QUEUESTATUS QueueScheduler_PutTail( PQUEUESCHEDULERHANDLE ptQueue, PU8 pnEntry )
         }
         else
         {
-          // increment the read index
-          ptSelQueue->nRdIdx++;
+          // decrement the read index
+          ptSelQueue->nRdIdx--;
         }
 			
         // now copy the data to the queue
@@ -548,6 +577,10 @@ QUEUESTATUS QueueScheduler_PutTail( PQUEUESCHEDULERHANDLE ptQueue, PU8 pnEntry )
       ptSelQueue->nWrIdx = 0;
       ptSelQueue->nRdIdx = 0;
       ptSelQueue->nCount = 0;
+      #if ( QUEUESCHEDULER_INCLUDE_ZEROCOPY == TRUE )
+      ptSelQueue->bReserved = FALSE;
+      ptSelQueue->bPeeked = FALSE;
+      #endif
     
       // re-enable interrupts
       Interrupt_Enable( );
@@ -649,6 +682,250 @@ QUEUESTATUS QueueScheduler_PutTail( PQUEUESCHEDULERHANDLE ptQueue, PU8 pnEntry )
   }
 #endif
 
+#if ( QUEUESCHEDULER_INCLUDE_ZEROCOPY == TRUE )
+  /******************************************************************************
+   * @function QueueScheduler_Reserve
+   *
+   * @brief reserve the tail slot of the queue
+   *
+   * This function will return a pointer to the next free slot so the producer
+   * can build the entry in place.  The entry is not visible to the consumer and
+   * no other put is allowed until it is committed
+   *
+   * @param[in]   ptQueue  	pointer to the queue
+   * @param[io]   ppnSlot		the pointer to store the slot pointer in
+   *
+   * @return      a QUEUESTATUS value based on results
+   *
+   *****************************************************************************/
+  QUEUESTATUS QueueScheduler_Reserve( PQUEUESCHEDULERHANDLE ptQueue, PU8* ppnSlot )
+  {
+    QUEUESTATUS   eError = QUEUE_STATUS_NONE;
+    PQUEUECTL     ptSelQueue;
+  
+    // map the pointer
+    ptSelQueue = MAP_HANDLE_TO_POINTER( ptQueue );
+  
+    // first validate that the task is valid
+    if ( ptSelQueue == ptSelQueue->ptSignature )
+    {
+      // disable interrupts
+      Interrupt_Disable( );
+      
+      // check for an outstanding reservation/room
+      if ( ptSelQueue->bReserved )
+      {
+        // return the reservation busy error
+        eError = QUEUE_STATUS_RSVBSY;
+      }
+      else if ( ptSelQueue->nCount >= ptSelQueue->nNumEntries )
+      {
+        // return the queue full error
+        eError = QUEUE_STATUS_QUEFUL;
+      }
+      else
+      {
+        // hand out the slot at the write index
+        *( ppnSlot ) = ptSelQueue->pnStorage + ( ptSelQueue->nWrIdx * ptSelQueue->wEntrySize );
+        ptSelQueue->bReserved = TRUE;
+      }
+      
+      // re-enable interrupts
+      Interrupt_Enable( );
+    }
+    else
+    {
+      // return the error
+      eError = QUEUE_STATUS_ILLQUE;
+    }
+  
+    // return the status
+    return( eError );
+  }
+
+  /******************************************************************************
+   * @function QueueScheduler_Commit
+   *
+   * @brief commit the reserved slot
+   *
+   * This function will make the reserved slot visible to the consumer and post
+   * the put events
+   *
+   * @param[in]   ptQueue  	pointer to the queue
+   *
+   * @return      a QUEUESTATUS value based on results
+   *
+   *****************************************************************************/
+  QUEUESTATUS QueueScheduler_Commit( PQUEUESCHEDULERHANDLE ptQueue )
+  {
+    QUEUESTATUS   eError = QUEUE_STATUS_NONE;
+    PQUEUECTL     ptSelQueue;
+  
+    // map the pointer
+    ptSelQueue = MAP_HANDLE_TO_POINTER( ptQueue );
+  
+    // first validate that the task is valid
+    if ( ptSelQueue == ptSelQueue->ptSignature )
+    {
+      // check for a reservation
+      if ( ptSelQueue->bReserved )
+      {
+        // disable interrupts
+        Interrupt_Disable( );
+        
+        // adjust the write index
+        ptSelQueue->nWrIdx++;
+        if ( ptSelQueue->nWrIdx >= ptSelQueue->nNumEntries )
+        {
+          // reset back to zero
+          ptSelQueue->nWrIdx = 0;
+        }
+        
+        // increment the count/clear the reservation
+        ptSelQueue->nCount++;
+        ptSelQueue->bReserved = FALSE;
+        
+        // re-enable interrupts
+        Interrupt_Enable( );
+        
+        // now post event
+        PostEvent( ptSelQueue, FALSE );
+      }
+      else
+      {
+        // nothing to commit
+        eError = QUEUE_STATUS_ILLOPR;
+      }
+    }
+    else
+    {
+      // return the error
+      eError = QUEUE_STATUS_ILLQUE;
+    }
+  
+    // return the status
+    return( eError );
+  }
+
+  /******************************************************************************
+   * @function QueueScheduler_PeekSlot
+   *
+   * @brief get a pointer to the head entry of the queue
+   *
+   * This function will return a pointer to the head entry so the consumer can
+   * parse it in place.  The entry remains valid until it is released
+   *
+   * @param[in]   ptQueue  	pointer to the queue
+   * @param[io]   ppnSlot		the pointer to store the slot pointer in
+   *
+   * @return      a QUEUESTATUS value based on results
+   *
+   *****************************************************************************/
+  QUEUESTATUS QueueScheduler_PeekSlot( PQUEUESCHEDULERHANDLE ptQueue, PU8* ppnSlot )
+  {
+    QUEUESTATUS   eError = QUEUE_STATUS_NONE;
+    PQUEUECTL     ptSelQueue;
+  
+    // map the pointer
+    ptSelQueue = MAP_HANDLE_TO_POINTER( ptQueue );
+  
+    // first validate that the task is valid
+    if ( ptSelQueue == ptSelQueue->ptSignature )
+    {
+      // is there anything in the queue
+      if ( ptSelQueue->nCount != 0 )
+      {
+        // hand out the slot at the read index
+        *( ppnSlot ) = ptSelQueue->pnStorage + ( ptSelQueue->nRdIdx * ptSelQueue->wEntrySize );
+        ptSelQueue->bPeeked = TRUE;
+      }
+      else
+      {
+        // return the queue empty error
+        eError = QUEUE_STATUS_QUEEMP;
+      }
+    }
+    else
+    {
+      // return the error
+      eError = QUEUE_STATUS_ILLQUE;
+    }
+  
+    // return the status
+    return( eError );
+  }
+
+  /******************************************************************************
+   * @function QueueScheduler_Release
+   *
+   * @brief release the head entry of the queue
+   *
+   * This function will remove the entry returned by PeekSlot and post the get
+   * events, it is illegal without an outstanding PeekSlot
+   *
+   * @param[in]   ptQueue  	pointer to the queue
+   *
+   * @return      a QUEUESTATUS value based on results
+   *
+   *****************************************************************************/
+  QUEUESTATUS QueueScheduler_Release( PQUEUESCHEDULERHANDLE ptQueue )
+  {
+    QUEUESTATUS   eError = QUEUE_STATUS_NONE;
+    PQUEUECTL     ptSelQueue;
+  
+    // map the pointer
+    ptSelQueue = MAP_HANDLE_TO_POINTER( ptQueue );
+  
+    // first validate that the task is valid
+    if ( ptSelQueue == ptSelQueue->ptSignature )
+    {
+      // a slot must have been peeked
+      if ( !ptSelQueue->bPeeked )
+      {
+        // return the illegal operation error
+        eError = QUEUE_STATUS_ILLOPR;
+      }
+      // is there anything in the queue
+      else if ( ptSelQueue->nCount != 0 )
+      {
+        // disable interrupts
+        Interrupt_Disable( );
+      
+        // adjust the read index
+        ptSelQueue->nRdIdx++;
+        if ( ptSelQueue->nRdIdx >= ptSelQueue->nNumEntries )
+        {
+          // reset back to zero
+          ptSelQueue->nRdIdx = 0;
+        }
+      
+        // decrement  the count/the peeked slot is gone
+        ptSelQueue->nCount--;
+        ptSelQueue->bPeeked = FALSE;
+      
+        // re-enable interrupts
+        Interrupt_Enable( );
+			
+        // now post event
+        PostEvent( ptSelQueue, TRUE );
+      }
+      else
+      {
+        // return the queue empty error
+        eError = QUEUE_STATUS_QUEEMP;
+      }
+    }
+    else
+    {
+      // return the error
+      eError = QUEUE_STATUS_ILLQUE;
+    }
+  
+    // return the status
+    return( eError );
+  }
+#endif
+
 /******************************************************************************
  * @function PostEvent
  *
@@ -696,13 +973,13 @@ static void	PostEvent( PQUEUECTL ptQueue, BOOL bForceGet )
 			// or the empty event
 			nEvent = QUEUE_EVENT_PUTFULL;
 		}
-		
-		// check if event is present
-		if ( nEvent != 0 )
-		{
-			// post the event
-			TaskScheduler_PostEvent( ptQueue->ptTask, ( TASKSCHEDULEREVENT )CREATE_QUEUE_EVENT( nEvent, ptQueue->nEnum ));
-		}
+	}
+	
+	// check if event is present
+	if ( nEvent != 0 )
+	{
+		// post the event
+		TaskScheduler_PostEvent( ptQueue->ptTask, ( TASKSCHEDULEREVENT )CREATE_QUEUE_EVENT( nEvent, ptQueue->nEnum ));
 	}
 }
 
@@ -43,6 +43,8 @@ typedef enum _QUEUESTATUS
   QUEUE_STATUS_ILLQUE,       // illegal queue
   QUEUE_STATUS_QUEFUL,       // queue full
   QUEUE_STATUS_QUEEMP,       // queue empty
+  QUEUE_STATUS_ILLOPR,       // illegal operation for this queue state
+  QUEUE_STATUS_RSVBSY,       // a reserved slot is waiting to be committed or a peeked slot released
 } QUEUESTATUS;
 
 /// enumerate the queue events
@@ -83,6 +85,12 @@ extern  QUEUESTATUS 					QueueScheduler_PutTail( PQUEUESCHEDULERHANDLE ptQueue,
 #if ( QUEUESCHEDULER_INCLUDE_GETSTATUS == TRUE )
   extern  QUEUESTATUS 					QueueScheduler_GetStatus( PQUEUESCHEDULERHANDLE ptQueue );  
 #endif
+#if ( QUEUESCHEDULER_INCLUDE_ZEROCOPY == TRUE )
+  extern  QUEUESTATUS 					QueueScheduler_Reserve( PQUEUESCHEDULERHANDLE ptQueue, PU8* ppnSlot );
+  extern  QUEUESTATUS 					QueueScheduler_Commit( PQUEUESCHEDULERHANDLE ptQueue );
+  extern  QUEUESTATUS 					QueueScheduler_PeekSlot( PQUEUESCHEDULERHANDLE ptQueue, PU8* ppnSlot );
+  extern  QUEUESTATUS 					QueueScheduler_Release( PQUEUESCHEDULERHANDLE ptQueue );
+#endif
 
 /**@} EOF QueueScheduler.h */
 
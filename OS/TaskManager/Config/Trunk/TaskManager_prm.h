@@ -40,6 +40,12 @@
 
 /// define the macro to disable tick task processing 
 #define TASK_DISABLE_TICK_PROCESSING      ( 0 )
+
+/// define the macro to enable the ready task bitmap - set to 1 to enable
+#define TASK_ENABLE_READY_BITMAP          ( 0 )
+
+/// define the macro to enable the timer delta list - set to 1 to enable
+#define TASK_ENABLE_TIMER_DELTALIST       ( 0 )
  
 /**@} EOF TaskManager_prm.h */
 
@@ -31,6 +31,25 @@
 #include "SystemTick/SystemTick.h"
 
 // Macros and Defines ---------------------------------------------------------
+#if ( TASK_ENABLE_READY_BITMAP == 1 )
+/// define the number of bits per ready map word
+#define READYMAP_BITS_PER_WORD          ( 32 )
+
+/// define the number of words in the ready map
+#define READYMAP_NUM_WORDS              (( TASK_SCHD_MAX + READYMAP_BITS_PER_WORD - 1 ) / READYMAP_BITS_PER_WORD )
+
+/// define the macros to set/clear a task in the ready map
+#define READYMAP_SET( idx )             ( auReadyMap[ ( idx ) / READYMAP_BITS_PER_WORD ] |= ( 1ul << (( idx ) % READYMAP_BITS_PER_WORD )))
+#define READYMAP_CLR( idx )             ( auReadyMap[ ( idx ) / READYMAP_BITS_PER_WORD ] &= ~( 1ul << (( idx ) % READYMAP_BITS_PER_WORD )))
+
+/// define the count trailing zeros macro
+#if defined( __GNUC__ )
+#define READYMAP_CTZ( mask )            (( U8 )__builtin_ctzl( mask ))
+#else
+#define READYMAP_CTZ( mask )            ( CountTrailingZeros( mask ))
+#endif // __GNUC__
+#endif // TASK_ENABLE_READY_BITMAP
+
 
 // enumerations ---------------------------------------------------------------
 
@@ -39,7 +58,7 @@
 typedef struct  _SCHDTASKCTL
 {
   U32         uDelayTime;       ///< current delay time
-  U32         uDelayCount;      ///< delay count
+  U32         uDelayCount;      ///< delay count, delta to previous timer if linked
   QUESIZEARG  xRdIdx;           ///< event buffer read index
   QUESIZEARG  xWrIdx;           ///< event buffer write index
   QUESIZEARG  xEvnCount;        ///< event count
@@ -48,6 +67,10 @@ typedef struct  _SCHDTASKCTL
   U8          nPriEvnCount;     ///< priority event count
   BOOL        bDelayInProgress; ///< delay in progress
   BOOL        bEnabled;         ///< task enabled
+  #if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+  U8          nTimerNext;       ///< next timer in the delta list
+  BOOL        bTimerLinked;     ///< timer is in the delta list
+  #endif // TASK_ENABLE_TIMER_DELTALIST
   TASKARG axPriEvents[ TASK_MAXNUM_PRI_EVENTS ];
 } SCHDTASKCTL, *PSCHDTASKCTL;
 #define SCHDTASKCTL_SIZE  sizeof( SCHDTASKCTL );
@@ -74,10 +97,24 @@ static  VBOOL       bProcessTickFlag;
 #endif // TASK_DISABLE_TICK_PROCESSING
 static  U16         wNrmEventCount;
 static  U16         wPriEventCount;
+#if ( TASK_ENABLE_READY_BITMAP == 1 )
+static  VU32        auReadyMap[ READYMAP_NUM_WORDS ];
+#endif // TASK_ENABLE_READY_BITMAP
+#if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+static  U8          nTimerHead;
+#endif // TASK_ENABLE_TIMER_DELTALIST
 
 // local function prototypes --------------------------------------------------
 static  BOOL  PutPriorityEvent( PSCHDTASKCTL ptCtl, TASKARG xArg );
 static  void  ProcessTick( void );
+static  void  ExecuteTask( U8 nIdx );
+#if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+static  void  TimerInsert( U8 nIdx, U32 uTicks );
+static  U32   TimerRemove( U8 nIdx );
+#endif // TASK_ENABLE_TIMER_DELTALIST
+#if ( TASK_ENABLE_READY_BITMAP == 1 ) && !defined( __GNUC__ )
+static  U8    CountTrailingZeros( U32 uMask );
+#endif // TASK_ENABLE_READY_BITMAP
 
 /******************************************************************************
  * @function TaskManager_Initialize
@@ -100,6 +137,16 @@ void TaskManager_Initialize( void )
   // clear the  evente count
   wNrmEventCount = wPriEventCount = 0;
 
+  #if ( TASK_ENABLE_READY_BITMAP == 1 )
+  // clear the ready map
+  memset(( PVOID )auReadyMap, 0, sizeof( auReadyMap ));
+  #endif // TASK_ENABLE_READY_BITMAP
+
+  #if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+  // clear the timer list
+  nTimerHead = TASK_SCHD_ILLEGAL;
+  #endif // TASK_ENABLE_TIMER_DELTALIST
+
   #if ( TASK_DISABLE_TICK_PROCESSING == 1 )
   // just clear tick flag
   bProcessTickFlag = FALSE;
@@ -133,6 +180,15 @@ void TaskManager_Initialize( void )
         break;
     }
     
+    #if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+    // add the timer to the list if running
+    ptSchdCtl->bTimerLinked = FALSE;
+    if (( ptSchdCtl->bDelayInProgress ) && ( ptSchdCtl->bEnabled ))
+    {
+      TimerInsert( nIdx, ptSchdCtl->uDelayCount );
+    }
+    #endif // TASK_ENABLE_TIMER_DELTALIST
+    
     // check for init
     if ( PGM_RDBYTE( ptSchdDef->bRunOnInit ))
     {
@@ -166,18 +222,17 @@ void TaskManager_Initialize( void )
  * @brief this the idle loop for processing all scheduled tasks
  *
  * This function loops through all tasks and well execute those that have
- * and event count not equal to 0
+ * and event count not equal to 0.  If the ready bitmap is enabled, only the
+ * tasks that have an event pending are visited
  *
  *****************************************************************************/
 void TaskManager_IdleProcess( void )
 {
   U8            nIdx;
-  PVEXECFUNC    pvExec;
-  PTASKARG	pxEvents;
-  PSCHDTASKCTL	ptSchdCtl;
-  PTASKSCHDDEF	ptSchdDef;
-  TASKARG	xArg;
-  BOOL          bPriEvent;
+  #if ( TASK_ENABLE_READY_BITMAP == 1 )
+  U8            nWord;
+  U32           uMask;
+  #endif // TASK_ENABLE_READY_BITMAP
   
   #if ( TASK_DISABLE_TICK_PROCESSING == 1 )
   // normal process of the tick task
@@ -188,70 +243,34 @@ void TaskManager_IdleProcess( void )
   }
   #endif // TASK_DISABLE_TICK_PROCESSING
   
-  // for each entry in the task list
-  for ( nIdx = 0; nIdx < TASK_SCHD_MAX; nIdx++ )
+  #if ( TASK_ENABLE_READY_BITMAP == 1 )
+  // for each word in the ready map
+  for ( nWord = 0; nWord < READYMAP_NUM_WORDS; nWord++ )
   {
-    // get the pointers
-    ptSchdCtl = ( PSCHDTASKCTL )&atSchdCtls[ nIdx ];
-    ptSchdDef = ( PTASKSCHDDEF )&g_atTaskSchdDefs[ nIdx ];
+    // get a snapshot of the ready tasks
+    Interrupt_Disable( );
+    uMask = auReadyMap[ nWord ];
+    Interrupt_Enable( );
 
-    // determine if this task is enabled
-    if ( ptSchdCtl->bEnabled )
+    // for each ready task in this word
+    while ( uMask != 0 )
     {
-      // get the task execution function
-      pvExec = ( PVOID )PGM_RDWORD( ptSchdDef->pvExec );
-      
-      if (( ptSchdCtl->xEvnCount != 0 ) || ( ptSchdCtl->nPriEvnCount != 0 ))
-      {
-        // determine if we have any priority events
-        if ( ptSchdCtl->nPriEvnCount != 0 )
-        {
-          // get tht priority event
-          xArg = ptSchdCtl->axPriEvents[ ptSchdCtl->nPriRdIdx ];
-          
-          // set the priority event flag
-          bPriEvent = TRUE;
-        }
-        else
-        {
-          // get the event          
-          pxEvents = ( PTASKARG )PGM_RDWORD( ptSchdDef->pxEvents );
-          xArg = *( pxEvents + ptSchdCtl->xRdIdx );
-          
-          // clear the priority event flag
-          bPriEvent = FALSE;
-        }
-      
-        // execute the task
-        if ( pvExec( xArg ))
-        {
-          // disable interrupts
-          Interrupt_Disable( );
-          
-          // determine if this was a priority event
-          if ( bPriEvent == TRUE )
-          {
-            // decrement the priority event count/adjust read index
-            ptSchdCtl->nPriEvnCount--;
-            ptSchdCtl->nPriRdIdx++;
-            ptSchdCtl->nPriRdIdx %= TASK_MAXNUM_PRI_EVENTS;
-            wPriEventCount--;
-          }
-          else
-          {
-            // decrement the event count/adjust read index
-            ptSchdCtl->xEvnCount--;
-            ptSchdCtl->xRdIdx++;
-            ptSchdCtl->xRdIdx %= GETQUEUESIZE( ptSchdDef->xNumEvents );
-            wNrmEventCount--;
-          }
-          
-          // re-enable interrupts
-          Interrupt_Enable( );
-        }
-      }
+      // get the index of the lowest ready task/remove it from the mask
+      nIdx = ( nWord * READYMAP_BITS_PER_WORD ) + READYMAP_CTZ( uMask );
+      uMask &= ( uMask - 1 );
+
+      // execute it
+      ExecuteTask( nIdx );
     }
   }
+  #else
+  // for each entry in the task list
+  for ( nIdx = 0; nIdx < TASK_SCHD_MAX; nIdx++ )
+  {
+    // execute it
+    ExecuteTask( nIdx );
+  }
+  #endif // TASK_ENABLE_READY_BITMAP
 }
 
 /******************************************************************************
@@ -321,11 +340,46 @@ BOOL TaskManager_EnableDisable( TASKSCHDENUMS eTask, BOOL bState )
 {
   BOOL bStatus = FALSE;
   
+  #if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+  PSCHDTASKCTL  ptSchdCtl;
+  #endif // TASK_ENABLE_TIMER_DELTALIST
+  
   // valid task
   if ( eTask < TASK_SCHD_MAX )
   {
-    // set the enable flag/indicate good status
+    #if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+    // get a pointer to the control
+    ptSchdCtl = ( PSCHDTASKCTL )&atSchdCtls[ eTask ];
+    
+    // disable interrupts
+    Interrupt_Disable( );
+    
+    // check for a state change with a timer running
+    if (( ptSchdCtl->bEnabled != bState ) && ( ptSchdCtl->bDelayInProgress ))
+    {
+      if ( bState )
+      {
+        // resume the timer with the remaining time
+        TimerInsert( eTask, ptSchdCtl->uDelayCount );
+      }
+      else
+      {
+        // suspend the timer/save the remaining time
+        ptSchdCtl->uDelayCount = TimerRemove( eTask );
+      }
+    }
+    
+    // set the enable flag
+    ptSchdCtl->bEnabled = bState;
+    
+    // re-enable interrupts
+    Interrupt_Enable( );
+    #else
+    // set the enable flag
     atSchdCtls[ eTask ].bEnabled = bState;
+    #endif // TASK_ENABLE_TIMER_DELTALIST
+    
+    // indicate good status
     bStatus = TRUE;
   }
   
@@ -417,6 +471,11 @@ BOOL TaskManager_PostEvent( TASKSCHDENUMS eTask, TASKARG xArg )
         // increment event count
         wNrmEventCount++;
         
+        #if ( TASK_ENABLE_READY_BITMAP == 1 )
+        // flag the task as ready
+        READYMAP_SET( eTask );
+        #endif // TASK_ENABLE_READY_BITMAP
+
         // set good status
         bStatus = TRUE;
       }
@@ -526,6 +585,11 @@ BOOL TaskManager_PostEventIrq( TASKSCHDENUMS eTask, TASKARG xArg )
         // increment event count
         wNrmEventCount++;
         
+        #if ( TASK_ENABLE_READY_BITMAP == 1 )
+        // flag the task as ready
+        READYMAP_SET( eTask );
+        #endif // TASK_ENABLE_READY_BITMAP
+
         // set good status
         bStatus = TRUE;
       }
@@ -607,6 +671,11 @@ BOOL TaskManager_FlushEvents( TASKSCHDENUMS eTask )
     wNrmEventCount -= ptSchdCtl->xEvnCount;
     wPriEventCount -= ptSchdCtl->nPriEvnCount;
     
+    #if ( TASK_ENABLE_READY_BITMAP == 1 )
+    // remove the task from the ready map
+    READYMAP_CLR( eTask );
+    #endif // TASK_ENABLE_READY_BITMAP
+    
     // stuff it/reset count/reset indices
     ptSchdCtl->xEvnCount = 0;
     ptSchdCtl->xWrIdx = 0;
@@ -653,6 +722,11 @@ BOOL TaskManager_StartTimer( TASKSCHDENUMS eTask, U32 uTime )
     // disable interrupts
     Interrupt_Disable( );
     
+    #if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+    // remove the timer if already running
+    TimerRemove( eTask );
+    #endif // TASK_ENABLE_TIMER_DELTALIST
+    
     // stuff it/reset count/reset indices
     if ( uTime != 0 )
     {
@@ -662,6 +736,14 @@ BOOL TaskManager_StartTimer( TASKSCHDENUMS eTask, U32 uTime )
     ptSchdCtl->uDelayCount = ptSchdCtl->uDelayTime;
     ptSchdCtl->bDelayInProgress = TRUE;
     
+    #if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+    // add the timer to the list if the task is enabled
+    if ( ptSchdCtl->bEnabled )
+    {
+      TimerInsert( eTask, ptSchdCtl->uDelayCount );
+    }
+    #endif // TASK_ENABLE_TIMER_DELTALIST
+    
     // re-enable interrupts
     Interrupt_Enable( );
       
@@ -702,6 +784,11 @@ BOOL TaskManager_StopTimer( TASKSCHDENUMS eTask )
     // clear the delay in progress
     ptSchdCtl->bDelayInProgress = FALSE;
     
+    #if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+    // remove the timer from the list
+    TimerRemove( eTask );
+    #endif // TASK_ENABLE_TIMER_DELTALIST
+    
     // re-enable interrupts
     Interrupt_Enable( );
       
@@ -737,18 +824,82 @@ BOOL TaskManager_CheckTasksPending( TASKSCHDENUMS eTask )
     ptSchdCtl = ( PSCHDTASKCTL )&atSchdCtls[ eTask ];
     
     // set the result
-    bPending = (( ptSchdCtl->nPriEvnCount == 0 ) && ( ptSchdCtl->xEvnCount )) ? TRUE : FALSE;
+    bPending = (( ptSchdCtl->nPriEvnCount != 0 ) || ( ptSchdCtl->xEvnCount != 0 )) ? TRUE : FALSE;
   }
   else
   {
     // check the event counts
-    bPending = (( wPriEventCount == 0 ) && ( wNrmEventCount == 0 )) ? TRUE : FALSE;
+    bPending = (( wPriEventCount != 0 ) || ( wNrmEventCount != 0 )) ? TRUE : FALSE;
   }
 
   // return the pending status
   return( bPending );
 }
 
+/******************************************************************************
+ * @function TaskManager_GetNextTimeout
+ *
+ * @brief get the time to the next timer expiration
+ *
+ * This function will return the number of ticks until the next running timer
+ * expires, used by tickless idle to program the next wakeup
+ *
+ * @return      number of ticks, TASK_NEXTTIMEOUT_NONE if no timers running
+ *
+ *****************************************************************************/
+U32 TaskManager_GetNextTimeout( void )
+{
+  U32           uTicks = TASK_NEXTTIMEOUT_NONE;
+  #if ( TASK_ENABLE_TIMER_DELTALIST == 0 ) || ( TASK_TICK_ENABLE == 1 )
+  U8            nIdx;
+  #endif
+  #if ( TASK_ENABLE_TIMER_DELTALIST == 0 )
+  PSCHDTASKCTL  ptSchdCtl;
+  #endif // TASK_ENABLE_TIMER_DELTALIST
+  
+  // disable interrupts
+  Interrupt_Disable( );
+  
+  #if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+  // the head of the list is the next to expire
+  if ( nTimerHead != TASK_SCHD_ILLEGAL )
+  {
+    uTicks = atSchdCtls[ nTimerHead ].uDelayCount;
+  }
+  #else
+  // for each entry in the scheduled task list
+  for ( nIdx = 0; nIdx < TASK_SCHD_MAX; nIdx++ )
+  {
+    // get the pointer
+    ptSchdCtl = ( PSCHDTASKCTL )&atSchdCtls[ nIdx ];
+    
+    // check for a running timer
+    if (( ptSchdCtl->bDelayInProgress ) && ( ptSchdCtl->bEnabled ) && ( ptSchdCtl->uDelayCount != 0 ))
+    {
+      uTicks = MIN( uTicks, ptSchdCtl->uDelayCount );
+    }
+  }
+  #endif // TASK_ENABLE_TIMER_DELTALIST
+  
+  #if ( TASK_TICK_ENABLE == 1 )
+  // for each entry in the tick task list
+  for ( nIdx = 0; nIdx < TASK_TICK_MAX; nIdx++ )
+  {
+    // check for enabled
+    if ( atTickCtls[ nIdx ].bEnabled )
+    {
+      uTicks = MIN( uTicks, atTickCtls[ nIdx ].uDelayCount );
+    }
+  }
+  #endif  // TASK_TICK_ENABLE
+  
+  // re-enable interrupts
+  Interrupt_Enable( );
+  
+  // return the ticks
+  return( uTicks );
+}
+
 /******************************************************************************
  * @function PutPriorityEvent
  *
@@ -777,6 +928,11 @@ static BOOL PutPriorityEvent( PSCHDTASKCTL ptCtl, TASKARG xArg )
     // increment priority event count
     wPriEventCount++;
     
+    #if ( TASK_ENABLE_READY_BITMAP == 1 )
+    // flag the task as ready
+    READYMAP_SET( ptCtl - atSchdCtls );
+    #endif // TASK_ENABLE_READY_BITMAP
+    
     // set good status
     bStatus = TRUE;
   }
@@ -790,7 +946,9 @@ static BOOL PutPriorityEvent( PSCHDTASKCTL ptCtl, TASKARG xArg )
  *
  * @brief process a tick task
  *
- * This function performs the processing of every task for time change
+ * This function performs the processing of every task for time change.  If
+ * the timer delta list is enabled, only the head of the list is decremented
+ * and the timers that have expired are removed
  *
  *****************************************************************************/
 static void ProcessTick( void )
@@ -805,6 +963,47 @@ static void ProcessTick( void )
   bProcessTickFlag = FALSE;
   #endif // TASK_DISABLE_TICK_PROCESSING
   
+  #if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+  // check for any timers running
+  if ( nTimerHead != TASK_SCHD_ILLEGAL )
+  {
+    // decrement the head of the list
+    ptSchdCtl = ( PSCHDTASKCTL )&atSchdCtls[ nTimerHead ];
+    if ( ptSchdCtl->uDelayCount != 0 )
+    {
+      ptSchdCtl->uDelayCount--;
+    }
+    
+    // now process all expired timers
+    while (( nTimerHead != TASK_SCHD_ILLEGAL ) && ( atSchdCtls[ nTimerHead ].uDelayCount == 0 ))
+    {
+      // get the pointers/unlink it
+      nIdx = nTimerHead;
+      ptSchdCtl = ( PSCHDTASKCTL )&atSchdCtls[ nIdx ];
+      ptSchdDef = ( PTASKSCHDDEF )&g_atTaskSchdDefs[ nIdx ];
+      nTimerHead = ptSchdCtl->nTimerNext;
+      ptSchdCtl->bTimerLinked = FALSE;
+      
+      // put a prioirty event
+      PutPriorityEvent( ptSchdCtl, TASK_TIMEOUT_EVENT );
+      
+      // get the task type
+      eType = PGM_RDBYTE( ptSchdDef->eType );
+      
+      // determine if this is a one shot or continuous timer
+      if ( eType == TASK_TYPE_TIMED_CONTINUOUS )
+      {
+        // reload the time
+        TimerInsert( nIdx, ptSchdCtl->uDelayTime );
+      }
+      else
+      {
+        // clear the delay in progress flag
+        ptSchdCtl->bDelayInProgress = FALSE;
+      }
+    }
+  }
+  #else
   // for each entry in the scheduled task list
   for ( nIdx = 0; nIdx < TASK_SCHD_MAX; nIdx++ )
   {
@@ -842,6 +1041,244 @@ static void ProcessTick( void )
       }
     }
   }
+  #endif // TASK_ENABLE_TIMER_DELTALIST
+}
+
+/******************************************************************************
+ * @function ExecuteTask
+ *
+ * @brief execute a task
+ *
+ * This function will execute a task with the next available event, priority
+ * events first, and remove the event if the task consumed it
+ *
+ * @param[in]   nIdx    task index
+ *
+ *****************************************************************************/
+static void ExecuteTask( U8 nIdx )
+{
+  PVEXECFUNC    pvExec;
+  PTASKARG      pxEvents;
+  PSCHDTASKCTL  ptSchdCtl;
+  PTASKSCHDDEF  ptSchdDef;
+  TASKARG       xArg;
+  BOOL          bPriEvent;
+
+  // get the pointers
+  ptSchdCtl = ( PSCHDTASKCTL )&atSchdCtls[ nIdx ];
+  ptSchdDef = ( PTASKSCHDDEF )&g_atTaskSchdDefs[ nIdx ];
+
+  // determine if this task is enabled
+  if ( ptSchdCtl->bEnabled )
+  {
+    if (( ptSchdCtl->xEvnCount != 0 ) || ( ptSchdCtl->nPriEvnCount != 0 ))
+    {
+      // get the task execution function
+      pvExec = ( PVOID )PGM_RDWORD( ptSchdDef->pvExec );
+      
+      // determine if we have any priority events
+      if ( ptSchdCtl->nPriEvnCount != 0 )
+      {
+        // get tht priority event
+        xArg = ptSchdCtl->axPriEvents[ ptSchdCtl->nPriRdIdx ];
+        
+        // set the priority event flag
+        bPriEvent = TRUE;
+      }
+      else
+      {
+        // get the event          
+        pxEvents = ( PTASKARG )PGM_RDWORD( ptSchdDef->pxEvents );
+        xArg = *( pxEvents + ptSchdCtl->xRdIdx );
+        
+        // clear the priority event flag
+        bPriEvent = FALSE;
+      }
+    
+      // execute the task
+      if ( pvExec( xArg ))
+      {
+        // disable interrupts
+        Interrupt_Disable( );
+        
+        // determine if this was a priority event
+        if ( bPriEvent == TRUE )
+        {
+          // decrement the priority event count/adjust read index
+          ptSchdCtl->nPriEvnCount--;
+          ptSchdCtl->nPriRdIdx++;
+          ptSchdCtl->nPriRdIdx %= TASK_MAXNUM_PRI_EVENTS;
+          wPriEventCount--;
+        }
+        else
+        {
+          // decrement the event count/adjust read index
+          ptSchdCtl->xEvnCount--;
+          ptSchdCtl->xRdIdx++;
+          ptSchdCtl->xRdIdx %= GETQUEUESIZE( ptSchdDef->xNumEvents );
+          wNrmEventCount--;
+        }
+        
+        #if ( TASK_ENABLE_READY_BITMAP == 1 )
+        // if no more events, remove the task from the ready map
+        if (( ptSchdCtl->xEvnCount == 0 ) && ( ptSchdCtl->nPriEvnCount == 0 ))
+        {
+          READYMAP_CLR( nIdx );
+        }
+        #endif // TASK_ENABLE_READY_BITMAP
+        
+        // re-enable interrupts
+        Interrupt_Enable( );
+      }
+    }
+  }
+}
+
+#if ( TASK_ENABLE_TIMER_DELTALIST == 1 )
+/******************************************************************************
+ * @function TimerInsert
+ *
+ * @brief insert a timer into the delta list
+ *
+ * This function will insert the task's timer into the list sorted by
+ * expiration, storing the time relative to the previous timer.  A zero time
+ * is never inserted, to match a timer that never expires
+ *
+ * @param[in]   nIdx    task index
+ * @param[in]   uTicks  number of ticks until expiration
+ *
+ *****************************************************************************/
+static void TimerInsert( U8 nIdx, U32 uTicks )
+{
+  PSCHDTASKCTL  ptSchdCtl;
+  U8            nCur, nLst;
+  
+  // only insert a valid time
+  if ( uTicks != 0 )
+  {
+    // search for the entry point, adjusting the time as we go
+    for ( nCur = nTimerHead, nLst = TASK_SCHD_ILLEGAL; ( nCur != TASK_SCHD_ILLEGAL ) && ( uTicks >= atSchdCtls[ nCur ].uDelayCount ); nLst = nCur, nCur = atSchdCtls[ nCur ].nTimerNext )
+    {
+      uTicks -= atSchdCtls[ nCur ].uDelayCount;
+    }
+    
+    // set the delta/link it
+    ptSchdCtl = ( PSCHDTASKCTL )&atSchdCtls[ nIdx ];
+    ptSchdCtl->uDelayCount = uTicks;
+    ptSchdCtl->nTimerNext = nCur;
+    ptSchdCtl->bTimerLinked = TRUE;
+    
+    // adjust the following timer
+    if ( nCur != TASK_SCHD_ILLEGAL )
+    {
+      atSchdCtls[ nCur ].uDelayCount -= uTicks;
+    }
+    
+    // now update the previous
+    if ( nLst == TASK_SCHD_ILLEGAL )
+    {
+      // new head
+      nTimerHead = nIdx;
+    }
+    else
+    {
+      // add after last
+      atSchdCtls[ nLst ].nTimerNext = nIdx;
+    }
+  }
+}
+
+/******************************************************************************
+ * @function TimerRemove
+ *
+ * @brief remove a timer from the delta list
+ *
+ * This function will remove the task's timer from the list if linked and add
+ * its delta to the following timer
+ *
+ * @param[in]   nIdx    task index
+ *
+ * @return      the number of ticks that were remaining
+ *
+ *****************************************************************************/
+static U32 TimerRemove( U8 nIdx )
+{
+  PSCHDTASKCTL  ptSchdCtl;
+  U8            nCur, nLst;
+  U32           uRemaining = 0;
+  
+  // get the pointer
+  ptSchdCtl = ( PSCHDTASKCTL )&atSchdCtls[ nIdx ];
+  
+  // only remove if linked
+  if ( ptSchdCtl->bTimerLinked )
+  {
+    // search for the timer, accumulating the time
+    for ( nCur = nTimerHead, nLst = TASK_SCHD_ILLEGAL; ( nCur != TASK_SCHD_ILLEGAL ) && ( nCur != nIdx ); nLst = nCur, nCur = atSchdCtls[ nCur ].nTimerNext )
+    {
+      uRemaining += atSchdCtls[ nCur ].uDelayCount;
+    }
+    uRemaining += ptSchdCtl->uDelayCount;
+    
+    // give our time to the following timer
+    if ( ptSchdCtl->nTimerNext != TASK_SCHD_ILLEGAL )
+    {
+      atSchdCtls[ ptSchdCtl->nTimerNext ].uDelayCount += ptSchdCtl->uDelayCount;
+    }
+    
+    // unlink it
+    if ( nLst == TASK_SCHD_ILLEGAL )
+    {
+      // was the head
+      nTimerHead = ptSchdCtl->nTimerNext;
+    }
+    else
+    {
+      // remove from the middle
+      atSchdCtls[ nLst ].nTimerNext = ptSchdCtl->nTimerNext;
+    }
+    ptSchdCtl->bTimerLinked = FALSE;
+  }
+  
+  // return the remaining time
+  return( uRemaining );
+}
+#endif // TASK_ENABLE_TIMER_DELTALIST
+
+#if ( TASK_ENABLE_READY_BITMAP == 1 ) && !defined( __GNUC__ )
+/******************************************************************************
+ * @function CountTrailingZeros
+ *
+ * @brief count the trailing zeros
+ *
+ * This function returns the index of the lowest set bit in the mask
+ *
+ * @param[in]   uMask   mask, must be non-zero
+ *
+ * @return      index of the lowest set bit
+ *
+ *****************************************************************************/
+static U8 CountTrailingZeros( U32 uMask )
+{
+  U8  nCount = 0;
+
+  // skip the zero bytes
+  while (( uMask & 0xFF ) == 0 )
+  {
+    uMask >>= 8;
+    nCount += 8;
+  }
+
+  // now count the bits
+  while (( uMask & 0x01 ) == 0 )
+  {
+    uMask >>= 1;
+    nCount++;
+  }
+
+  // return the count
+  return( nCount );
 }
+#endif // TASK_ENABLE_READY_BITMAP
 
 /**@} EOF .c */
@@ -29,6 +29,8 @@
 #include "TaskManager/TaskManager_cfg.h"
 
 // Macros and Defines ---------------------------------------------------------
+/// define the value returned when no timers are running
+#define TASK_NEXTTIMEOUT_NONE   ( 0xFFFFFFFF )
 
 // global function prototypes --------------------------------------------------
 extern 	void  TaskManager_Initialize( void );
@@ -43,6 +45,7 @@ extern	BOOL  TaskManager_FlushEvents( TASKSCHDENUMS eTask );
 extern	BOOL  TaskManager_StartTimer( TASKSCHDENUMS eTask, U32 uTime );
 extern	BOOL  TaskManager_StopTimer( TASKSCHDENUMS eTask );
 extern  BOOL  TaskManager_CheckTasksPending( TASKSCHDENUMS eTask );
+extern  U32   TaskManager_GetNextTimeout( void );
 #if ( TASK_TICK_ENABLE == 1 )
 extern  BOOL  TaskManager_TickEnableDisable( TASKTICKENUMS eTask, BOOL bState );
 #endif  // TASK_TICK_ENABLE
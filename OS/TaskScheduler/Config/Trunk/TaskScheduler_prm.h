@@ -32,6 +32,30 @@
 /// define the macro to enable large event queues
 #define TASKSCHEDULER_ENABLE_LARGE_EVENT_QUEUES   ( 0 )
 
+/// define the macro to enable the timer delta list - set to 1 to enable
+#define TASKSCHEDULER_ENABLE_TIMER_DELTALIST      ( 0 )
+
+/// define the macro to enable strict priority dispatch - set to 1 to enable
+#define TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH    ( 0 )
+
+/// define the number of priority levels ( 1-32 ), higher priorities map to the last level
+#define TASKSCHEDULER_NUM_PRIORITY_LEVELS         ( 8 )
+
+/// define the last priority level that can drain multiple events per dispatch
+#define TASKSCHEDULER_DRAIN_PRIORITY_LEVEL        ( 0 )
+
+/// define the maximum number of events drained per dispatch
+#define TASKSCHEDULER_DRAIN_MAX_EVENTS            ( 4 )
+
+/// define the macro to allocate tasks from the pool allocator - set to 1 to enable
+#define TASKSCHEDULER_ENABLE_POOL_ALLOCATOR       ( 0 )
+
+/// define the macro to run the tasks on a pool of worker threads ( Linux hosts only ) - set to 1 to enable
+#define TASKSCHEDULER_ENABLE_WORKER_POOL          ( 0 )
+
+/// define the number of worker threads
+#define TASKSCHEDULER_NUM_WORKERS                 ( 4 )
+
 /**@} EOF TaskScheduler_prm.h */
 
 #endif  // _TASKSCHEDULER_PRM_H
\ No newline at end of file
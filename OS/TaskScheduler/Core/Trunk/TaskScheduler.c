@@ -27,6 +27,17 @@
 // library includes -----------------------------------------------------------
 #include  "Interrupt/Interrupt.h"
 #include  "SystemTick/SystemTick.h"
+#if ( TASKSCHEDULER_ENABLE_POOL_ALLOCATOR == 1 )
+#include  "PoolAllocator/PoolAllocator.h"
+#endif // TASKSCHEDULER_ENABLE_POOL_ALLOCATOR
+
+// system includes ------------------------------------------------------------
+#if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+#include  <pthread.h>
+#include  <semaphore.h>
+#include  <signal.h>
+#include  <stdint.h>
+#endif // TASKSCHEDULER_ENABLE_WORKER_POOL
 
 // Macros and Defines ---------------------------------------------------------
 /// define the macro to map the control pointer
@@ -35,14 +46,66 @@
 /// define the minimum priority events
 #define MIN_PRIORITY_EVENTS               ( 2 )
 
+/// define the macros to allocate/free a task block
+#if ( TASKSCHEDULER_ENABLE_POOL_ALLOCATOR == 1 )
+#define TASK_ALLOC( size )                PoolAllocator_Alloc( size )
+#define TASK_FREE( block )                PoolAllocator_Free( block )
+#else
+#define TASK_ALLOC( size )                malloc( size )
+#define TASK_FREE( block )                free( block )
+#endif // TASKSCHEDULER_ENABLE_POOL_ALLOCATOR
+
+#if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+#if ( TASKSCHEDULER_NUM_PRIORITY_LEVELS > 32 )
+  #error The number of priority levels must be 32 or less in TaskScheduler_prm.h
+#endif
+
+/// define the macro to map a priority to a level
+#define MAP_PRIORITY_TO_LEVEL( pri )      (( U8 )MIN(( pri ), ( TASKSCHEDULER_NUM_PRIORITY_LEVELS - 1 )))
+
+/// define the count trailing zeros macro
+#if defined( __GNUC__ )
+#define READYLEVEL_CTZ( mask )            (( U8 )__builtin_ctzl( mask ))
+#else
+#define READYLEVEL_CTZ( mask )            ( CountTrailingZeros( mask ))
+#endif // __GNUC__
+#endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
+
+#if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+#if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+  #error Priority dispatch and the worker pool can not both be enabled in TaskScheduler_prm.h
+#endif
+#if !defined( INTERRUPT_ENABLE_THREADLOCK ) || ( INTERRUPT_ENABLE_THREADLOCK != 1 )
+  #error The worker pool requires INTERRUPT_ENABLE_THREADLOCK in Interrupt_prm.h
+#endif
+#if ( TASKSCHEDULER_NUM_WORKERS < 1 ) || ( TASKSCHEDULER_NUM_WORKERS > 255 )
+  #error The number of workers must be between 1 and 255 in TaskScheduler_prm.h
+#endif
+#endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+
 // structures -----------------------------------------------------------------
 /// define the task scheduler control structure
 typedef struct _TASKCTL
 {
   struct _TASKCTL*        ptSignature;      ///< my signature
   struct _TASKCTL*        ptNextTask;       ///< pointer to the next structure
+  #if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+  struct _TASKCTL*        ptNextTimer;      ///< pointer to the next timer in the delta list
+  BOOL                    bTimerLinked;     ///< timer is in the delta list
+  #endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+  #if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+  struct _TASKCTL*        ptNextReady;      ///< pointer to the next task in the ready list
+  BOOL                    bReady;           ///< task is in a ready list
+  U8                      nLevel;           ///< priority level
+  #endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
+  #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+  struct _TASKCTL*        ptNextRun;        ///< pointer to the next task in the run queue
+  BOOL                    bScheduled;       ///< task is in a run queue or executing
+  BOOL                    bDeleted;         ///< free deferred until the worker is done
+  U8                      nWorker;          ///< home worker
+  #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
   U32                     uDelayTime;       ///< current delay time
-  U32                     uDelayCount;      ///< delay count
+  U32                     uDelayCount;      ///< delay count, delta to previous timer if linked
   TASKSCHEDULEQUESIZEARG  xNrmRdIdx;        ///< event buffer read index
   TASKSCHEDULEQUESIZEARG  xNrmWrIdx;        ///< event buffer write index
   TASKSCHEDULEQUESIZEARG  xNrmCount;        ///< event count
@@ -61,28 +124,120 @@ typedef struct _TASKCTL
 } TASKCTL, *PTASKCTL;
 #define TASKCTL_SIZE          sizeof( TASKCTL )
 
+#if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+/// define the worker control structure, the run queue is guarded by the interrupt lock
+typedef struct _WORKERCTL
+{
+  pthread_t               tThread;          ///< worker thread
+  PTASKCTL                ptRunHead;        ///< first task in the run queue
+  PTASKCTL                ptRunTail;        ///< last task in the run queue
+} WORKERCTL, *PWORKERCTL;
+#define WORKERCTL_SIZE        sizeof( WORKERCTL )
+#endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+
 // local parameter declarations -----------------------------------------------
 static  PTASKCTL    ptFirstTask;      ///< pointer to the first task control structure
 static  U32         uSystemTickRate;  ///< execution rate of the tick handler
+#if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+static  PTASKCTL    ptFirstTimer;     ///< pointer to the first timer in the delta list
+#endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+#if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+static  PTASKCTL    aptReadyHead[ TASKSCHEDULER_NUM_PRIORITY_LEVELS ];  ///< ready list heads
+static  PTASKCTL    aptReadyTail[ TASKSCHEDULER_NUM_PRIORITY_LEVELS ];  ///< ready list tails
+static  VU32        uReadyLevels;     ///< bitmap of the levels with ready tasks
+#endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
+#if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+static  WORKERCTL       atWorkers[ TASKSCHEDULER_NUM_WORKERS ];  ///< worker controls
+static  sem_t           tRunSem;          ///< one count per task in the run queues
+static  BOOL            bWorkersRun;      ///< workers running
+static  U8              nNextWorker;      ///< next home worker to assign
+#endif // TASKSCHEDULER_ENABLE_WORKER_POOL
 
 // local function prototypes --------------------------------------------------
 static  BOOL  PutPriorityEvent( PTASKCTL ptTask, TASKSCHEDULEREVENT xEvent );
+static  BOOL  ExecuteEvent( PTASKCTL ptTask );
+#if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+static  void  TimerInsert( PTASKCTL ptTask, U32 uTicks );
+static  U32   TimerRemove( PTASKCTL ptTask );
+#endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+#if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+static  void      ReadyInsert( PTASKCTL ptTask );
+static  PTASKCTL  ReadyRemoveFirst( U8 nLevel );
+static  void      ReadyRemove( PTASKCTL ptTask );
+#if !defined( __GNUC__ )
+static  U8        CountTrailingZeros( U32 uMask );
+#endif // __GNUC__
+#endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
+#if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+static  void      WorkerSchedule( PTASKCTL ptTask );
+static  void      WorkerPush( PTASKCTL ptTask );
+static  PTASKCTL  WorkerTake( U8 nWorker );
+static  void      WorkerExecute( PTASKCTL ptTask );
+static  PVOID     WorkerThread( PVOID pvArg );
+#endif // TASKSCHEDULER_ENABLE_WORKER_POOL
 
 /******************************************************************************
  * @function TaskScheduler_Initialize
  *
  * @brief initialization
  *
- * This function will reset the first pointer to null
+ * This function will reset the first pointer to null and start the worker
+ * threads if the worker pool is enabled
  *
  *****************************************************************************/
 void TaskScheduler_Initialize( void )
 {
+  #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+  U8        nIdx;
+  int       iSignal;
+  sigset_t  tBlockMask, tPrevMask;
+  
+  #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
   // set the first to null
   ptFirstTask = NULL;
+  #if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+  ptFirstTimer = NULL;
+  #endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+
+  #if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+  // clear the ready lists
+  memset( aptReadyHead, 0, sizeof( aptReadyHead ));
+  memset( aptReadyTail, 0, sizeof( aptReadyTail ));
+  uReadyLevels = 0;
+  #endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
 
   // set the tick rate
   uSystemTickRate = SystemTick_GetTickRateUsec( );
+
+  #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+  // clear the run queues/run semaphore
+  nNextWorker = 0;
+  bWorkersRun = TRUE;
+  sem_init( &tRunSem, 0, 0 );
+  for ( nIdx = 0; nIdx < TASKSCHEDULER_NUM_WORKERS; nIdx++ )
+  {
+    atWorkers[ nIdx ].ptRunHead = NULL;
+    atWorkers[ nIdx ].ptRunTail = NULL;
+  }
+  
+  // block the tick/receive signals while the workers are created, they inherit
+  // the mask so the handlers never run on a worker
+  sigemptyset( &tBlockMask );
+  sigaddset( &tBlockMask, SIGALRM );
+  sigaddset( &tBlockMask, SIGIO );
+  for ( iSignal = SIGRTMIN; iSignal <= SIGRTMAX; iSignal++ )
+  {
+    sigaddset( &tBlockMask, iSignal );
+  }
+  pthread_sigmask( SIG_BLOCK, &tBlockMask, &tPrevMask );
+  
+  // start the workers/restore the mask
+  for ( nIdx = 0; nIdx < TASKSCHEDULER_NUM_WORKERS; nIdx++ )
+  {
+    pthread_create( &atWorkers[ nIdx ].tThread, NULL, WorkerThread, ( PVOID )( uintptr_t )nIdx );
+  }
+  pthread_sigmask( SIG_SETMASK, &tPrevMask, NULL );
+  #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
 }
 
 /******************************************************************************
@@ -91,77 +246,98 @@ void TaskScheduler_Initialize( void )
  * @brief idle process
  *
  * This function will check each task for active and events scheduled, and call
- * the event handler
+ * the event handler.  If priority dispatch is enabled, the ready tasks are
+ * swept in priority order, highest level first, each task that was ready at
+ * the start of the sweep runs once, draining multiple events if its level
+ * allows.  A task with events remaining is requeued behind its peers for the
+ * next sweep, so a handler that does not consume its event cannot starve the
+ * lower levels.  If the worker pool is enabled, the caller helps the workers,
+ * executing the queued tasks until the run queues are empty
  *
  *****************************************************************************/
 void TaskScheduler_IdleProcess( void )
 {
   PTASKCTL            ptCurTask;
-  BOOL                bPriorityEvent = FALSE;
-  BOOL                bEventFound = FALSE;
-  TASKSCHEDULEREVENT  xEvent;
+  #if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+  U8                  nDrainCount, nLevel;
+  U16                 wNumTasks;
+  U32                 uSweepLevels;
   
-  // for each item in list
-  ptCurTask = ptFirstTask;
-  while( ptCurTask != NULL )
+  // get the levels that are ready at the start of the sweep
+  Interrupt_Disable( );
+  uSweepLevels = uReadyLevels;
+  Interrupt_Enable( );
+  
+  // for each ready level, highest priority first
+  while ( uSweepLevels != 0 )
   {
-    // is this task enabled
-    if ( ptCurTask->bEnabled )
+    // get the level/remove it from the sweep
+    nLevel = READYLEVEL_CTZ( uSweepLevels );
+    uSweepLevels &= ~( 1ul << nLevel );
+    
+    // count the tasks that are ready on this level
+    Interrupt_Disable( );
+    for ( wNumTasks = 0, ptCurTask = aptReadyHead[ nLevel ]; ptCurTask != NULL; wNumTasks++, ptCurTask = ptCurTask->ptNextReady );
+    Interrupt_Enable( );
+    
+    // run each of them once
+    while ( wNumTasks-- != 0 )
     {
-      // check for priority event
-      if ( ptCurTask->nPriCount != 0 )
-      {
-        // get the event/set priority event flag
-        xEvent = *( ptCurTask->pxPriEvents + ptCurTask->nPriRdIdx );
-        bPriorityEvent = TRUE;
-        bEventFound = TRUE;
-      }
-      else if ( ptCurTask->xNrmCount != 0 )
-      {
-        // get a normal event
-        xEvent = *( ptCurTask->pxNrmEvents + ptCurTask->xNrmRdIdx );
-        bEventFound = TRUE;
-      }
-      else
-      {
-        // clear flags
-        bPriorityEvent = bEventFound = FALSE;
-      }
+      // get the first task in the level
+      Interrupt_Disable( );
+      ptCurTask = ReadyRemoveFirst( nLevel );
+      Interrupt_Enable( );
       
-      // now check for event execution
-      if ( bEventFound )
+      // check for a task that is enabled
+      if (( ptCurTask != NULL ) && ( ptCurTask->bEnabled ))
       {
-        // call the event handler
-        if ( ptCurTask->pvHandler( xEvent ))
+        // determine the number of events to process
+        nDrainCount = ( ptCurTask->nLevel <= TASKSCHEDULER_DRAIN_PRIORITY_LEVEL ) ? TASKSCHEDULER_DRAIN_MAX_EVENTS : 1;
+        
+        // execute the events
+        while (( nDrainCount-- != 0 ) && ( ExecuteEvent( ptCurTask )));
+        
+        // if events remain, put it back behind its peers for the next sweep
+        Interrupt_Disable( );
+        if (( ptCurTask->nPriCount != 0 ) || ( ptCurTask->xNrmCount != 0 ))
         {
-          // event was handled
-          Interrupt_Disable( );
-          
-          // check for type of event
-          if ( bPriorityEvent )
-          {
-            // decrement count/adjust pointers/check for rollover
-            ptCurTask->nPriCount--;
-            ptCurTask->nPriRdIdx++;
-            ptCurTask->nPriRdIdx %= ptCurTask->nPriMaxEvents;
-          }
-          else
-          {
-            // decrement count/adjust pointers/check for rollover
-            ptCurTask->xNrmCount--;
-            ptCurTask->xNrmRdIdx++;
-            ptCurTask->xNrmRdIdx %= ptCurTask->xNrmMaxEvents;
-          }
-          
-          // re-enable interrupts
-          Interrupt_Enable( );
+          ReadyInsert( ptCurTask );
         }
+        Interrupt_Enable( );
       }
     }
+  }
+  #elif ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+  
+  // while there are tasks in the run queues
+  while ( sem_trywait( &tRunSem ) == 0 )
+  {
+    // take one/execute it
+    Interrupt_Disable( );
+    ptCurTask = WorkerTake( 0 );
+    Interrupt_Enable( );
+    if ( ptCurTask != NULL )
+    {
+      WorkerExecute( ptCurTask );
+    }
+  }
+  #else
+  
+  // for each item in list
+  ptCurTask = ptFirstTask;
+  while( ptCurTask != NULL )
+  {
+    // is this task enabled
+    if ( ptCurTask->bEnabled )
+    {
+      // execute the next event
+      ExecuteEvent( ptCurTask );
+    }
     
     // next task
     ptCurTask = ptCurTask->ptNextTask;
   }
+  #endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
 }
 
 /******************************************************************************
@@ -170,13 +346,56 @@ void TaskScheduler_IdleProcess( void )
  * @brief tick process
  *
  * This function will check each task for timer active, decrement the time and
- * if time has expired, post a priority event
+ * if time has expired, post a priority event.  If the timer delta list is 
+ * enabled, only the head of the list is decremented and the expired timers 
+ * are removed.  If the worker pool is enabled, the lists are walked with the
+ * interrupts disabled as the workers run concurrently
  *
  *****************************************************************************/
 void TaskScheduler_TickProcess( void )
 {
   PTASKCTL  ptCurTask;
   
+  #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+  // lock out the workers
+  Interrupt_Disable( );
+  #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+  
+  #if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+  // check for any timers running
+  if ( ptFirstTimer != NULL )
+  {
+    // decrement the head of the list
+    if ( ptFirstTimer->uDelayCount != 0 )
+    {
+      ptFirstTimer->uDelayCount--;
+    }
+    
+    // now process all expired timers
+    while (( ptFirstTimer != NULL ) && ( ptFirstTimer->uDelayCount == 0 ))
+    {
+      // unlink it
+      ptCurTask = ptFirstTimer;
+      ptFirstTimer = ptCurTask->ptNextTimer;
+      ptCurTask->bTimerLinked = FALSE;
+      
+      // post a timeout event to the priority queue
+      PutPriorityEvent( ptCurTask, TASKSCHEDULER_TIMEOUT_EVENT );
+      
+      // adjust the time
+      if ( ptCurTask->eType == TASKSCHEDULER_TYPE_TIMED_CONTINUOUS )
+      {
+        // reset the time
+        TimerInsert( ptCurTask, ptCurTask->uDelayTime );
+      }
+      else
+      {
+        // clear the delay in progress
+        ptCurTask->bDelayInProgress = FALSE;
+      }
+    }
+  }
+  #else
   // for each item in list
   ptCurTask = ptFirstTask;
   while( ptCurTask != NULL )
@@ -211,6 +430,12 @@ void TaskScheduler_TickProcess( void )
     // next task
     ptCurTask = ptCurTask->ptNextTask;
   }
+  #endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+  
+  #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+  // release the workers
+  Interrupt_Enable( );
+  #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
 }
 
 /******************************************************************************
@@ -218,9 +443,9 @@ void TaskScheduler_TickProcess( void )
  *
  * @brief create a task
  *
- * This function will create a task by allocating memory for both the task control
- * structure, the normal and high priority queues and return the handle to the
- * newly crated task
+ * This function will create a task by allocating a single block holding the task
+ * control structure and the normal and high priority queues and return the handle
+ * to the newly crated task
  *
  * @param[in]   eType               task type
  * @param[in]   pvHandler           task handler
@@ -237,87 +462,112 @@ void TaskScheduler_TickProcess( void )
 PTASKSCHEDULERHANDLE TaskScheduler_Create( TASKSCHEDULERTYPE eType, PTASKSCHEDULERFUNC pvHandler, TASKSCHEDULEQUESIZEARG xNumOfNrmEvents, U8 nNumOfPriEvents, U32 uExecutionRateUsec, U8 nPriority, BOOL bInitialOn, BOOL bRunOnInit )
 {
   PTASKCTL  ptNewTask, ptCurTask, ptLstTask;
+  U8        nNumPriEvents;
   
-  // allocate space for new task
-  if (( ptNewTask = malloc( TASKCTL_SIZE )) != NULL )
+  // get the total number of priority events
+  nNumPriEvents = MIN_PRIORITY_EVENTS + nNumOfPriEvents;
+  
+  // allocate the control structure and both event queues as one block
+  if (( ptNewTask = TASK_ALLOC( TASKCTL_SIZE + ( sizeof( TASKSCHEDULEREVENT ) * ( xNumOfNrmEvents + nNumPriEvents )))) != NULL )
   {
-    // now allocate space for the normal event queue
-    if (( ptNewTask->pxNrmEvents = ( PTASKSCHEDULEREVENT )malloc( sizeof( TASKSCHEDULEREVENT ) * xNumOfNrmEvents )) != NULL )
+    // the event queues follow the control structure
+    ptNewTask->pxNrmEvents = ( PTASKSCHEDULEREVENT )( ptNewTask + 1 );
+    ptNewTask->pxPriEvents = ptNewTask->pxNrmEvents + xNumOfNrmEvents;
+    
+    // now initialize the control structure
+    ptNewTask->ptSignature      = ptNewTask;
+    ptNewTask->ptNextTask       = NULL;
+    ptNewTask->uDelayTime       = uExecutionRateUsec / uSystemTickRate;
+    ptNewTask->uDelayCount      = ptNewTask->uDelayTime;
+    ptNewTask->xNrmRdIdx        = 0;
+    ptNewTask->xNrmWrIdx        = 0;
+    ptNewTask->xNrmCount        = 0;
+    ptNewTask->xNrmMaxEvents    = xNumOfNrmEvents;
+    ptNewTask->nPriRdIdx        = 0;
+    ptNewTask->nPriWrIdx        = 0;
+    ptNewTask->nPriCount        = 0;
+    ptNewTask->nPriMaxEvents    = nNumPriEvents;
+    ptNewTask->nPriority        = nPriority;
+    ptNewTask->bDelayInProgress = ( eType == TASKSCHEDULER_TYPE_EVENT ) ? FALSE : TRUE;
+    ptNewTask->bEnabled         = bInitialOn;
+    ptNewTask->pvHandler        = pvHandler;
+    ptNewTask->eType            = eType;
+    #if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+    ptNewTask->ptNextTimer      = NULL;
+    ptNewTask->bTimerLinked     = FALSE;
+    #endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+    #if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+    ptNewTask->ptNextReady      = NULL;
+    ptNewTask->bReady           = FALSE;
+    ptNewTask->nLevel           = MAP_PRIORITY_TO_LEVEL( nPriority );
+    #endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
+    #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+    ptNewTask->ptNextRun        = NULL;
+    ptNewTask->bScheduled       = FALSE;
+    ptNewTask->bDeleted         = FALSE;
+    ptNewTask->nWorker          = nNextWorker;
+    nNextWorker = ( nNextWorker + 1 ) % TASKSCHEDULER_NUM_WORKERS;
+    #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+    
+    // check for run on init
+    if ( bRunOnInit )
     {
-      // now allocate space for the priority events
-      if (( ptNewTask->pxPriEvents = ( PTASKSCHEDULEREVENT )malloc(( sizeof( TASKSCHEDULEREVENT ) * ( MIN_PRIORITY_EVENTS + nNumOfPriEvents )))) != NULL )
-      {
-        // now initialize the control structure
-        ptNewTask->ptSignature      = ptNewTask;
-        ptNewTask->ptNextTask       = NULL;
-        ptNewTask->uDelayTime       = uExecutionRateUsec / uSystemTickRate;
-        ptNewTask->uDelayCount      = ptNewTask->uDelayTime;
-        ptNewTask->xNrmRdIdx        = 0;
-        ptNewTask->xNrmWrIdx        = 0;
-        ptNewTask->xNrmCount        = 0;
-        ptNewTask->xNrmMaxEvents    = xNumOfNrmEvents;
-        ptNewTask->nPriRdIdx        = 0;
-        ptNewTask->nPriWrIdx        = 0;
-        ptNewTask->nPriCount        = 0;
-        ptNewTask->nPriMaxEvents    = MIN_PRIORITY_EVENTS + nNumOfPriEvents;
-        ptNewTask->nPriority        = nPriority;
-        ptNewTask->bDelayInProgress = ( eType == TASKSCHEDULER_TYPE_EVENT ) ? FALSE : TRUE;
-        ptNewTask->bEnabled         = bInitialOn;
-        ptNewTask->pvHandler        = pvHandler;
-        ptNewTask->eType            = eType;
-        
-        // check for run on init
-        if ( bRunOnInit )
-        {
-          // shove an initialize event on the priority queue
-          PutPriorityEvent( ptNewTask, TASKSCHEDULER_INITIALIZE_EVENT );
-        }
-        
-        // now insert in list
-        if ( ptFirstTask == NULL )
-        {
-          // add it
-          ptFirstTask = ptNewTask;
-        }
-        else
-        {
-          // search for the entry point
-          for ( ptCurTask = ptFirstTask, ptLstTask = NULL; ( ptCurTask != NULL ) && ( ptCurTask->nPriority < nPriority ); ptLstTask = ptCurTask, ptCurTask = ptCurTask->ptNextTask );
+      // shove an initialize event on the priority queue
+      Interrupt_Disable( );
+      PutPriorityEvent( ptNewTask, TASKSCHEDULER_INITIALIZE_EVENT );
+      Interrupt_Enable( );
+    }
+    
+    #if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+    // add the timer to the list if running
+    if (( ptNewTask->bDelayInProgress ) && ( ptNewTask->bEnabled ))
+    {
+      Interrupt_Disable( );
+      TimerInsert( ptNewTask, ptNewTask->uDelayCount );
+      Interrupt_Enable( );
+    }
+    #endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+    
+    #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+    // lock out the tick while the list changes
+    Interrupt_Disable( );
+    #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+    
+    // now insert in list
+    if ( ptFirstTask == NULL )
+    {
+      // add it
+      ptFirstTask = ptNewTask;
+    }
+    else
+    {
+      // search for the entry point
+      for ( ptCurTask = ptFirstTask, ptLstTask = NULL; ( ptCurTask != NULL ) && ( ptCurTask->nPriority < nPriority ); ptLstTask = ptCurTask, ptCurTask = ptCurTask->ptNextTask );
 
-          // check for null
-          if ( ptCurTask == NULL )
-          {
-            // add at end
-            ptLstTask->ptNextTask = ptNewTask;
-          }
-          else if ( ptCurTask == ptFirstTask )
-          {
-            // add in front
-            ptFirstTask = ptNewTask;
-            ptNewTask->ptNextTask = ptCurTask;
-          }
-          else
-          {
-            // add in middle
-            ptLstTask->ptNextTask = ptNewTask;
-            ptNewTask->ptNextTask = ptCurTask;
-          }
-        }
+      // check for null
+      if ( ptCurTask == NULL )
+      {
+        // add at end
+        ptLstTask->ptNextTask = ptNewTask;
+      }
+      else if ( ptCurTask == ptFirstTask )
+      {
+        // add in front
+        ptFirstTask = ptNewTask;
+        ptNewTask->ptNextTask = ptCurTask;
       }
       else
       {
-        // error not enough room
-        free( ptNewTask->pxNrmEvents );
-        free( ptNewTask );
-        ptNewTask = NULL;
+        // add in middle
+        ptLstTask->ptNextTask = ptNewTask;
+        ptNewTask->ptNextTask = ptCurTask;
       }
     }
-    else
-    {
-      // error - not enough room
-      free( ptNewTask );
-      ptNewTask = NULL;
-    }
+    
+    #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+    // release the lock
+    Interrupt_Enable( );
+    #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
   }
   
   // return the handle
@@ -329,7 +579,9 @@ PTASKSCHEDULERHANDLE TaskScheduler_Create( TASKSCHEDULERTYPE eType, PTASKSCHEDUL
  *
  * @brief delete a task from the list
  *
- * This function will delete and free the memory for a given task
+ * This function will delete and free the memory for a given task.  If the
+ * worker pool is enabled and the task is queued or executing, the free is
+ * deferred to the worker
  *
  * @param[in]   ptTask    task handle
  *
@@ -338,7 +590,7 @@ PTASKSCHEDULERHANDLE TaskScheduler_Create( TASKSCHEDULERTYPE eType, PTASKSCHEDUL
  *****************************************************************************/
 TASKSCHEDULERERR TaskScheduler_Delete( PTASKSCHEDULERHANDLE ptTask )
 {
-  TASKSCHEDULERERR  eError;
+  TASKSCHEDULERERR  eError = TASKSCHEDULER_ERR_NONE;
   PTASKCTL          ptCurTask, ptLstTask, ptSelTask;
   
   // map the pointer
@@ -347,8 +599,13 @@ TASKSCHEDULERERR TaskScheduler_Delete( PTASKSCHEDULERHANDLE ptTask )
   // first validate that the task is valid
   if ( ptSelTask == ptSelTask->ptSignature )
   {
+    #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+    // lock out the workers and the tick
+    Interrupt_Disable( );
+    #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+    
     // search for the task
-    for ( ptCurTask = ptFirstTask, ptLstTask = NULL; ( ptCurTask->ptNextTask != NULL ) && ( ptCurTask != ptSelTask ); ptLstTask = ptCurTask, ptCurTask = ptCurTask->ptNextTask )
+    for ( ptCurTask = ptFirstTask, ptLstTask = NULL; ( ptCurTask != NULL ) && ( ptCurTask != ptSelTask ); ptLstTask = ptCurTask, ptCurTask = ptCurTask->ptNextTask );
 
     // check for event found
     if ( ptCurTask != NULL )
@@ -370,11 +627,40 @@ TASKSCHEDULERERR TaskScheduler_Delete( PTASKSCHEDULERHANDLE ptTask )
             ptLstTask->ptNextTask = ptCurTask->ptNextTask;
         }
 
-        // free the event buffer/event
-        free( ptCurTask->pxPriEvents );
-        free( ptCurTask->pxNrmEvents );
-        free( ptCurTask );
+        #if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+        // remove the timer from the list
+        Interrupt_Disable( );
+        TimerRemove( ptCurTask );
+        Interrupt_Enable( );
+        #endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+
+        #if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+        // remove the task from the ready list
+        Interrupt_Disable( );
+        ReadyRemove( ptCurTask );
+        Interrupt_Enable( );
+        #endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
+
+        // clear the signature/free the task block
+        ptCurTask->ptSignature = NULL;
+        #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+        if ( ptCurTask->bScheduled )
+        {
+          // the worker will free it
+          ptCurTask->bDeleted = TRUE;
+          ptCurTask = NULL;
+        }
+        #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+        if ( ptCurTask != NULL )
+        {
+          TASK_FREE( ptCurTask );
+        }
     }
+    
+    #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+    // release the lock
+    Interrupt_Enable( );
+    #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
   }
   else
   {
@@ -412,20 +698,26 @@ TASKSCHEDULERERR TaskScheduler_PostEvent( PTASKSCHEDULERHANDLE ptTask, TASKSCHED
   if ( ptSelTask == ptSelTask->ptSignature )
   {
     // check for room
+    Interrupt_Disable( );
     if ( ptSelTask->xNrmCount < ptSelTask->xNrmMaxEvents )
     {
       // add the event/adjust pointer/increment count
-      Interrupt_Disable( );
       *( ptSelTask->pxNrmEvents + ptSelTask->xNrmWrIdx++ ) = xEvent;
       ptSelTask->xNrmWrIdx %= ptSelTask->xNrmMaxEvents;
       ptSelTask->xNrmCount++;
-      Interrupt_Enable( );
+      #if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+      ReadyInsert( ptSelTask );
+      #endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
+      #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+      WorkerSchedule( ptSelTask );
+      #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
     }
     else
     {
       // queue - full error
       eError = TASKSCHEDULER_ERR_EVENTQUEUEFULL;
     }
+    Interrupt_Enable( );
   }
   else
   {
@@ -501,8 +793,53 @@ TASKSCHEDULERERR TaskScheduler_DisableEnable( PTASKSCHEDULERHANDLE ptTask, BOOL
   // first validate that the task is valid
   if ( ptSelTask == ptSelTask->ptSignature )
   {
+    #if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+    // disable interrupts
+    Interrupt_Disable( );
+    
+    // check for a state change with a timer running
+    if (( ptSelTask->bEnabled != bState ) && ( ptSelTask->bDelayInProgress ))
+    {
+      if ( bState )
+      {
+        // resume the timer with the remaining time
+        TimerInsert( ptSelTask, ptSelTask->uDelayCount );
+      }
+      else
+      {
+        // suspend the timer/save the remaining time
+        ptSelTask->uDelayCount = TimerRemove( ptSelTask );
+      }
+    }
+    #endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+    
     // now set the task state
     ptSelTask->bEnabled = bState;
+    
+    #if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+    // if enabled with events pending, make it ready
+    Interrupt_Disable( );
+    if (( bState ) && (( ptSelTask->nPriCount != 0 ) || ( ptSelTask->xNrmCount != 0 )))
+    {
+      ReadyInsert( ptSelTask );
+    }
+    Interrupt_Enable( );
+    #endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
+    
+    #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+    // if enabled with events pending, hand it to a worker
+    Interrupt_Disable( );
+    if (( bState ) && (( ptSelTask->nPriCount != 0 ) || ( ptSelTask->xNrmCount != 0 )))
+    {
+      WorkerSchedule( ptSelTask );
+    }
+    Interrupt_Enable( );
+    #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+    
+    #if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+    // re-enable interrupts
+    Interrupt_Enable( );
+    #endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
   }
   else
   {
@@ -590,6 +927,11 @@ TASKSCHEDULERERR TaskScheduler_TimerControl( PTASKSCHEDULERHANDLE ptTask, U32 uT
     // disable interrupts
     Interrupt_Disable( );
     
+    #if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+    // remove the timer if already running
+    TimerRemove( ptSelTask );
+    #endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+    
     // set the state
     ptSelTask->bDelayInProgress = bState;
     
@@ -605,6 +947,14 @@ TASKSCHEDULERERR TaskScheduler_TimerControl( PTASKSCHEDULERHANDLE ptTask, U32 uT
       
       // update the time
       ptSelTask->uDelayCount = ptSelTask->uDelayTime;
+      
+      #if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+      // add the timer to the list if the task is enabled
+      if ( ptSelTask->bEnabled )
+      {
+        TimerInsert( ptSelTask, ptSelTask->uDelayCount );
+      }
+      #endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
     }
     
     // re-enable interrupts
@@ -635,6 +985,11 @@ BOOL TaskScheduler_CheckTasksPending( void )
   PTASKCTL  ptCurTask;
   BOOL      bTasksPending = FALSE;
   
+  #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+  // lock out the workers
+  Interrupt_Disable( );
+  #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+  
   // for each item in list
   ptCurTask = ptFirstTask;
   while(( ptCurTask ) != NULL && !bTasksPending )
@@ -655,9 +1010,45 @@ BOOL TaskScheduler_CheckTasksPending( void )
     ptCurTask = ptCurTask->ptNextTask;
   }
   
+  #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+  // release the workers
+  Interrupt_Enable( );
+  #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+  
   // return status
   return( bTasksPending );
 }
+
+#if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+/******************************************************************************
+ * @function TaskScheduler_StopWorkers
+ *
+ * @brief stop the worker threads
+ *
+ * This function will signal the workers to stop and wait for them to exit.  
+ * Tasks left in the run queues are not executed
+ *
+ *****************************************************************************/
+void TaskScheduler_StopWorkers( void )
+{
+  U8  nIdx;
+  
+  // clear the run flag/wake all workers
+  Interrupt_Disable( );
+  bWorkersRun = FALSE;
+  for ( nIdx = 0; nIdx < TASKSCHEDULER_NUM_WORKERS; nIdx++ )
+  {
+    sem_post( &tRunSem );
+  }
+  Interrupt_Enable( );
+  
+  // wait for each to exit
+  for ( nIdx = 0; nIdx < TASKSCHEDULER_NUM_WORKERS; nIdx++ )
+  {
+    pthread_join( atWorkers[ nIdx ].tThread, NULL );
+  }
+}
+#endif // TASKSCHEDULER_ENABLE_WORKER_POOL
  
 /******************************************************************************
  * @function PutPriorityEvent
@@ -684,6 +1075,16 @@ static BOOL PutPriorityEvent( PTASKCTL ptTask, TASKSCHEDULEREVENT xEvent )
     ptTask->nPriWrIdx %= ptTask->nPriMaxEvents;
     ptTask->nPriCount++;
     
+    #if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+    // make the task ready
+    ReadyInsert( ptTask );
+    #endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
+    
+    #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+    // hand the task to a worker
+    WorkerSchedule( ptTask );
+    #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+    
     // set the status to true
     bStatus = TRUE;
   }
@@ -692,4 +1093,533 @@ static BOOL PutPriorityEvent( PTASKCTL ptTask, TASKSCHEDULEREVENT xEvent )
   return( bStatus );
 }
 
+/******************************************************************************
+ * @function ExecuteEvent
+ *
+ * @brief execute the next event of a task
+ *
+ * This function will get the next event, priority events first, call the 
+ * task handler and remove the event if it was handled
+ *
+ * @param[in]   ptTask    pointer to the task
+ *
+ * @return      TRUE if an event was handled, FALSE if not
+ *
+ *****************************************************************************/
+static BOOL ExecuteEvent( PTASKCTL ptTask )
+{
+  BOOL                bPriorityEvent = FALSE;
+  BOOL                bEventFound = FALSE;
+  BOOL                bHandled = FALSE;
+  TASKSCHEDULEREVENT  xEvent;
+  
+  #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+  // the posters run concurrently
+  Interrupt_Disable( );
+  #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+  
+  // check for priority event
+  if ( ptTask->nPriCount != 0 )
+  {
+    // get the event/set priority event flag
+    xEvent = *( ptTask->pxPriEvents + ptTask->nPriRdIdx );
+    bPriorityEvent = TRUE;
+    bEventFound = TRUE;
+  }
+  else if ( ptTask->xNrmCount != 0 )
+  {
+    // get a normal event
+    xEvent = *( ptTask->pxNrmEvents + ptTask->xNrmRdIdx );
+    bEventFound = TRUE;
+  }
+  
+  #if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+  // release the lock before calling the handler
+  Interrupt_Enable( );
+  #endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+  
+  // now check for event execution
+  if ( bEventFound )
+  {
+    // call the event handler
+    if ( ptTask->pvHandler( xEvent ))
+    {
+      // event was handled
+      Interrupt_Disable( );
+      
+      // check for type of event
+      if ( bPriorityEvent )
+      {
+        // decrement count/adjust pointers/check for rollover
+        ptTask->nPriCount--;
+        ptTask->nPriRdIdx++;
+        ptTask->nPriRdIdx %= ptTask->nPriMaxEvents;
+      }
+      else
+      {
+        // decrement count/adjust pointers/check for rollover
+        ptTask->xNrmCount--;
+        ptTask->xNrmRdIdx++;
+        ptTask->xNrmRdIdx %= ptTask->xNrmMaxEvents;
+      }
+      
+      // re-enable interrupts
+      Interrupt_Enable( );
+      
+      // set the handled flag
+      bHandled = TRUE;
+    }
+  }
+  
+  // return the status
+  return( bHandled );
+}
+
+#if ( TASKSCHEDULER_ENABLE_TIMER_DELTALIST == 1 )
+/******************************************************************************
+ * @function TimerInsert
+ *
+ * @brief insert a timer into the delta list
+ *
+ * This function will insert the task's timer into the list sorted by
+ * expiration, storing the time relative to the previous timer.  A zero time
+ * is never inserted, to match a timer that never expires
+ *
+ * @param[in]   ptTask    pointer to the task
+ * @param[in]   uTicks    number of ticks until expiration
+ *
+ *****************************************************************************/
+static void TimerInsert( PTASKCTL ptTask, U32 uTicks )
+{
+  PTASKCTL  ptCurTask, ptLstTask;
+  
+  // only insert a valid time
+  if ( uTicks != 0 )
+  {
+    // search for the entry point, adjusting the time as we go
+    for ( ptCurTask = ptFirstTimer, ptLstTask = NULL; ( ptCurTask != NULL ) && ( uTicks >= ptCurTask->uDelayCount ); ptLstTask = ptCurTask, ptCurTask = ptCurTask->ptNextTimer )
+    {
+      uTicks -= ptCurTask->uDelayCount;
+    }
+    
+    // set the delta/link it
+    ptTask->uDelayCount = uTicks;
+    ptTask->ptNextTimer = ptCurTask;
+    ptTask->bTimerLinked = TRUE;
+    
+    // adjust the following timer
+    if ( ptCurTask != NULL )
+    {
+      ptCurTask->uDelayCount -= uTicks;
+    }
+    
+    // now update the previous
+    if ( ptLstTask == NULL )
+    {
+      // new head
+      ptFirstTimer = ptTask;
+    }
+    else
+    {
+      // add after last
+      ptLstTask->ptNextTimer = ptTask;
+    }
+  }
+}
+
+/******************************************************************************
+ * @function TimerRemove
+ *
+ * @brief remove a timer from the delta list
+ *
+ * This function will remove the task's timer from the list if linked and add
+ * its delta to the following timer
+ *
+ * @param[in]   ptTask    pointer to the task
+ *
+ * @return      the number of ticks that were remaining
+ *
+ *****************************************************************************/
+static U32 TimerRemove( PTASKCTL ptTask )
+{
+  PTASKCTL  ptCurTask, ptLstTask;
+  U32       uRemaining = 0;
+  
+  // only remove if linked
+  if ( ptTask->bTimerLinked )
+  {
+    // search for the timer, accumulating the time
+    for ( ptCurTask = ptFirstTimer, ptLstTask = NULL; ( ptCurTask != NULL ) && ( ptCurTask != ptTask ); ptLstTask = ptCurTask, ptCurTask = ptCurTask->ptNextTimer )
+    {
+      uRemaining += ptCurTask->uDelayCount;
+    }
+    uRemaining += ptTask->uDelayCount;
+    
+    // give our time to the following timer
+    if ( ptTask->ptNextTimer != NULL )
+    {
+      ptTask->ptNextTimer->uDelayCount += ptTask->uDelayCount;
+    }
+    
+    // unlink it
+    if ( ptLstTask == NULL )
+    {
+      // was the head
+      ptFirstTimer = ptTask->ptNextTimer;
+    }
+    else
+    {
+      // remove from the middle
+      ptLstTask->ptNextTimer = ptTask->ptNextTimer;
+    }
+    ptTask->bTimerLinked = FALSE;
+  }
+  
+  // return the remaining time
+  return( uRemaining );
+}
+#endif // TASKSCHEDULER_ENABLE_TIMER_DELTALIST
+
+#if ( TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH == 1 )
+/******************************************************************************
+ * @function ReadyInsert
+ *
+ * @brief insert a task into its ready list
+ *
+ * This function will append the task to the end of its priority level's
+ * ready list if not already there and flag the level as ready
+ *
+ * @param[in]   ptTask    pointer to the task
+ *
+ *****************************************************************************/
+static void ReadyInsert( PTASKCTL ptTask )
+{
+  // only insert if not already ready
+  if ( !ptTask->bReady )
+  {
+    // append it
+    ptTask->ptNextReady = NULL;
+    if ( aptReadyHead[ ptTask->nLevel ] == NULL )
+    {
+      // first one
+      aptReadyHead[ ptTask->nLevel ] = ptTask;
+    }
+    else
+    {
+      // add at end
+      aptReadyTail[ ptTask->nLevel ]->ptNextReady = ptTask;
+    }
+    aptReadyTail[ ptTask->nLevel ] = ptTask;
+    
+    // flag it/set the level
+    ptTask->bReady = TRUE;
+    uReadyLevels |= ( 1ul << ptTask->nLevel );
+  }
+}
+
+/******************************************************************************
+ * @function ReadyRemoveFirst
+ *
+ * @brief remove the first task from a ready list
+ *
+ * This function will remove the first task of a level's ready list and clear
+ * the level if the list is now empty
+ *
+ * @param[in]   nLevel    priority level
+ *
+ * @return      pointer to the task or NULL if empty
+ *
+ *****************************************************************************/
+static PTASKCTL ReadyRemoveFirst( U8 nLevel )
+{
+  PTASKCTL  ptTask;
+  
+  // get the first
+  if (( ptTask = aptReadyHead[ nLevel ] ) != NULL )
+  {
+    // unlink it
+    aptReadyHead[ nLevel ] = ptTask->ptNextReady;
+    ptTask->ptNextReady = NULL;
+    ptTask->bReady = FALSE;
+  }
+  
+  // clear the level if empty
+  if ( aptReadyHead[ nLevel ] == NULL )
+  {
+    aptReadyTail[ nLevel ] = NULL;
+    uReadyLevels &= ~( 1ul << nLevel );
+  }
+  
+  // return the task
+  return( ptTask );
+}
+
+/******************************************************************************
+ * @function ReadyRemove
+ *
+ * @brief remove a task from its ready list
+ *
+ * This function will remove the task from anywhere in its ready list
+ *
+ * @param[in]   ptTask    pointer to the task
+ *
+ *****************************************************************************/
+static void ReadyRemove( PTASKCTL ptTask )
+{
+  PTASKCTL  ptCurTask, ptLstTask;
+  
+  // only remove if ready
+  if ( ptTask->bReady )
+  {
+    // search for the task
+    for ( ptCurTask = aptReadyHead[ ptTask->nLevel ], ptLstTask = NULL; ( ptCurTask != NULL ) && ( ptCurTask != ptTask ); ptLstTask = ptCurTask, ptCurTask = ptCurTask->ptNextReady );
+    
+    // check for first
+    if ( ptLstTask == NULL )
+    {
+      // use the remove first
+      ReadyRemoveFirst( ptTask->nLevel );
+    }
+    else
+    {
+      // unlink it/adjust the tail
+      ptLstTask->ptNextReady = ptTask->ptNextReady;
+      if ( aptReadyTail[ ptTask->nLevel ] == ptTask )
+      {
+        aptReadyTail[ ptTask->nLevel ] = ptLstTask;
+      }
+      ptTask->ptNextReady = NULL;
+      ptTask->bReady = FALSE;
+    }
+  }
+}
+
+#if !defined( __GNUC__ )
+/******************************************************************************
+ * @function CountTrailingZeros
+ *
+ * @brief count the trailing zeros
+ *
+ * This function returns the index of the lowest set bit in the mask
+ *
+ * @param[in]   uMask   mask, must be non-zero
+ *
+ * @return      index of the lowest set bit
+ *
+ *****************************************************************************/
+static U8 CountTrailingZeros( U32 uMask )
+{
+  U8  nCount = 0;
+
+  // count the bits
+  while (( uMask & 0x01 ) == 0 )
+  {
+    uMask >>= 1;
+    nCount++;
+  }
+
+  // return the count
+  return( nCount );
+}
+#endif // __GNUC__
+#endif // TASKSCHEDULER_ENABLE_PRIORITY_DISPATCH
+
+#if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+/******************************************************************************
+ * @function WorkerSchedule
+ *
+ * @brief schedule a task on a worker
+ *
+ * This function will queue an enabled task on its home worker if it is not
+ * already queued or executing, which keeps a handler from running on two
+ * workers at once.  Must be called with the interrupts disabled
+ *
+ * @param[in]   ptTask    pointer to the task
+ *
+ *****************************************************************************/
+static void WorkerSchedule( PTASKCTL ptTask )
+{
+  // only schedule an idle enabled task
+  if (( ptTask->bEnabled ) && ( !ptTask->bScheduled ) && ( !ptTask->bDeleted ))
+  {
+    // flag it/queue it
+    ptTask->bScheduled = TRUE;
+    WorkerPush( ptTask );
+  }
+}
+
+/******************************************************************************
+ * @function WorkerPush
+ *
+ * @brief push a task onto its home worker's run queue
+ *
+ * This function will append the task to the run queue and wake a worker.  Must
+ * be called with the interrupts disabled.  Only the interrupt lock, which the
+ * caller already holds, and sem_post are used, so this is safe from the tick
+ * and receive signal handlers
+ *
+ * @param[in]   ptTask    pointer to the task
+ *
+ *****************************************************************************/
+static void WorkerPush( PTASKCTL ptTask )
+{
+  PWORKERCTL  ptWorker;
+  
+  // get the worker
+  ptWorker = &atWorkers[ ptTask->nWorker ];
+  
+  // append it
+  ptTask->ptNextRun = NULL;
+  if ( ptWorker->ptRunHead == NULL )
+  {
+    // first one
+    ptWorker->ptRunHead = ptTask;
+  }
+  else
+  {
+    // add at end
+    ptWorker->ptRunTail->ptNextRun = ptTask;
+  }
+  ptWorker->ptRunTail = ptTask;
+  
+  // wake a worker
+  sem_post( &tRunSem );
+}
+
+/******************************************************************************
+ * @function WorkerTake
+ *
+ * @brief take a task from a run queue
+ *
+ * This function will take the first task from the worker's own run queue, or
+ * steal one from the other workers if its own is empty.  Must be called with
+ * the interrupts disabled
+ *
+ * @param[in]   nWorker   worker index
+ *
+ * @return      pointer to the task or NULL if none
+ *
+ *****************************************************************************/
+static PTASKCTL WorkerTake( U8 nWorker )
+{
+  PWORKERCTL  ptWorker;
+  PTASKCTL    ptTask = NULL;
+  U8          nIdx;
+  
+  // own queue first, then the others
+  for ( nIdx = 0; ( nIdx < TASKSCHEDULER_NUM_WORKERS ) && ( ptTask == NULL ); nIdx++ )
+  {
+    // get the worker
+    ptWorker = &atWorkers[ ( nWorker + nIdx ) % TASKSCHEDULER_NUM_WORKERS ];
+    
+    // remove the first
+    if (( ptTask = ptWorker->ptRunHead ) != NULL )
+    {
+      // unlink it/clear the tail if empty
+      if (( ptWorker->ptRunHead = ptTask->ptNextRun ) == NULL )
+      {
+        ptWorker->ptRunTail = NULL;
+      }
+      ptTask->ptNextRun = NULL;
+    }
+  }
+  
+  // return the task
+  return( ptTask );
+}
+
+/******************************************************************************
+ * @function WorkerExecute
+ *
+ * @brief execute a task on a worker
+ *
+ * This function will execute one event of the task, then re-queue it if events
+ * remain, or free it if it was deleted while executing
+ *
+ * @param[in]   ptTask    pointer to the task
+ *
+ *****************************************************************************/
+static void WorkerExecute( PTASKCTL ptTask )
+{
+  BOOL  bFree = FALSE;
+  
+  // execute the next event
+  if (( ptTask->bEnabled ) && ( !ptTask->bDeleted ))
+  {
+    ExecuteEvent( ptTask );
+  }
+  
+  // now determine what to do with it
+  Interrupt_Disable( );
+  if ( ptTask->bDeleted )
+  {
+    // free it after the lock is released
+    bFree = TRUE;
+  }
+  else if (( ptTask->bEnabled ) && (( ptTask->nPriCount != 0 ) || ( ptTask->xNrmCount != 0 )))
+  {
+    // put it back at the end of the run queue, still scheduled
+    WorkerPush( ptTask );
+  }
+  else
+  {
+    // done
+    ptTask->bScheduled = FALSE;
+  }
+  Interrupt_Enable( );
+  
+  // free if deleted
+  if ( bFree )
+  {
+    TASK_FREE( ptTask );
+  }
+}
+
+/******************************************************************************
+ * @function WorkerThread
+ *
+ * @brief worker thread
+ *
+ * This function will take and execute tasks until the workers are stopped,
+ * waiting on the run semaphore when there is nothing to run
+ *
+ * @param[in]   pvArg     worker index
+ *
+ * @return      NULL
+ *
+ *****************************************************************************/
+static PVOID WorkerThread( PVOID pvArg )
+{
+  PTASKCTL  ptTask;
+  U8        nWorker;
+  BOOL      bRun = TRUE;
+  
+  // get the worker index
+  nWorker = ( U8 )( uintptr_t )pvArg;
+  
+  // loop until stopped
+  while ( bRun )
+  {
+    // wait for work
+    if ( sem_wait( &tRunSem ) == 0 )
+    {
+      // check for stopped/get a task
+      Interrupt_Disable( );
+      bRun = bWorkersRun;
+      ptTask = ( bRun ) ? WorkerTake( nWorker ) : NULL;
+      Interrupt_Enable( );
+      
+      // execute it
+      if ( ptTask != NULL )
+      {
+        WorkerExecute( ptTask );
+      }
+    }
+  }
+  
+  // exit
+  return( NULL );
+}
+#endif // TASKSCHEDULER_ENABLE_WORKER_POOL
+
 /**@} EOF TaskScheduler.c */
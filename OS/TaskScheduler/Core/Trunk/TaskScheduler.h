@@ -103,6 +103,9 @@ extern  TASKSCHEDULERERR      TaskScheduler_DisableEnable( PTASKSCHEDULERHANDLE
 extern  TASKSCHEDULERERR      TaskScheduler_FlushEvents( PTASKSCHEDULERHANDLE ptTask );
 extern	TASKSCHEDULERERR      TaskScheduler_TimerControl( PTASKSCHEDULERHANDLE ptTask, U32 uTime, BOOL bState );
 extern  BOOL                  TaskScheduler_CheckTasksPending( void );
+#if ( TASKSCHEDULER_ENABLE_WORKER_POOL == 1 )
+extern  void                  TaskScheduler_StopWorkers( void );
+#endif // TASKSCHEDULER_ENABLE_WORKER_POOL
 
 /**@} EOF TaskScheduler.h */
 
@@ -41,7 +41,7 @@
 // local function prototypes --------------------------------------------------
 
 // constant parameter initializations -----------------------------------------
-const CODE  BINPROTDEF   atBinProtDefs[ BINPROT_MAX_ENUM ] =
+const CODE  BINPROTDEF   atBinProtDefs[ BINPROT_ENUM_MAX ] =
 {
   // add entries to this table using the below macros
   // BINPROT_DEFM( multidrop, seqenable, chkmode, devaddr, xmtsize, rcvsize, writefunc ) 
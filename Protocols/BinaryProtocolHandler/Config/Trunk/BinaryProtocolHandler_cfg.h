@@ -33,6 +33,11 @@
 // library includes -----------------------------------------------------------
 
 // Macros and Defines ---------------------------------------------------------
+/// define the macro to enable the windowed multiple outstanding request mode - set to 1 to enable
+#define BINPROT_ENABLE_WINDOW                     ( 0 )
+
+/// define the maximum number of outstanding requests per protocol
+#define BINPROT_WINDOW_SIZE                       ( 4 )
 
 // enumerations ---------------------------------------------------------------
 
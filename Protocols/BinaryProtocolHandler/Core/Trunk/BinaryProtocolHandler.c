@@ -22,13 +22,19 @@
  *****************************************************************************/
 
 // system includes ------------------------------------------------------------
+#include <errno.h>
+#include <pthread.h>
 #include <semaphore.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 // local includes -------------------------------------------------------------
-#include "BinaryProtocol/BinaryProtocol.h"
+#include "BinaryProtocolHandler/BinaryProtocolHandler.h"
 
 // library includes -----------------------------------------------------------
-#include "CRC16/CRC16.h"
+#include "CRC16/Crc16.h"
+#include "Interrupt/Interrupt.h"
 #include "StateExecutionEngine/StateExecutionEngine.h"
 
 // Macros and Defines ---------------------------------------------------------
@@ -41,6 +47,10 @@
 #define CH_NAK                  ( 0x15 )
 #define CH_SPC                  ( 0xFE )
 
+/// define the number of nanoseconds per millisecond/second
+#define NSECS_PER_MSEC          ( 1000000l )
+#define NSECS_PER_SEC           ( 1000000000l )
+
 // enumerations ---------------------------------------------------------------
 /// define the receive states
 typedef enum _RCVSTATE
@@ -60,25 +70,57 @@ typedef enum _RCVSTATE
   RCV_STATE_MAX
 } RCVSTATE;
 
+/// define the local status
+typedef enum _LCLSTS
+{
+  LCL_STS_IDLE = 0,       ///< idle
+  LCL_STS_BUSY,           ///< receiving a message
+  LCL_STS_RCVD,           ///< message received
+  LCL_STS_CHKERR,         ///< message received with a check error
+} LCLSTS;
+
 // structures -----------------------------------------------------------------
+#if ( BINPROT_ENABLE_WINDOW == 1 )
+/// define the outstanding request structure
+typedef struct _WINSLOT
+{
+  BOOL                bActive;            ///< slot in use
+  U8                  nSequence;          ///< sequence number of the request
+  U32                 uDeadlineMsec;      ///< time the request expires
+  PVBINPROTCOMPLETE   pvComplete;         ///< completion callback
+  PVOID               pvArg;              ///< callback argument
+} WINSLOT, *PWINSLOT;
+#define WINSLOT_SIZE          sizeof( WINSLOT )
+#endif // BINPROT_ENABLE_WINDOW
+
 /// define the local contro struture
 typedef struct _LCLCTL
 {
-  sem_t               tRcvMsgSem;
-  PU8                 pnXmtBuffer;
-  PU8                 pnRcvBuffer;
-  U16                 wXmtBufSize;
-  U16                 wXmtBufIndex;
-  U16                 wRcvBufIndex;
-  BINPROTCHKMODE      eCheckMode;
-  U8                  nDeviceAddr;
-  BOOL                bMultiDropEnabled;
-  BOOL                bSequenceEnabled;
-  U16UN               tXmtCheckValue;
-  U16UN               tRcvCheckValue;
-  U16UN               tCalcCheckValue;
-  BINPROTMSG          tRcvMessage;
+  sem_t               tRcvMsgSem;         ///< receive message semaphore
+  BOOL                bRcvWaiting;        ///< a caller is waiting on the receive semaphore
+  pthread_mutex_t     tXmtLock;           ///< transmit buffer lock
+  PVBINWRITEFUNC      pvWriteFunc;        ///< write function
+  PU8                 pnXmtBuffer;        ///< transmit buffer
+  PU8                 pnRcvBuffer;        ///< receive buffer
+  U16                 wXmtBufSize;        ///< transmit buffer size
+  U16                 wXmtBufIndex;       ///< transmit buffer index
+  U16                 wRcvBufSize;        ///< receive buffer size
+  U16                 wRcvBufIndex;       ///< receive buffer index
+  BINPROTCHKMODE      eCheckMode;         ///< check mode
+  U8                  nDeviceAddr;        ///< local device address
+  BOOL                bMultiDropEnabled;  ///< multi drop mode
+  BOOL                bSequenceEnabled;   ///< sequence numbers enabled
+  LCLSTS              eLclSts;            ///< local status
+  U16UN               tXmtCheckValue;     ///< transmit check value
+  U16UN               tRcvCheckValue;     ///< calculated receive check value
+  U16UN               tMsgCheckValue;     ///< check value received in the message
+  BINPROTMSG          tRcvMessage;        ///< received message
   STATEEXECENGCONTROL tStateCtl;          ///< the state control structure
+  #if ( BINPROT_ENABLE_WINDOW == 1 )
+  WINSLOT             atWindow[ BINPROT_WINDOW_SIZE ];  ///< outstanding requests
+  U8                  nNextSequence;      ///< next sequence number to use
+  U8                  nRcvSequence;       ///< sequence number reserved by the waiter
+  #endif // BINPROT_ENABLE_WINDOW
 } LCLCTL, *PLCLCTL;
 #define LCLCTL_SIZE           sizeof( LCLCTL )
 
@@ -90,43 +132,51 @@ static  PLCLCTL ptCurCtl;
 
 // local function prototypes --------------------------------------------------
 static  void  FormatMessage( PLCLCTL ptCtl, PBINPROTMSG ptMessage );
-static  void  StuffXmitBuffer( PLCLCTL ptCtl, U8 nData, BOOL bStuffEnable );
-static  BOOL  CheckAddress( U8 nAddr );
-static  BOOL  StuffRcvData( U8 nRcvChar );
+static  void  StuffXmtBuffer( PLCLCTL ptCtl, U8 nData, BOOL bStuffEnable );
+static  void  StuffXmtBlock( PLCLCTL ptCtl, PU8 pnData, U16 wLength );
+static  void  UpdateCheckValue( BINPROTCHKMODE eCheckMode, PU16UN ptCheck, PU8 pnData, U16 wLength );
+static  void  PostWaiter( PLCLCTL ptCtl );
+#if ( BINPROT_ENABLE_WINDOW == 1 )
+static  BOOL  CompleteRequest( PLCLCTL ptCtl );
+static  U8    AllocSequence( PLCLCTL ptCtl );
+static  U32   GetTimeMsec( void );
+#endif // BINPROT_ENABLE_WINDOW
+static  BOOL  CheckAddress( PLCLCTL ptCtl, U8 nAddr );
+static  BOOL  StuffRcvData( PLCLCTL ptCtl, U8 nRcvChar );
 
 // RCV_STATE_IDLE functions
 static  void  RcvStateIdleEnt( void );
 static  void  RcvStateIdleExt( void );
 
 // RCV_STATE_HDR1 functions
-static  U8    RcvStateHdr1Exc( TASKARG xArg );
+static  U8    RcvStateHdr1Exc( STATEEXECENGARG xArg );
 
 // RCV_STATE_DSTA functions
-static  U8    RcvStateDstaExc( TASKARG xArg );
+static  U8    RcvStateDstaExc( STATEEXECENGARG xArg );
 
 // RCV_STATE_SRCA functions
-static  U8    RcvStateSrcaExc( TASKARG xArg );
+static  U8    RcvStateSrcaExc( STATEEXECENGARG xArg );
 
 // RCV_STATE_CMND functions
-static  U8    RcvStateCmndExc( TASKARG xArg );
+static  U8    RcvStateCmndExc( STATEEXECENGARG xArg );
 
 // RCV_STATE_OPTN functions
-static  U8    RcvStateOptnExc( TASKARG xArg );
+static  U8    RcvStateOptnExc( STATEEXECENGARG xArg );
 
 // RCV_STATE_SEQN functions
-static  U8    RcvStateSeqnExc( TASKARG xArg );
+static  U8    RcvStateSeqnExc( STATEEXECENGARG xArg );
 
 // RCV_STATE_CTRL functions
-static  U8    RcvStateCtrlExc( TASKARG xArg );
+static  U8    RcvStateCtrlExc( STATEEXECENGARG xArg );
 
 // RCV_STATE_DATA functions
-static  U8    RcvStateDataExc( TASKARG xArg );
+static  U8    RcvStateDataExc( STATEEXECENGARG xArg );
 
 // RCV_STATE_CRCM functions
-static  U8    RcvStateCrcmExc( TASKARG xArg );
+static  U8    RcvStateCrcmExc( STATEEXECENGARG xArg );
 
 // RCV_STATE_CRCL functions
-static  U8    RcvStateCrclExc( TASKARG xArg );
+static  U8    RcvStateCrclExc( STATEEXECENGARG xArg );
 
 // constant parameter initializations -----------------------------------------
 /// initialize the idle events
@@ -156,7 +206,7 @@ static  const CODE STATEEXECENGTABLE  atRcvStates[ RCV_STATE_MAX ] =
 {
  STATEXECENGETABLE_ENTRY( RCV_STATE_IDLE, RcvStateIdleEnt, NULL,            RcvStateIdleExt, atIdleEvents        ),
  STATEXECENGETABLE_ENTRY( RCV_STATE_HDR1, NULL,            RcvStateHdr1Exc, NULL,            NULL                ),
- STATEXECENGETABLE_ENTRY( RCV_STATE_DSTA, NULL,            RcvStateDstaExc, NULL,            NULL                ),
+ STATEXECENGETABLE_ENTRY( RCV_STATE_DSTA, NULL,            RcvStateDstaExc, NULL,            atAnyStateEvents    ),
  STATEXECENGETABLE_ENTRY( RCV_STATE_SRCA, NULL,            RcvStateSrcaExc, NULL,            atAnyStateEvents    ),
  STATEXECENGETABLE_ENTRY( RCV_STATE_CMND, NULL,            RcvStateCmndExc, NULL,            atAnyStateEvents    ),
  STATEXECENGETABLE_ENTRY( RCV_STATE_OPTN, NULL,            RcvStateOptnExc, NULL,            atAnyStateEvents    ),
@@ -178,34 +228,46 @@ static  const CODE STATEEXECENGTABLE  atRcvStates[ RCV_STATE_MAX ] =
  *****************************************************************************/
  void BinaryProtocol_Initialize( void ) 
 {
-  BOOL        bStatus = TRUE;
   BINPROTENUM eProtEnum;
   PBINPROTDEF ptDef;
-  LCLCTL      ptCtl;
+  PLCLCTL     ptCtl;
   
   // for each defined protocol
-  for( eProtEnum = 0; eProtEnum < BINPROT_MAX_ENUM; eProtEnum++ )
+  for( eProtEnum = 0; eProtEnum < BINPROT_ENUM_MAX; eProtEnum++ )
   {
     // get the definition/control pointers
     ptDef = ( PBINPROTDEF )&atBinProtDefs[ eProtEnum ];
-    ptCtl = &atLclCtl[ eProtEnum ];
+    ptCtl = &anLclCtl[ eProtEnum ];
     
-    // set the checkmode/multdrop/sequence
+    // set the checkmode/multdrop/sequence/address/write function
     ptCtl->eCheckMode = ptDef->eCheckMode;
-    ptCtl->bMultiDropEnabled = ptDef->bMultiDropEnable;
+    ptCtl->bMultiDropEnabled = ptDef->bMultiDropMode;
     ptCtl->bSequenceEnabled = ptDef->bSequenceEnable;
-    ptCtl->nDeviceAddr = ptDef->nDeviceAddr
+    ptCtl->nDeviceAddr = ptDef->nDevAddress;
+    ptCtl->pvWriteFunc = ptDef->pvWriteFunc;
+    ptCtl->eLclSts = LCL_STS_IDLE;
     
-    // create the read thread/read semaphore
+    // create the read semaphore/transmit lock
     sem_init( &( ptCtl->tRcvMsgSem ), 0, 0 );
+    pthread_mutex_init( &( ptCtl->tXmtLock ), NULL );
+    ptCtl->bRcvWaiting = FALSE;
     
     // allocate the buffers
-    ptCtl->pnRcvBuffer = malloc( sizeof( U8 ) * ptDef->wXmtBufferSize );
-    ptCtl->pnXmtBuffer = malloc( sizeof( U8 ) * ptDef->wRcvBufferSize );
+    ptCtl->pnRcvBuffer = malloc( sizeof( U8 ) * ptDef->wRcvBufferSize );
+    ptCtl->pnXmtBuffer = malloc( sizeof( U8 ) * ptDef->wXmtBufferSize );
+    ptCtl->wRcvBufSize = ptDef->wRcvBufferSize;
+    ptCtl->wXmtBufSize = ptDef->wXmtBufferSize;
     
     // set the state engine/initialize the state
     ptCtl->tStateCtl.ptStates = atRcvStates;
     StateExecutionEngine_Initialize( &( ptCtl->tStateCtl ), RCV_STATE_IDLE );
+    
+    #if ( BINPROT_ENABLE_WINDOW == 1 )
+    // clear the window
+    memset( ptCtl->atWindow, 0, sizeof( ptCtl->atWindow ));
+    ptCtl->nNextSequence = 0;
+    ptCtl->nRcvSequence = 0;
+    #endif // BINPROT_ENABLE_WINDOW
   }
 }
  
@@ -241,46 +303,117 @@ BINPROTMSGSTS BinaryProtocol_Close( BINPROTENUM eProtEnum )
 void BinaryProtocol_ProcessCharCallback( BINPROTENUM eProtEnum, U8 nData )
 {
   // get the definition/control pointers
-  ptCurCtl = &atLclCtl[ eProtEnum ];
+  ptCurCtl = &anLclCtl[ eProtEnum ];
   
-  // now determine the check method
-  switch( ptCurCtl->eCheckMode )
+  // add the character to the check value, the check bytes are not part of it
+  if (( ptCurCtl->tStateCtl.nCurState != RCV_STATE_CRCM ) && ( ptCurCtl->tStateCtl.nCurState != RCV_STATE_CRCL ))
   {
-    case BINPROT_CHECKMODE_EOR :
-      // exclusive OR with previous
-      ptCurCtl->tRcvCheckValue.anValue[ LE_U16_LSB_IDX ] ^= nData;
-      break;
-      
-    case BINPROT_CHECKMODE_CSM :
-      // just add
-      ptCurCtl->tRcvCheckValue.anValue[ LE_U16_LSB_IDX ] += nData;
-      break;
-      
-    case BINPROT_CHECKMODE_CRC :
-      // add the value to the CRC
-      ptCurCtl->tRcvCheckValue.wValue = CRC16_CalculateByte( ptCurCtl->tRcvCheckValue.wValue, nData );
-      break;
-      
-    default :
-      break;
+    UpdateCheckValue( ptCurCtl->eCheckMode, &( ptCurCtl->tRcvCheckValue ), &nData, 1 );
   }
   
   // process the event through the state engine
   StateExecutionEngine_Process( &( ptCurCtl->tStateCtl ), nData );
   
   // determine if we have a message
-  switch( eLclSts )
+  switch( ptCurCtl->eLclSts )
   {
     case LCL_STS_RCVD :
+      // set the data pointer/length/clear the status
+      ptCurCtl->tRcvMessage.pnMessage = ptCurCtl->pnRcvBuffer;
+      ptCurCtl->tRcvMessage.wLength = ptCurCtl->wRcvBufIndex;
+      ptCurCtl->eLclSts = LCL_STS_IDLE;
+      
+      #if ( BINPROT_ENABLE_WINDOW == 1 )
+      // complete an outstanding request if the sequence matches
+      if ( CompleteRequest( ptCurCtl ))
+      {
+        break;
+      }
+      #endif // BINPROT_ENABLE_WINDOW
+      
+      // post the semaphore if a caller is waiting, otherwise drop it
+      PostWaiter( ptCurCtl );
+      break;
+      
     case LCL_STS_CHKERR :
-      // post the semaphore 
-      sem_post( &( ptCurCtl->tRcvMsgSem ));
+      // clear the status
+      ptCurCtl->eLclSts = LCL_STS_IDLE;
+      
+      #if ( BINPROT_ENABLE_WINDOW == 0 )
+      // post the semaphore if a caller is waiting, with the window it can not be matched so drop it
+      PostWaiter( ptCurCtl );
+      #endif // BINPROT_ENABLE_WINDOW
       break;
       
     default :
       break;
   }    
 }
+
+/******************************************************************************
+ * @function BinaryProtocol_ProcessBlockCallback
+ *
+ * @brief process a block of received characters
+ *
+ * This function will process a whole receive buffer.  While in the data state,
+ * the escape free span up to the next DLE is copied to the receive buffer and
+ * added to the check value in one pass, all other characters are run through
+ * the state engine one at a time
+ *
+ * @param[in]   eProtEnum protocol enumeration
+ * @param[in]   pnData    pointer to the received data
+ * @param[in]   wLength   number of bytes received
+ *
+ *****************************************************************************/
+void BinaryProtocol_ProcessBlockCallback( BINPROTENUM eProtEnum, PU8 pnData, U16 wLength )
+{
+  PLCLCTL ptCtl;
+  PU8     pnDle;
+  U16     wSpan;
+  
+  // get the control pointer
+  ptCtl = &anLclCtl[ eProtEnum ];
+  
+  // process all data
+  while ( wLength != 0 )
+  {
+    // clear the span
+    wSpan = 0;
+    
+    // check for data state
+    if ( ptCtl->tStateCtl.nCurState == RCV_STATE_DATA )
+    {
+      // find the next DLE/compute the span up to it
+      pnDle = memchr( pnData, CH_DLE, wLength );
+      wSpan = ( pnDle != NULL ) ? ( U16 )( pnDle - pnData ) : wLength;
+      
+      // only copy in bulk if it fits, let the state engine handle the overflow
+      if ( wSpan > ( ptCtl->wRcvBufSize - ptCtl->wRcvBufIndex ))
+      {
+        wSpan = 0;
+      }
+    }
+    
+    // check for a span
+    if ( wSpan != 0 )
+    {
+      // copy it/add it to the check value
+      memcpy( ptCtl->pnRcvBuffer + ptCtl->wRcvBufIndex, pnData, wSpan );
+      ptCtl->wRcvBufIndex += wSpan;
+      UpdateCheckValue( ptCtl->eCheckMode, &( ptCtl->tRcvCheckValue ), pnData, wSpan );
+    }
+    else
+    {
+      // process a single character
+      BinaryProtocol_ProcessCharCallback( eProtEnum, *( pnData ));
+      wSpan = 1;
+    }
+    
+    // adjust the pointer/length
+    pnData += wSpan;
+    wLength -= wSpan;
+  }
+}
   
 /******************************************************************************
  * @function BinaryProtocol_SendRcvMessage
@@ -288,7 +421,8 @@ void BinaryProtocol_ProcessCharCallback( BINPROTENUM eProtEnum, U8 nData )
  * @brief send a message and wait for a return messageout on the serial port
  *
  * This function will send a message and wait for a returned message if timeout
- * is not negative
+ * is not negative.  With the window enabled, the sequence number is drawn from
+ * the window and reserved until the response arrives or the wait times out
  *
  * @param[in]   eProtEnum protocol enumeration
  * @param[in]   ptXmtMessage  pointer to the message structure
@@ -300,20 +434,40 @@ void BinaryProtocol_ProcessCharCallback( BINPROTENUM eProtEnum, U8 nData )
  *****************************************************************************/
 BINPROTMSGSTS BinaryProtocol_SendRcvMessage( BINPROTENUM eProtEnum, PBINPROTMSG ptXmtMessage, PBINPROTMSG ptRcvMessage, S16 sTimeoutMsec )
 {
-  BINPROTMSGSTS   eMsgStatus = BINPROT_MSGSTS_OK;
-  U16             wBytesWritten;
+  BINPROTMSGSTS   eMsgStatus = BINPROT_MSGSTS_OKAY;
   struct timespec tTime;
   int             iSemWaitResult;
-  LCLCTL          ptCtl;
+  PLCLCTL         ptCtl;
   
   // get the pointer to the local control
-  ptCtl = &atLclCtl[ eProtEnum ];
+  ptCtl = &anLclCtl[ eProtEnum ];
   
-  // format the message
-  FormatMessage( ptCtl, ptXmtMessage );
+  // lock the window/waiter
+  Interrupt_Disable( );
   
-  // now send it
-  ptCtl->pvWriteFunc( anXmtBuffer, wXmtBufIndex );
+  #if ( BINPROT_ENABLE_WINDOW == 1 )
+  // draw the sequence number from the window so it can not match an outstanding request
+  if ( ptCtl->bSequenceEnabled )
+  {
+    ptXmtMessage->nSequence = AllocSequence( ptCtl );
+    ptCtl->nRcvSequence = ptXmtMessage->nSequence;
+  }
+  #endif // BINPROT_ENABLE_WINDOW
+  
+  // flag the waiter before sending so the response can not be missed
+  if ( sTimeoutMsec > 0 )
+  {
+    ptCtl->bRcvWaiting = TRUE;
+  }
+  
+  // unlock the window/waiter
+  Interrupt_Enable( );
+  
+  // lock the transmit buffer/format the message/send it/unlock
+  pthread_mutex_lock( &( ptCtl->tXmtLock ));
+  FormatMessage( ptCtl, ptXmtMessage );
+  ptCtl->pvWriteFunc( ptCtl->pnXmtBuffer, ptCtl->wXmtBufIndex );
+  pthread_mutex_unlock( &( ptCtl->tXmtLock ));
   
   // now check for a timeout on receive
   if ( sTimeoutMsec > 0 )
@@ -321,8 +475,10 @@ BINPROTMSGSTS BinaryProtocol_SendRcvMessage( BINPROTENUM eProtEnum, PBINPROTMSG
     // get the current time
     clock_gettime( CLOCK_REALTIME, &tTime );
     
-    // add the time in nanoseconds
-    set_normalized_timespec( &tTime, 0, ( sTimeoutMsec * 1000000 ));
+    // add the time in nanoseconds/normalize it
+    tTime.tv_nsec += ( long )sTimeoutMsec * NSECS_PER_MSEC;
+    tTime.tv_sec += tTime.tv_nsec / NSECS_PER_SEC;
+    tTime.tv_nsec %= NSECS_PER_SEC;
     
     // wait for the receive message event
     while (( iSemWaitResult = sem_timedwait( &( ptCtl->tRcvMsgSem ), &tTime )) == -1 && ( errno == EINTR))
@@ -331,6 +487,15 @@ BINPROTMSGSTS BinaryProtocol_SendRcvMessage( BINPROTENUM eProtEnum, PBINPROTMSG
       continue;
     }
     
+    // on a timeout clear the waiter, picking up a post that raced the timeout
+    if ( iSemWaitResult == -1 )
+    {
+      Interrupt_Disable( );
+      ptCtl->bRcvWaiting = FALSE;
+      iSemWaitResult = sem_trywait( &( ptCtl->tRcvMsgSem ));
+      Interrupt_Enable( );
+    }
+    
     // now determine the result
     if ( iSemWaitResult == -1 )
     {
@@ -351,27 +516,158 @@ BINPROTMSGSTS BinaryProtocol_SendRcvMessage( BINPROTENUM eProtEnum, PBINPROTMSG
   return( eMsgStatus );
 }
  
+#if ( BINPROT_ENABLE_WINDOW == 1 )
 /******************************************************************************
- * @function StuffXmtBuffer
+ * @function BinaryProtocol_PostMessage
  *
- * @brief stuff the transmit buffer
+ * @brief post a request without waiting for the response
  *
- * This function will stuff a value into the transmit buffer
+ * This function will assign the next free sequence number to the request,
+ * record it in the window and send it.  The completion callback is called from
+ * the receive callback when the response with the same sequence number arrives,
+ * or from BinaryProtocol_ProcessTimeouts if it does not arrive in time
+ *
+ * @param[in]   eProtEnum     protocol enumeration
+ * @param[in]   ptXmtMessage  pointer to the message structure
+ * @param[in]   wTimeoutMsec  timeout in milliseconds
+ * @param[in]   pvComplete    completion callback
+ * @param[in]   pvArg         callback argument
+ *
+ * @return      appropriate message status
+ *
+ *****************************************************************************/
+BINPROTMSGSTS BinaryProtocol_PostMessage( BINPROTENUM eProtEnum, PBINPROTMSG ptXmtMessage, U16 wTimeoutMsec, PVBINPROTCOMPLETE pvComplete, PVOID pvArg )
+{
+  BINPROTMSGSTS eMsgStatus = BINPROT_MSGSTS_WINFULL;
+  PLCLCTL       ptCtl;
+  PWINSLOT      ptFree;
+  U8            nIdx, nSequence;
+  
+  // get the pointer to the local control
+  ptCtl = &anLclCtl[ eProtEnum ];
+  
+  // the responses are matched by sequence number
+  if ( !ptCtl->bSequenceEnabled )
+  {
+    // set the error
+    eMsgStatus = BINPROT_MSGSTS_ILLMODE;
+  }
+  else
+  {
+    // lock the window, the receive callback completes requests from a signal handler
+    Interrupt_Disable( );
+    
+    // find a free slot
+    for ( nIdx = 0, ptFree = NULL; ( nIdx < BINPROT_WINDOW_SIZE ) && ( ptFree == NULL ); nIdx++ )
+    {
+      ptFree = ( ptCtl->atWindow[ nIdx ].bActive ) ? NULL : &ptCtl->atWindow[ nIdx ];
+    }
+    
+    // check for a slot
+    if ( ptFree != NULL )
+    {
+      // fill the slot
+      nSequence = AllocSequence( ptCtl );
+      ptFree->bActive = TRUE;
+      ptFree->nSequence = nSequence;
+      ptFree->uDeadlineMsec = GetTimeMsec( ) + wTimeoutMsec;
+      ptFree->pvComplete = pvComplete;
+      ptFree->pvArg = pvArg;
+    }
+    
+    // unlock the window
+    Interrupt_Enable( );
+    
+    // check for a slot
+    if ( ptFree != NULL )
+    {
+      // lock the transmit buffer/format the message/send it/unlock
+      ptXmtMessage->nSequence = nSequence;
+      pthread_mutex_lock( &( ptCtl->tXmtLock ));
+      FormatMessage( ptCtl, ptXmtMessage );
+      ptCtl->pvWriteFunc( ptCtl->pnXmtBuffer, ptCtl->wXmtBufIndex );
+      pthread_mutex_unlock( &( ptCtl->tXmtLock ));
+    
+      // set the status
+      eMsgStatus = BINPROT_MSGSTS_OKAY;
+    }
+  }
+  
+  // return the message status
+  return( eMsgStatus );
+}
+
+/******************************************************************************
+ * @function BinaryProtocol_ProcessTimeouts
+ *
+ * @brief process the request timeouts
+ *
+ * This function will complete each outstanding request that has expired with
+ * a timeout status.  It should be called periodically
+ *
+ * @param[in]   eProtEnum     protocol enumeration
+ *
+ *****************************************************************************/
+void BinaryProtocol_ProcessTimeouts( BINPROTENUM eProtEnum )
+{
+  PLCLCTL           ptCtl;
+  PWINSLOT          ptSlot;
+  PVBINPROTCOMPLETE pvComplete;
+  PVOID             pvArg;
+  U32               uNow;
+  U8                nIdx;
+  
+  // get the pointer to the local control/current time
+  ptCtl = &anLclCtl[ eProtEnum ];
+  uNow = GetTimeMsec( );
+  
+  // check each slot
+  for ( nIdx = 0; nIdx < BINPROT_WINDOW_SIZE; nIdx++ )
+  {
+    // free the slot if expired
+    pvComplete = NULL;
+    ptSlot = &ptCtl->atWindow[ nIdx ];
+    Interrupt_Disable( );
+    if (( ptSlot->bActive ) && (( S32 )( uNow - ptSlot->uDeadlineMsec ) >= 0 ))
+    {
+      ptSlot->bActive = FALSE;
+      pvComplete = ptSlot->pvComplete;
+      pvArg = ptSlot->pvArg;
+    }
+    Interrupt_Enable( );
+    
+    // call the completion outside of the lock
+    if ( pvComplete != NULL )
+    {
+      pvComplete( BINPROT_MSGSTS_TIMEOUT, NULL, pvArg );
+    }
+  }
+}
+#endif // BINPROT_ENABLE_WINDOW
+ 
+/******************************************************************************
+ * @function FormatMessage
+ *
+ * @brief format a message
+ *
+ * This function will format a message into the transmit buffer
  *
  * @param[in]   ptCtl     pointer to the control structure
- * @param[in]   ptpMessage  pointer to the message
+ * @param[in]   ptMessage pointer to the message
  *
  *****************************************************************************/
 static void FormatMessage( PLCLCTL ptCtl, PBINPROTMSG ptMessage )
 {
+  U16UN tCheckValue;
+  
   // clear the buffer pointer
   ptCtl->wXmtBufIndex = 0;
   
   // initialize the check value
-  if ( ptCtl->eCheckMode == BINPROT_CHECKMODE_CRC )
+  if ( ptCtl->eCheckMode == BINPROT_CHKMODE_CRC )
   {
     // initialize the CRC initial value
-    ptCtl->tXmtCheckValue.wValue = CRC16_GetDefaultValue( );
+    ptCtl->tXmtCheckValue.wValue = CRC16_GetInitialValue( );
   }
   else
   {
@@ -380,67 +676,67 @@ static void FormatMessage( PLCLCTL ptCtl, PBINPROTMSG ptMessage )
   }
   
   // stuff the header
-  StuffMsgBuffer( ptCtl, CH_DLE, FALSE );
-  StuffMsgBuffer( ptCtl, CH_SOH, FALSE );
+  StuffXmtBuffer( ptCtl, CH_DLE, FALSE );
+  StuffXmtBuffer( ptCtl, CH_SOH, FALSE );
   
   // now determine if we are in multidrop mode
   if ( ptCtl->bMultiDropEnabled )
   {
     // stuff the destination/source address
-    StuffMsgBuffer( ptCtl, ptMessage->nDstAdr, TRUE );
-    StuffMsgBuffer( ptCtl, ptMessage->nSrcAdr, TRUE );
+    StuffXmtBuffer( ptCtl, ptMessage->nDstAddr, TRUE );
+    StuffXmtBuffer( ptCtl, ptMessage->nSrcAddr, TRUE );
   }
   
   // stuff the command/option bytes
-  StuffMsgBuffer( ptCtl, ptMessage->nCommand, TRUE );
-  StuffMsgBuffer( ptCtl, ptMessage->nOption, TRUE );
+  StuffXmtBuffer( ptCtl, ptMessage->nCommand, TRUE );
+  StuffXmtBuffer( ptCtl, ptMessage->nOption, TRUE );
   
   // check for sequence
   if ( ptCtl->bSequenceEnabled )
   {
     // stuff it
-    StuffMsgBuffer( ptCtl, ptMessage->nSequence, TRUE );
+    StuffXmtBuffer( ptCtl, ptMessage->nSequence, TRUE );
   }
   
   // now test for data
   if ( ptMessage->wLength != 0 )
   {
     // stuff the data control sequence
-    StuffMsgBuffer( ptCtl, CH_DLE, FALSE );
-    StuffMsgBuffer( ptCtl, CH_STX, FALSE );
+    StuffXmtBuffer( ptCtl, CH_DLE, FALSE );
+    StuffXmtBuffer( ptCtl, CH_STX, FALSE );
     
     // now stuff the data
-    while( ptMessage->wLength-- != 0 )
-    {
-      StuffMsgBuffer( ptCtl, *( ptMessage->pnMessage++ ), TRUE );
-    }
+    StuffXmtBlock( ptCtl, ptMessage->pnMessage, ptMessage->wLength );
   }
   
   // stuff the end of message sequence
-  StuffMsgBuffer( ptCtl, CH_DLE, FALSE );
-  StuffMsgBuffer( ptCtl, CH_ETX, FALSE );
+  StuffXmtBuffer( ptCtl, CH_DLE, FALSE );
+  StuffXmtBuffer( ptCtl, CH_EOT, FALSE );
+  
+  // copy the check value, stuffing the check bytes updates the running one
+  tCheckValue = ptCtl->tXmtCheckValue;
   
   // now determine the check method
   switch( ptCtl->eCheckMode )
   {
-    case BINPROT_CHECKMODE_EOR :
+    case BINPROT_CHKMODE_EOR :
       // stuff it
-      StuffMsgBuffer( ptCtl, ptCtl->tXmtCheckValue.anValue[ LE_U16_LSB_IDX ];
+      StuffXmtBuffer( ptCtl, tCheckValue.anValue[ LE_U16_LSB_IDX ], FALSE );
       break;
       
-    case BINPROT_CHECKMODE_CSM :
+    case BINPROT_CHKMODE_CSM :
       // 2's complement the checksum
-      ptCtl->tXmtCheckValue.anValue[ LE_U16_LSB_IDX ] = ~ptCtl->tXmtCheckValue.anValue[ LE_U16_LSB_IDX ];
-      ptCtl->tXmtCheckValue.anValue[ LE_U16_LSB_IDX ]++;
+      tCheckValue.anValue[ LE_U16_LSB_IDX ] = ~tCheckValue.anValue[ LE_U16_LSB_IDX ];
+      tCheckValue.anValue[ LE_U16_LSB_IDX ]++;
       
       // stuff it
-      StuffMsgBuffer( ptCtl, tXmtCheckValue.anValue[ LE_U16_LSB_IDX ];
+      StuffXmtBuffer( ptCtl, tCheckValue.anValue[ LE_U16_LSB_IDX ], FALSE );
       break;
       
-    case BINPROT_CHECKMODE_CRC :
+    case BINPROT_CHKMODE_CRC :
       // stuff the CRC - big endian
-      StuffMsgBuffer( ptCtl, ptCtl->tXmtCheckValue.anValue[ LE_U16_MSB_IDX ]);
-      StuffMsgBuffer( ptCtl, ptCtl->tXmtCheckValue.anValue[ LE_U16_LSB_IDX ]);
+      StuffXmtBuffer( ptCtl, tCheckValue.anValue[ LE_U16_MSB_IDX ], FALSE );
+      StuffXmtBuffer( ptCtl, tCheckValue.anValue[ LE_U16_LSB_IDX ], FALSE );
       break;
       
     default :
@@ -456,42 +752,23 @@ static void FormatMessage( PLCLCTL ptCtl, PBINPROTMSG ptMessage )
  * This function will stuff a value into the transmit buffer
  *
  * @param[in]   ptCtl     pointer to the control structure
- * @param[in]   nData     data to stuff
- * @param[in]   bEnable   enable the data stuff
+ * @param[in]   nData         data to stuff
+ * @param[in]   bStuffEnable  enable the data stuff
  *
  *****************************************************************************/
-void StuffXmtBuffer( PLCLCTL ptCtl, PLCLCTL ptCtl, U8 nData, BOOL bEnable )
+static void StuffXmtBuffer( PLCLCTL ptCtl, U8 nData, BOOL bStuffEnable )
 {
   // ensure there is room
-  if ( ptCtl->wXmtBufIndex < MAX_XMTBUF_SIZE )
+  if ( ptCtl->wXmtBufIndex < ptCtl->wXmtBufSize )
   {
     // stuff the value
-    ptCtl->anXmtBuffer[ ptCtl->wXmtBufIndex++ ] = nData;
+    ptCtl->pnXmtBuffer[ ptCtl->wXmtBufIndex++ ] = nData;
     
-    // now determine the check method
-    switch( ptCtl->eCheckMode )
-    {
-      case BINPROT_CHECKMODE_EOR :
-        // exclusive OR with previous
-        ptCtl->tXmtCheckValue.anValue[ LE_U16_LSB_IDX ] ^= nData;
-        break;
-        
-      case BINPROT_CHECKMODE_CSM :
-        // just add
-        ptCtl->tXmtCheckValue.anValue[ LE_U16_LSB_IDX ] += nData;
-        break;
-        
-      case BINPROT_CHECKMODE_CRC :
-        // add the value to the CRC
-        ptCtl->tXmtCheckValue.wValue = CRC16_CalculateByte( ptCtl->tXmtCheckValue.wValue, nData );
-        break;
-        
-      default :
-        break;
-    }
+    // add it to the check value
+    UpdateCheckValue( ptCtl->eCheckMode, &( ptCtl->tXmtCheckValue ), &nData, 1 );
     
     // now check for stuff enable and data equal to CH_DLE
-    if (( bEnable == TRUE ) && ( nData == CH_DLE ))
+    if (( bStuffEnable == TRUE ) && ( nData == CH_DLE ))
     {
       // stuff the special character
       StuffXmtBuffer( ptCtl, CH_SPC, FALSE );
@@ -499,6 +776,239 @@ void StuffXmtBuffer( PLCLCTL ptCtl, PLCLCTL ptCtl, U8 nData, BOOL bEnable )
   }
 }
 
+/******************************************************************************
+ * @function StuffXmtBlock
+ *
+ * @brief stuff a block into the transmit buffer
+ *
+ * This function will search for each DLE, copy the escape free span up to and
+ * including it into the transmit buffer in one pass, add the span to the check
+ * value and then stuff the special character after the DLE
+ *
+ * @param[in]   ptCtl     pointer to the control structure
+ * @param[in]   pnData    pointer to the data
+ * @param[in]   wLength   number of bytes to stuff
+ *
+ *****************************************************************************/
+static void StuffXmtBlock( PLCLCTL ptCtl, PU8 pnData, U16 wLength )
+{
+  PU8 pnDle;
+  U16 wSpan;
+  
+  // stuff all data
+  while ( wLength != 0 )
+  {
+    // find the next DLE/compute the span including it
+    pnDle = memchr( pnData, CH_DLE, wLength );
+    wSpan = ( pnDle != NULL ) ? ( U16 )( pnDle - pnData ) + 1 : wLength;
+    
+    // limit it to the room left, exit if full
+    wSpan = MIN( wSpan, ptCtl->wXmtBufSize - ptCtl->wXmtBufIndex );
+    if ( wSpan == 0 )
+    {
+      break;
+    }
+    
+    // copy it/add it to the check value
+    memcpy( ptCtl->pnXmtBuffer + ptCtl->wXmtBufIndex, pnData, wSpan );
+    UpdateCheckValue( ptCtl->eCheckMode, &( ptCtl->tXmtCheckValue ), pnData, wSpan );
+    ptCtl->wXmtBufIndex += wSpan;
+    pnData += wSpan;
+    wLength -= wSpan;
+    
+    // if the span ended with a DLE, stuff the special character
+    if ( *( pnData - 1 ) == CH_DLE )
+    {
+      StuffXmtBuffer( ptCtl, CH_SPC, FALSE );
+    }
+  }
+}
+
+/******************************************************************************
+ * @function UpdateCheckValue
+ *
+ * @brief add a block to a check value
+ *
+ * This function will add the block to the check value using the check mode
+ *
+ * @param[in]   eCheckMode  check mode
+ * @param[in]   ptCheck     pointer to the check value
+ * @param[in]   pnData      pointer to the data
+ * @param[in]   wLength     number of bytes to add
+ *
+ *****************************************************************************/
+static void UpdateCheckValue( BINPROTCHKMODE eCheckMode, PU16UN ptCheck, PU8 pnData, U16 wLength )
+{
+  U8  nValue;
+  
+  // now determine the check method
+  switch( eCheckMode )
+  {
+    case BINPROT_CHKMODE_EOR :
+      // exclusive OR with previous
+      nValue = ptCheck->anValue[ LE_U16_LSB_IDX ];
+      while ( wLength-- != 0 )
+      {
+        nValue ^= *( pnData++ );
+      }
+      ptCheck->anValue[ LE_U16_LSB_IDX ] = nValue;
+      break;
+      
+    case BINPROT_CHKMODE_CSM :
+      // just add
+      nValue = ptCheck->anValue[ LE_U16_LSB_IDX ];
+      while ( wLength-- != 0 )
+      {
+        nValue += *( pnData++ );
+      }
+      ptCheck->anValue[ LE_U16_LSB_IDX ] = nValue;
+      break;
+      
+    case BINPROT_CHKMODE_CRC :
+      // add the block to the CRC
+      ptCheck->wValue = CRC16_Update( ptCheck->wValue, pnData, wLength );
+      break;
+      
+    default :
+      break;
+  }
+}
+
+/******************************************************************************
+ * @function PostWaiter
+ *
+ * @brief post the receive semaphore
+ *
+ * This function will post the receive semaphore if a caller of 
+ * BinaryProtocol_SendRcvMessage is waiting, otherwise the message is dropped.
+ * With the window enabled, the sequence number must also match the one the
+ * waiter reserved
+ *
+ * @param[in]   ptCtl     pointer to the control structure
+ *
+ *****************************************************************************/
+static void PostWaiter( PLCLCTL ptCtl )
+{
+  BOOL  bMatch = TRUE;
+  
+  // test and clear the waiter flag
+  Interrupt_Disable( );
+  #if ( BINPROT_ENABLE_WINDOW == 1 )
+  // a late response to an expired request must not complete the waiter
+  if ( ptCtl->bSequenceEnabled )
+  {
+    bMatch = ( ptCtl->tRcvMessage.nSequence == ptCtl->nRcvSequence ) ? TRUE : FALSE;
+  }
+  #endif // BINPROT_ENABLE_WINDOW
+  if (( ptCtl->bRcvWaiting ) && ( bMatch ))
+  {
+    // clear it/post the semaphore
+    ptCtl->bRcvWaiting = FALSE;
+    sem_post( &( ptCtl->tRcvMsgSem ));
+  }
+  Interrupt_Enable( );
+}
+
+#if ( BINPROT_ENABLE_WINDOW == 1 )
+/******************************************************************************
+ * @function CompleteRequest
+ *
+ * @brief complete an outstanding request
+ *
+ * This function will search the window for the request with the sequence 
+ * number of the received message, free its slot and call its completion
+ *
+ * @param[in]   ptCtl     pointer to the control structure
+ *
+ * @return      TRUE if a request was completed
+ *
+ *****************************************************************************/
+static BOOL CompleteRequest( PLCLCTL ptCtl )
+{
+  PWINSLOT          ptSlot;
+  PVBINPROTCOMPLETE pvComplete = NULL;
+  PVOID             pvArg = NULL;
+  U8                nIdx;
+  
+  // find the matching slot/free it
+  Interrupt_Disable( );
+  for ( nIdx = 0, ptSlot = ptCtl->atWindow; nIdx < BINPROT_WINDOW_SIZE; nIdx++, ptSlot++ )
+  {
+    if (( ptSlot->bActive ) && ( ptSlot->nSequence == ptCtl->tRcvMessage.nSequence ))
+    {
+      ptSlot->bActive = FALSE;
+      pvComplete = ptSlot->pvComplete;
+      pvArg = ptSlot->pvArg;
+      break;
+    }
+  }
+  Interrupt_Enable( );
+  
+  // call the completion outside of the lock
+  if ( pvComplete != NULL )
+  {
+    pvComplete( BINPROT_MSGSTS_RCVOKAY, &( ptCtl->tRcvMessage ), pvArg );
+  }
+  
+  // return the status
+  return(( nIdx < BINPROT_WINDOW_SIZE ) ? TRUE : FALSE );
+}
+
+/******************************************************************************
+ * @function AllocSequence
+ *
+ * @brief allocate a sequence number
+ *
+ * This function will return the next sequence number that is neither 
+ * outstanding in the window nor reserved by a waiting caller of
+ * BinaryProtocol_SendRcvMessage.  It must be called with interrupts disabled
+ *
+ * @param[in]   ptCtl     pointer to the control structure
+ *
+ * @return      the sequence number
+ *
+ *****************************************************************************/
+static U8 AllocSequence( PLCLCTL ptCtl )
+{
+  PWINSLOT  ptSlot;
+  U8        nIdx;
+  BOOL      bInUse;
+  
+  // skip the sequence numbers in use
+  do
+  {
+    bInUse = (( ptCtl->bRcvWaiting ) && ( ptCtl->nRcvSequence == ptCtl->nNextSequence ));
+    for ( nIdx = 0, ptSlot = ptCtl->atWindow; nIdx < BINPROT_WINDOW_SIZE; nIdx++, ptSlot++ )
+    {
+      bInUse |= (( ptSlot->bActive ) && ( ptSlot->nSequence == ptCtl->nNextSequence ));
+    }
+    ptCtl->nNextSequence += ( bInUse ) ? 1 : 0;
+  } while ( bInUse );
+  
+  // return it/advance to the next
+  return( ptCtl->nNextSequence++ );
+}
+
+/******************************************************************************
+ * @function GetTimeMsec
+ *
+ * @brief get the current time
+ *
+ * This function returns the monotonic time in milliseconds
+ *
+ * @return      current time in milliseconds
+ *
+ *****************************************************************************/
+static U32 GetTimeMsec( void )
+{
+  struct timespec tTime;
+  
+  // get the time/convert it
+  clock_gettime( CLOCK_MONOTONIC, &tTime );
+  return(( U32 )(( tTime.tv_sec * 1000 ) + ( tTime.tv_nsec / 1000000 )));
+}
+#endif // BINPROT_ENABLE_WINDOW
+
 /******************************************************************************
  * @function CheckAddress
  *
@@ -506,6 +1016,7 @@ void StuffXmtBuffer( PLCLCTL ptCtl, PLCLCTL ptCtl, U8 nData, BOOL bEnable )
  *
  * This function checks to see if this message matches our address 
  *
+ * @param[in]   ptCtl   pointer to the control structure
  * @param[in]   nAddr   address received
  *
  * @return      TRUE if address matches our address or broadcast
@@ -516,7 +1027,7 @@ static BOOL CheckAddress( PLCLCTL ptCtl, U8 nAddr )
   BOOL bAddrMatch = FALSE;
   
   // check to see if this is our local address or a broadcast address
-  if (( nAddr == ptLclCtl->nLclAddr ) || ( nAddr == BINPROT_BROADCAST_ADDR ))
+  if (( nAddr == ptCtl->nDeviceAddr ) || ( nAddr == BINPROT_BROADCAST_ADDR ))
   {
     // set address match
     bAddrMatch = TRUE;
@@ -529,10 +1040,11 @@ static BOOL CheckAddress( PLCLCTL ptCtl, U8 nAddr )
 /******************************************************************************
  * @function StuffRcvData
  *
- * @brief stuff data into the transmite buffer
+ * @brief stuff data into the receive buffer
  *
  * This function stuffs a byte of data into the receive buffer if room 
  *
+ * @param[in]   ptCtl       pointer to the control structure
  * @param[in]   nRcvChar    character received
  *
  * @return      TRUE if no error, FALSE if no room
@@ -543,13 +1055,10 @@ static BOOL StuffRcvData( PLCLCTL ptCtl, U8 nRcvChar )
   BOOL  eStatus = FALSE;
   
   // check for room
-  if ( ptLclCtl->tRcvBuffer.wIndex < ptLclDef->wRcvBufferSize )
+  if ( ptCtl->wRcvBufIndex < ptCtl->wRcvBufSize )
   {
-    // get the pointer to the buffer
-    pnBuffer = ( PU8 )ptLclDef->pnRcvBuffer;
-    
     // store it
-    *( pnBuffer + ptLclCtl->tRcvBuffer.wIndex++ ) = nRcvChar;
+    *( ptCtl->pnRcvBuffer + ptCtl->wRcvBufIndex++ ) = nRcvChar;
 
     // set good status
     eStatus = TRUE;
@@ -578,7 +1087,7 @@ static void RcvStateIdleExt( void )
 /******************************************************************************
  * RCV_STATE_HDR1 functions
  *****************************************************************************/
-static U8 RcvStateHdr1Exc( TASKARG xArg )
+static U8 RcvStateHdr1Exc( STATEEXECENGARG xArg )
 {
   U8  nNextState;
   
@@ -591,18 +1100,18 @@ static U8 RcvStateHdr1Exc( TASKARG xArg )
     // reset the CRC
     switch( ptCurCtl->eCheckMode )
     {
-      case BINCMD_CHECKMODE_EOR :
-        ptCurCtl->tRcvChkValue.anValue[ LE_U16_LSB_IDX ] = CH_DLE ^ CH_SOH;
+      case BINPROT_CHKMODE_EOR :
+        ptCurCtl->tRcvCheckValue.anValue[ LE_U16_LSB_IDX ] = CH_DLE ^ CH_SOH;
         break;
         
-      case BINCMD_CHECKMODE_CMP :
-        ptCurCtl->tRcvChkValue.anValue[ LE_U16_LSB_IDX ] = CH_DLE + CH_SOH;
+      case BINPROT_CHKMODE_CSM :
+        ptCurCtl->tRcvCheckValue.anValue[ LE_U16_LSB_IDX ] = CH_DLE + CH_SOH;
         break;
         
-      case BINCMD_CHECKMODE_CRC :
-        ptCurCtl->tRcvChkValue.wValue = CRC16_GetInitialValue( );
-        ptCurCtl->tRcvChkValue.wValue = CRC16_CalculateByte( ptCurCtl->tRcvChkValue.wValue, CH_DLE );
-        ptCurCtl->tRcvChkValue.wValue = CRC16_CalculateByte( ptCurCtl->tRcvChkValue.wValue, CH_SOH );
+      case BINPROT_CHKMODE_CRC :
+        ptCurCtl->tRcvCheckValue.wValue = CRC16_GetInitialValue( );
+        ptCurCtl->tRcvCheckValue.wValue = CRC16_CalculateByte( ptCurCtl->tRcvCheckValue.wValue, CH_DLE );
+        ptCurCtl->tRcvCheckValue.wValue = CRC16_CalculateByte( ptCurCtl->tRcvCheckValue.wValue, CH_SOH );
         break;
         
       default :
@@ -610,7 +1119,7 @@ static U8 RcvStateHdr1Exc( TASKARG xArg )
     }
     
     // set the next state
-    nNextState = ( ptCurCtl->bMultiDropModeEnabled == TRUE ) ? RCV_STATE_DSTA : RCV_STATE_CMND;
+    nNextState = ( ptCurCtl->bMultiDropEnabled == TRUE ) ? RCV_STATE_DSTA : RCV_STATE_CMND;
   }
   else
   {
@@ -625,7 +1134,7 @@ static U8 RcvStateHdr1Exc( TASKARG xArg )
 /******************************************************************************
  * RCV_STATE_DSTA functions
  *****************************************************************************/
-static U8 RcvStateDstaExc( TASKARG xArg )
+static U8 RcvStateDstaExc( STATEEXECENGARG xArg )
 {
   // if this is our address, next state is source/otherwise idle
   return(( CheckAddress( ptCurCtl, xArg ) == TRUE ) ? RCV_STATE_SRCA : RCV_STATE_IDLE );
@@ -634,7 +1143,7 @@ static U8 RcvStateDstaExc( TASKARG xArg )
 /******************************************************************************
  * RCV_STATE_SRCA functions
  *****************************************************************************/
-static U8 RcvStateSrcaExc( TASKARG xArg )
+static U8 RcvStateSrcaExc( STATEEXECENGARG xArg )
 {
   // store the source address/goto to RCV_STATE_CMND
   ptCurCtl->tRcvMessage.nSrcAddr = xArg;
@@ -644,7 +1153,7 @@ static U8 RcvStateSrcaExc( TASKARG xArg )
 /******************************************************************************
  * RCV_STATE_CMND functions
  *****************************************************************************/
-static U8 RcvStateCmndExc( TASKARG xArg )
+static U8 RcvStateCmndExc( STATEEXECENGARG xArg )
 {
   // store the command/goto to RCV_STATE_OPTN
   ptCurCtl->tRcvMessage.nCommand = xArg;
@@ -654,7 +1163,7 @@ static U8 RcvStateCmndExc( TASKARG xArg )
 /******************************************************************************
  * RCV_STATE_OPTN functions
  *****************************************************************************/
-static U8 RcvStateOptnExc( TASKARG xArg )
+static U8 RcvStateOptnExc( STATEEXECENGARG xArg )
 {
   U8  nNextState;
   
@@ -671,7 +1180,7 @@ static U8 RcvStateOptnExc( TASKARG xArg )
 /******************************************************************************
  * RCV_STATE_SEQN functions
  *****************************************************************************/
-static U8 RcvStateSeqnExc( TASKARG xArg )
+static U8 RcvStateSeqnExc( STATEEXECENGARG xArg )
 {
   // store the sequence/goto header 2
   ptCurCtl->tRcvMessage.nSequence = xArg;
@@ -681,7 +1190,7 @@ static U8 RcvStateSeqnExc( TASKARG xArg )
 /******************************************************************************
  * RCV_STATE_CTRL functions
  *****************************************************************************/
-static U8 RcvStateCtrlExc( TASKARG xArg )
+static U8 RcvStateCtrlExc( STATEEXECENGARG xArg )
 {
   U8  nNextState;
   
@@ -724,12 +1233,12 @@ static U8 RcvStateCtrlExc( TASKARG xArg )
       case RCV_STATE_SEQN :
         // store the sequence/goto header 2
         ptCurCtl->tRcvMessage.nSequence = CH_DLE;
-        nNextState = RCV_STATE_HDRS;
+        nNextState = RCV_STATE_HDR2;
         break;
         
       case RCV_STATE_DATA :
         // stuff the data if okay, we got  data, otherwise back to idle
-        nNextState = ( ptCurCtl, StuffRcvData( CH_DLE ) == TRUE ) ? RCV_STATE_DATA : RCV_STATE_IDLE;
+        nNextState = ( StuffRcvData( ptCurCtl, CH_DLE ) == TRUE ) ? RCV_STATE_DATA : RCV_STATE_IDLE;
         break;
         
       default :
@@ -746,7 +1255,7 @@ static U8 RcvStateCtrlExc( TASKARG xArg )
 /******************************************************************************
  * RCV_STATE_DATA functions
  *****************************************************************************/
-static U8 RcvStateDataExc( TASKARG xArg )
+static U8 RcvStateDataExc( STATEEXECENGARG xArg )
 {
   // stuff the data if okay, we got  data, otherwise back to idle
   return(( StuffRcvData( ptCurCtl, xArg ) == TRUE ) ? RCV_STATE_DATA : RCV_STATE_IDLE );
@@ -755,32 +1264,32 @@ static U8 RcvStateDataExc( TASKARG xArg )
 /******************************************************************************
  * RCV_STATE_CRCM functions
  *****************************************************************************/
-static U8 RcvStateCrcmExc( TASKARG xArg )
+static U8 RcvStateCrcmExc( STATEEXECENGARG xArg )
 {
   U8  nNextState = RCV_STATE_IDLE;
 
   // determine the checksum
   switch( ptCurCtl->eCheckMode )
   {
-    case BINCMD_CHECKMODE_EOR :
+    case BINPROT_CHKMODE_EOR :
       // compare for good
-      ptCurCtl->eLclSts = ( ptCurCtl->tRcvChkValue.anValue[ LE_U16_LSB_IDX ] == xArg ) ? LCL_STS_RCVD : LCL_STS_CHKERR;
+      ptCurCtl->eLclSts = ( ptCurCtl->tRcvCheckValue.anValue[ LE_U16_LSB_IDX ] == xArg ) ? LCL_STS_RCVD : LCL_STS_CHKERR;
       nNextState = RCV_STATE_IDLE;
       break;
 
-    case BINCMD_CHECKMODE_CMP :
+    case BINPROT_CHKMODE_CSM :
       // complement it
-      tRcvChkValue.anValue[ LE_U16_LSB_IDX ] = ~tRcvChkValue.anValue[ LE_U16_LSB_IDX ];
-      tRcvChkValue.anValue[ LE_U16_LSB_IDX ]++;
+      ptCurCtl->tRcvCheckValue.anValue[ LE_U16_LSB_IDX ] = ~ptCurCtl->tRcvCheckValue.anValue[ LE_U16_LSB_IDX ];
+      ptCurCtl->tRcvCheckValue.anValue[ LE_U16_LSB_IDX ]++;
 
       // compare for good
-      ptCurCtl->eLclSts = ( ptCurCtl->tRcvChkValue.anValue[ LE_U16_LSB_IDX ] == xArg ) ? LCL_STS_RCVD : LCL_STS_CHKERR;
+      ptCurCtl->eLclSts = ( ptCurCtl->tRcvCheckValue.anValue[ LE_U16_LSB_IDX ] == xArg ) ? LCL_STS_RCVD : LCL_STS_CHKERR;
       nNextState = RCV_STATE_IDLE;
       break;
 
-    case BINCMD_CHECKMODE_CRC :
+    case BINPROT_CHKMODE_CRC :
       // store MSB and got LSB
-      ptCurCtl->tRcvChkValue.anValue[ LE_U16_MSB_IDX ] = xArg;
+      ptCurCtl->tMsgCheckValue.anValue[ LE_U16_MSB_IDX ] = xArg;
       nNextState = RCV_STATE_CRCL;
       break;
         
@@ -797,13 +1306,13 @@ static U8 RcvStateCrcmExc( TASKARG xArg )
 /******************************************************************************
  * RCV_STATE_CRCL functions
  *****************************************************************************/
-static U8 RcvStateCrclExc( TASKARG xArg )
+static U8 RcvStateCrclExc( STATEEXECENGARG xArg )
 {
   // store the value
-  ptCurCtl->tRcvChkValue.anValue[ LE_U16_LSB_IDX ] = xArg;
+  ptCurCtl->tMsgCheckValue.anValue[ LE_U16_LSB_IDX ] = xArg;
   
   // check for valid
-  ptCurCtl->eLclSts = ( ptCurCtl->tRcvMessage.tCheck.wValue == ptCurCtl->tCalcCheckValue.wValue ) ? LCL_STS_RCVD : LCL_STS_CHKERR;
+  ptCurCtl->eLclSts = ( ptCurCtl->tMsgCheckValue.wValue == ptCurCtl->tRcvCheckValue.wValue ) ? LCL_STS_RCVD : LCL_STS_CHKERR;
   
   // back to idle
   return( RCV_STATE_IDLE );
@@ -46,6 +46,8 @@ typedef enum _BINPROTMSGSTS
   BINPROT_MSGSTS_TIMEOUT = -1,  ///< timeout
   BINPROT_MSGSTS_ERRXMT = -2,   ///< transmit error
   BINPROT_MSGSTS_ILLDEF = -2,   ///< illegal device
+  BINPROT_MSGSTS_WINFULL = -3,  ///< window full
+  BINPROT_MSGSTS_ILLMODE = -4,  ///< sequence numbers not enabled
 } BINPROTMSGSTS;
 
 // structures -----------------------------------------------------------------
@@ -62,13 +64,23 @@ typedef struct _BINPROTMSG
 } BINPROTMSG, *PBINPROTMSG;
 #define BINPROTMSG_SIZE           sizeof( BINPROTMSG )
 
+#if ( BINPROT_ENABLE_WINDOW == 1 )
+/// define the request complete callback
+typedef void  ( *PVBINPROTCOMPLETE )( BINPROTMSGSTS eStatus, PBINPROTMSG ptRcvMessage, PVOID pvArg );
+#endif // BINPROT_ENABLE_WINDOW
+
 // global parameter declarations -----------------------------------------------
 
 // global function prototypes --------------------------------------------------
 extern  void          BinaryProtocol_Initialize( void ); 
 extern  BINPROTMSGSTS BinaryProtocol_Close( BINPROTENUM eProtEnum );
 extern  void          BinaryProtocol_ProcessCharCallback( BINPROTENUM eProtEnum, U8 nData );
+extern  void          BinaryProtocol_ProcessBlockCallback( BINPROTENUM eProtEnum, PU8 pnData, U16 wLength );
 extern  BINPROTMSGSTS BinaryProtocol_SendRcvMessage( BINPROTENUM eProtEnum, PBINPROTMSG ptXmtMessage, PBINPROTMSG ptRcvMessage, S16 sTimeoutMsec );
+#if ( BINPROT_ENABLE_WINDOW == 1 )
+extern  BINPROTMSGSTS BinaryProtocol_PostMessage( BINPROTENUM eProtEnum, PBINPROTMSG ptXmtMessage, U16 wTimeoutMsec, PVBINPROTCOMPLETE pvComplete, PVOID pvArg );
+extern  void          BinaryProtocol_ProcessTimeouts( BINPROTENUM eProtEnum );
+#endif // BINPROT_ENABLE_WINDOW
 
 /**@} EOF BinaryProtocol.h */
 
@@ -36,7 +36,7 @@
 /// define the helper macro to create a protocol entry
 #define BINPROT_DEFM( multidrop, seqenable, chkmode, devaddr, xmtsize, rcvsize, writefunc ) \
   { \
-    .bMulDropMode     = multidrop, \
+    .bMultiDropMode   = multidrop, \
     .bSequenceEnable  = seqenable, \
     .eCheckMode       = chkmode, \
     .nDevAddress      = devaddr, \
@@ -35,6 +35,12 @@
 /// define the talker identifier for this implementation
 #define GPSNEMA0183PROTOCOL_TALKER_IDENTIFIER       ( "GG" )
 
+/// define the macro to enable the block mode parser - set to 1 to enable
+#define GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE        ( 0 )
+
+/// define the maximum sentence length for the block mode parser
+#define GPSNEMA0183PROTOCOL_SENTENCE_MAX_LENGTH     ( 96 )
+
 /**@} EOF GpsNEMA0183ProtocolHandler_prm.h */
 
 #endif  // _GPSNEMA0183PROTOCOLHANDLER_PRM_H
\ No newline at end of file
@@ -43,6 +43,17 @@
 /// define the end of line
 #define CH_GPS_EOL                              ( '\n' )
 
+/// define the carriage return
+#define CH_GPS_CR                               ( '\r' )
+
+/// define the number of checksum characters
+#define GPS_CHECKSUM_LEN                        ( 2 )
+
+/// define the fractional digits for the fixed point values
+#define FRAC_DIGITS_UTC                         ( 3 )
+#define FRAC_DIGITS_POS                         ( 5 )
+#define FRAC_DIGITS_MAX                         ( 5 )
+
 /// define the maximum command length
 #define CMD_MAX_LENGTH                          ( 8 )
 
@@ -99,6 +110,12 @@ static  GPSARG              atGpsArgs[ CMD_NUM_ARGS ];
 static  GPSDATA             tGpsData;
 static  GPSSATELLITE        atSatellites[ MAX_NUM_SATELLITES ];
 static  U8                  anSatellitesInView[ NUM_SAT_MESSAGES ];
+#if ( GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE == 1 )
+static  C8                  acSentence[ GPSNEMA0183PROTOCOL_SENTENCE_MAX_LENGTH ];
+static  U16                 wSentLength;
+static  BOOL                bInSentence;
+static  BOOL                bSentOverflow;
+#endif // GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE
 
 // local function prototypes --------------------------------------------------
 static  void  CmdGGA( void );
@@ -107,6 +124,15 @@ static  void  CmdGSA( void );
 static  void  CmdGSV( void );
 static  void  CmdRMC( void );
 static  void  CmdVTG( void );
+static  void  DispatchCommand( void );
+static  S32   ParseFixed( PC8 pcArg, U8 nFracDigits );
+static  FLOAT ParseFloat( PC8 pcArg, U8 nFracDigits );
+static  U32   ParseUnsigned( PC8 pcArg );
+#if ( GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE == 1 )
+static  void  ProcessSentence( PC8 pcSentence, U16 wLength );
+static  U8    CalcChecksum( PC8 pcData, U16 wLength );
+static  U8    HexToNibble( C8 cChar );
+#endif // GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE
 
 // GPS_STATE_CMND functions
 static  void  GpsStateCmndEnt( void );
@@ -132,6 +158,12 @@ static  const CODE C8 szCmdGSV[ ]  = { "LGSV" };
 static  const CODE C8 szCmdRMC[ ]  = { "NRMC" };
 static  const CODE C8 szCmdVTG[ ]  = { "NVTG" };
 
+/// define the fixed point divisors
+static  const CODE S32    alFracDivisor[ FRAC_DIGITS_MAX + 1 ] =
+{
+  1, 10, 100, 1000, 10000, 100000
+};
+
 /// define the command table
 static  const CODE GPSCMDTBL  atCmdTable[ ] =
 {
@@ -198,6 +230,13 @@ void GpsNEMA0183ProtocolHandler_Initialize( void )
 
   // initialize the state
   StateExecutionEngine_Initialize( &tStateCtl, GPS_STATE_IDLE );
+  
+  #if ( GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE == 1 )
+  // clear the block mode sentence
+  wSentLength = 0;
+  bInSentence = FALSE;
+  bSentOverflow = FALSE;
+  #endif // GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE
 }
 
 /******************************************************************************
@@ -376,6 +415,109 @@ void GpsNEMA0183ProtocolHandler_ProcessChar( U8 nChar )
   StateExecutionEngine_Process( &tStateCtl, nChar );
 }
 
+#if ( GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE == 1 )
+/******************************************************************************
+ * @function GpsNEMA0183ProtocolHandler_ProcessBlock
+ *
+ * @brief process a block of characters
+ *
+ * This function will search the block for the sentence start and end of line
+ * characters.  A sentence that is complete in the block is processed in place,
+ * otherwise it is saved until the remainder arrives in a later block
+ *
+ * @param[in]   pnData    pointer to the received data
+ * @param[in]   wLength   length of the received data
+ *
+ *****************************************************************************/
+void GpsNEMA0183ProtocolHandler_ProcessBlock( PU8 pnData, U16 wLength )
+{
+  PU8   pnEnd, pnEol, pnStart;
+  U16   wSpan;
+  
+  // for each sentence in the block
+  pnEnd = pnData + wLength;
+  while( pnData < pnEnd )
+  {
+    // are we in a sentence
+    if ( !bInSentence )
+    {
+      // find the start
+      if (( pnStart = ( PU8 )memchr( pnData, CH_GPS_START, pnEnd - pnData )) != NULL )
+      {
+        // start a new sentence
+        bInSentence = TRUE;
+        bSentOverflow = FALSE;
+        wSentLength = 0;
+        pnData = pnStart + 1;
+      }
+      else
+      {
+        // discard the rest
+        pnData = pnEnd;
+      }
+    }
+    else
+    {
+      // find the end of line/compute the span
+      pnEol = ( PU8 )memchr( pnData, CH_GPS_EOL, pnEnd - pnData );
+      wSpan = (( pnEol != NULL ) ? pnEol : pnEnd ) - pnData;
+      
+      // check for a restart in the span
+      if (( pnStart = ( PU8 )memchr( pnData, CH_GPS_START, wSpan )) != NULL )
+      {
+        // restart the sentence after the start
+        bSentOverflow = FALSE;
+        wSentLength = 0;
+        pnData = pnStart + 1;
+      }
+      else
+      {
+        // check for a complete sentence in the block
+        if (( pnEol != NULL ) && ( wSentLength == 0 ))
+        {
+          // process it in place
+          ProcessSentence(( PC8 )pnData, wSpan );
+        }
+        else
+        {
+          // check for room
+          if (( wSentLength + wSpan ) <= GPSNEMA0183PROTOCOL_SENTENCE_MAX_LENGTH )
+          {
+            // copy it
+            memcpy( &acSentence[ wSentLength ], pnData, wSpan );
+            wSentLength += wSpan;
+          }
+          else
+          {
+            // flag the overflow
+            bSentOverflow = TRUE;
+          }
+          
+          // if complete and valid, process it
+          if (( pnEol != NULL ) && ( !bSentOverflow ))
+          {
+            ProcessSentence( acSentence, wSentLength );
+          }
+        }
+        
+        // check for end of line
+        if ( pnEol != NULL )
+        {
+          // end of this sentence
+          bInSentence = FALSE;
+          pnData = pnEol + 1;
+        }
+        else
+        {
+          // wait for the next block
+          pnData = pnEnd;
+        }
+      }
+    }
+  }
+}
+#endif // GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE
+
 /******************************************************************************
 // GPS_STATE_CMND functions
  *****************************************************************************/
@@ -459,6 +601,172 @@ static U8 GpsStateDataExc( STATEEXECENGARG xArg )
 // GPS_STATE_CHEK functions
  *****************************************************************************/
 static void GpsStateChekExt( void )
+{
+  // dispatch the command
+  DispatchCommand( );
+}
+
+#if ( GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE == 1 )
+/******************************************************************************
+ * @function ProcessSentence
+ *
+ * @brief process a sentence
+ *
+ * This function will verify the checksum of the sentence, then split the 
+ * address and fields into the command and argument buffers, and dispatch it
+ *
+ * @param[in]   pcSentence  pointer to the sentence following the start
+ * @param[in]   wLength     length of the sentence up to the end of line
+ *
+ *****************************************************************************/
+static void ProcessSentence( PC8 pcSentence, U16 wLength )
+{
+  PC8   pcTerm, pcField, pcDelim;
+  U16   wDataLen, wFieldLen;
+  U8    nHi, nLo;
+  
+  // find the terminator
+  if (( pcTerm = ( PC8 )memchr( pcSentence, CH_GPS_TERM, wLength )) != NULL )
+  {
+    // get the data length/remove the carriage return
+    wDataLen = pcTerm - pcSentence;
+    if (( wLength > 0 ) && ( *( pcSentence + wLength - 1 ) == CH_GPS_CR ))
+    {
+      wLength--;
+    }
+    
+    // check for the checksum characters/get them
+    if (( wLength - wDataLen ) > GPS_CHECKSUM_LEN )
+    {
+      nHi = HexToNibble( *( pcTerm + 1 ));
+      nLo = HexToNibble( *( pcTerm + 2 ));
+      
+      // check for valid checksum
+      if (( nHi <= 0x0F ) && ( nLo <= 0x0F ) && ((( nHi << 4 ) | nLo ) == CalcChecksum( pcSentence, wDataLen )))
+      {
+        // find the end of the address
+        if (( pcDelim = ( PC8 )memchr( pcSentence, CH_GPS_DELIM, wDataLen )) == NULL )
+        {
+          pcDelim = pcTerm;
+        }
+        
+        // copy the command skipping the talker identifier
+        wFieldLen = pcDelim - pcSentence;
+        wFieldLen = ( wFieldLen > nTalkerLength ) ? wFieldLen - nTalkerLength : 0;
+        wFieldLen = MIN( wFieldLen, CMD_MAX_LENGTH - 1 );
+        memcpy( acCommand, pcSentence + nTalkerLength, wFieldLen );
+        acCommand[ wFieldLen ] = '\0';
+        
+        // now for each field
+        nArgCount = 0;
+        while(( pcDelim < pcTerm ) && ( nArgCount < CMD_NUM_ARGS ))
+        {
+          // find the end of the field
+          pcField = pcDelim + 1;
+          if (( pcDelim = ( PC8 )memchr( pcField, CH_GPS_DELIM, pcTerm - pcField )) == NULL )
+          {
+            pcDelim = pcTerm;
+          }
+          
+          // copy it
+          wFieldLen = MIN( pcDelim - pcField, ARG_MAX_LENGTH - 1 );
+          memcpy( atGpsArgs[ nArgCount ].acArgument, pcField, wFieldLen );
+          atGpsArgs[ nArgCount++ ].acArgument[ wFieldLen ] = '\0';
+        }
+        
+        // dispatch the command
+        DispatchCommand( );
+      }
+    }
+  }
+}
+
+/******************************************************************************
+ * @function CalcChecksum
+ *
+ * @brief calculate the checksum
+ *
+ * This function will calculate the exclusive or of the data, processing it a
+ * word at a time and folding the result to a byte
+ *
+ * @param[in]   pcData      pointer to the data
+ * @param[in]   wLength     length of the data
+ *
+ * @return      the checksum
+ *
+ *****************************************************************************/
+static U8 CalcChecksum( PC8 pcData, U16 wLength )
+{
+  U32 uSum = 0, uWord;
+  U8  nSum;
+  
+  // for each word
+  for ( ; wLength >= sizeof( U32 ); wLength -= sizeof( U32 ), pcData += sizeof( U32 ))
+  {
+    // get the word/add it
+    memcpy( &uWord, pcData, sizeof( U32 ));
+    uSum ^= uWord;
+  }
+  
+  // fold to a byte
+  uSum ^= uSum >> 16;
+  uSum ^= uSum >> 8;
+  nSum = ( U8 )uSum;
+  
+  // now add the remaining bytes
+  while( wLength-- != 0 )
+  {
+    nSum ^= ( U8 )*( pcData++ );
+  }
+  
+  // return the checksum
+  return( nSum );
+}
+
+/******************************************************************************
+ * @function HexToNibble
+ *
+ * @brief convert a hex character
+ *
+ * This function will convert a hex character to its value
+ *
+ * @param[in]   cChar       character to convert
+ *
+ * @return      value or 0xFF if not a hex character
+ *
+ *****************************************************************************/
+static U8 HexToNibble( C8 cChar )
+{
+  U8  nValue = 0xFF;
+  
+  // determine the value
+  if (( cChar >= '0' ) && ( cChar <= '9' ))
+  {
+    nValue = cChar - '0';
+  }
+  else if (( cChar >= 'A' ) && ( cChar <= 'F' ))
+  {
+    nValue = cChar - 'A' + 10;
+  }
+  else if (( cChar >= 'a' ) && ( cChar <= 'f' ))
+  {
+    nValue = cChar - 'a' + 10;
+  }
+  
+  // return the value
+  return( nValue );
+}
+#endif // GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE
+
+/******************************************************************************
+ * @function DispatchCommand
+ *
+ * @brief dispatch the command
+ *
+ * This function will find the command in the table and execute it
+ *
+ *****************************************************************************/
+static void DispatchCommand( void )
 {
   PC8 pszTblCmd;
   U8  nIdx;
@@ -482,6 +790,119 @@ static void GpsStateChekExt( void )
   }
 }
 
+/******************************************************************************
+ * @function ParseFixed
+ *
+ * @brief parse a fixed point number
+ *
+ * This function will parse a decimal number into a fixed point value with the
+ * given number of fractional digits, extra digits are truncated
+ *
+ * @param[in]   pcArg         pointer to the argument
+ * @param[in]   nFracDigits   number of fractional digits
+ *
+ * @return      the fixed point value
+ *
+ *****************************************************************************/
+static S32 ParseFixed( PC8 pcArg, U8 nFracDigits )
+{
+  U32   uValue = 0;
+  BOOL  bNegative = FALSE, bFraction = FALSE;
+  
+  // check for a sign
+  if ( *pcArg == '-' )
+  {
+    bNegative = TRUE;
+    pcArg++;
+  }
+  
+  // for each character
+  for ( ; *pcArg != '\0'; pcArg++ )
+  {
+    // check for a digit
+    if (( *pcArg >= '0' ) && ( *pcArg <= '9' ))
+    {
+      // add it if not past the fractional digits
+      if (( !bFraction ) || ( nFracDigits != 0 ))
+      {
+        uValue = ( uValue * 10 ) + ( *pcArg - '0' );
+        nFracDigits -= ( bFraction ) ? 1 : 0;
+      }
+    }
+    else if (( *pcArg == '.' ) && ( !bFraction ))
+    {
+      // now in the fraction
+      bFraction = TRUE;
+    }
+    else
+    {
+      // done
+      break;
+    }
+  }
+  
+  // scale the remaining fractional digits
+  while( nFracDigits-- != 0 )
+  {
+    uValue *= 10;
+  }
+  
+  // return the value
+  return(( bNegative ) ? -( S32 )uValue : ( S32 )uValue );
+}
+
+/******************************************************************************
+ * @function ParseFloat
+ *
+ * @brief parse a number to a float
+ *
+ * This function will parse a decimal number as fixed point and scale it, the
+ * whole and fractional parts are converted separately to keep the precision
+ *
+ * @param[in]   pcArg         pointer to the argument
+ * @param[in]   nFracDigits   number of fractional digits
+ *
+ * @return      the value
+ *
+ *****************************************************************************/
+static FLOAT ParseFloat( PC8 pcArg, U8 nFracDigits )
+{
+  S32   lValue, lDivisor;
+  
+  // parse it/get the divisor
+  lValue = ParseFixed( pcArg, nFracDigits );
+  lDivisor = PGM_RDDWRD( alFracDivisor[ nFracDigits ] );
+  
+  // return the whole part plus the fractional part
+  return(( FLOAT )( lValue / lDivisor ) + (( FLOAT )( lValue % lDivisor ) / ( FLOAT )lDivisor ));
+}
+
+/******************************************************************************
+ * @function ParseUnsigned
+ *
+ * @brief parse an unsigned number
+ *
+ * This function will parse an unsigned decimal number
+ *
+ * @param[in]   pcArg         pointer to the argument
+ *
+ * @return      the value
+ *
+ *****************************************************************************/
+static U32 ParseUnsigned( PC8 pcArg )
+{
+  U32 uValue = 0;
+  
+  // for each digit
+  for ( ; ( *pcArg >= '0' ) && ( *pcArg <= '9' ); pcArg++ )
+  {
+    uValue = ( uValue * 10 ) + ( *pcArg - '0' );
+  }
+  
+  // return the value
+  return( uValue );
+}
+
 /******************************************************************************
  * @function CmdGGA
  *
@@ -491,13 +912,13 @@ static void GpsStateChekExt( void )
 static void CmdGGA( void )
 {
   // parse the message
-  tGpsData.fUtcPosition = ( FLOAT )atof( atGpsArgs[ 0 ].acArgument );
-  tGpsData.fLatitude = ( FLOAT )atof( atGpsArgs[ 1 ].acArgument );
+  tGpsData.fUtcPosition = ParseFloat( atGpsArgs[ 0 ].acArgument, FRAC_DIGITS_UTC );
+  tGpsData.fLatitude = ParseFloat( atGpsArgs[ 1 ].acArgument, FRAC_DIGITS_POS );
   tGpsData.eNorthSouth = ( atGpsArgs[ 2 ].acArgument[ 0 ] == 'N' ) ? GPS_LATNS_NORTH : GPS_LATNS_SOUTH;
-  tGpsData.fLongitude = ( FLOAT )atof( atGpsArgs[ 3 ].acArgument );
+  tGpsData.fLongitude = ParseFloat( atGpsArgs[ 3 ].acArgument, FRAC_DIGITS_POS );
   tGpsData.eEastWest = ( atGpsArgs[ 4 ].acArgument[ 0 ] == 'E' ) ? GPS_LONEW_EAST : GPS_LONEW_WEST;
-  tGpsData.nPosFixStatus = ( U8 )atoi( atGpsArgs[ 5 ].acArgument );
-  tGpsData.nNumOfSatelites = ( U8 )atoi( atGpsArgs[ 6 ].acArgument );
+  tGpsData.nPosFixStatus = ( U8 )ParseUnsigned( atGpsArgs[ 5 ].acArgument );
+  tGpsData.nNumOfSatelites = ( U8 )ParseUnsigned( atGpsArgs[ 6 ].acArgument );
 }
 
 /******************************************************************************
@@ -531,10 +952,10 @@ static void CmdGSV( void )
   U8  nMsgNum, nSatIdx, nDataIdx;
 
   // determine the message number
-  nMsgNum = ( U8 )atoi( atGpsArgs[ 1 ].acArgument );
+  nMsgNum = ( U8 )ParseUnsigned( atGpsArgs[ 1 ].acArgument );
 
   // set the satellites in view
-  anSatellitesInView[ nMsgNum ] = ( U8 )atoi( atGpsArgs[ 2 ].acArgument );
+  anSatellitesInView[ nMsgNum ] = ( U8 )ParseUnsigned( atGpsArgs[ 2 ].acArgument );
 
   // now for each satellite
   for ( nSatIdx = 0; nSatIdx < anSatellitesInView[ nMsgNum ]; nSatIdx++ )
@@ -543,10 +964,10 @@ static void CmdGSV( void )
     nDataIdx = ( nMsgNum * NUM_SATS_PER_MESSAGE ) + nSatIdx;
 
     // store the data
-    atSatellites[ nDataIdx ].nId = ( U8 )atoi( atGpsArgs[ 3 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
-    atSatellites[ nDataIdx ].nElevation = ( U8 )atoi( atGpsArgs[ 4 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
-    atSatellites[ nDataIdx ].wAzimuth = ( U16 )atoi( atGpsArgs[ 5 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
-    atSatellites[ nDataIdx ].nSigNoiseRatio = ( U8 )atoi( atGpsArgs[ 6 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
+    atSatellites[ nDataIdx ].nId = ( U8 )ParseUnsigned( atGpsArgs[ 3 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
+    atSatellites[ nDataIdx ].nElevation = ( U8 )ParseUnsigned( atGpsArgs[ 4 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
+    atSatellites[ nDataIdx ].wAzimuth = ( U16 )ParseUnsigned( atGpsArgs[ 5 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
+    atSatellites[ nDataIdx ].nSigNoiseRatio = ( U8 )ParseUnsigned( atGpsArgs[ 6 + ( nSatIdx * GPSSATELLITE_SIZE ) ].acArgument );
   }
 }
 
@@ -569,8 +990,8 @@ static void CmdRMC( void )
 static void CmdVTG( void )
 {
   // parse the message
-  tGpsData.fCourse = ( FLOAT )atof( atGpsArgs[ 0 ].acArgument );
-  tGpsData.fSpeed = ( FLOAT )atof( atGpsArgs[ 1 ].acArgument );
+  tGpsData.fCourse = ParseFloat( atGpsArgs[ 0 ].acArgument, FRAC_DIGITS_POS );
+  tGpsData.fSpeed = ParseFloat( atGpsArgs[ 1 ].acArgument, FRAC_DIGITS_POS );
 }
 
 /**@} EOF GpsNEMA0183ProtocolHandler.c */
@@ -28,6 +28,7 @@
 // system includes ------------------------------------------------------------
 
 // local includes -------------------------------------------------------------
+#include "GpsNEMA0183ProtocolHandler/GpsNEMA0183ProtocolHandler_prm.h"
 
 // library includes -----------------------------------------------------------
 #include "Types/Types.h"
@@ -92,6 +93,9 @@ extern  FLOAT     GpsNEMA0183ProtocolHandler_GetSpeed( void );
 extern  U8        GpsNEMA0183ProtocolHandler_GetNumSatellites( void );
 extern  U8        GpsNEMA0183ProtocolHandler_GetFixStatus( void );
 extern  void      GpsNEMA0183ProtocolHandler_ProcessChar( U8 nChar );
+#if ( GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE == 1 )
+extern  void      GpsNEMA0183ProtocolHandler_ProcessBlock( PU8 pnData, U16 wLength );
+#endif // GPSNEMA0183PROTOCOL_ENABLE_BLOCKMODE
 
 /**@} EOF GpsNEMA0183ProtocolHandler.h */
 
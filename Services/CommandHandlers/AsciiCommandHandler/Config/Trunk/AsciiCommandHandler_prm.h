@@ -35,6 +35,12 @@
 /// define the number of nested command tables
 #define ASCIICOMMANDHANDLER_TABLE_STACK_DEPTH  ( 8 )
 
+/// define the macro to build a command trie at initialization - set to 1 to enable
+#define ASCIICOMMANDHANDLER_ENABLE_TRIE         ( 0 )
+
+/// define the number of trie nodes shared by all protocols
+#define ASCIICOMMANDHANDLER_TRIE_NUM_NODES      ( 256 )
+
 /**@} EOF AsciiCommandHandler_prm.h */
 
 #endif  // _ASCIICOMMANDHANDLER_PRM_H
\ No newline at end of file
@@ -39,6 +39,14 @@
 /// define the number of elements per line for display block
 #define NUM_ELEMS_LINE          ( 16 )
 
+/// define the number of arguments that have a converted flag
+#define NUM_CNV_FLAGS           ( 32 )
+
+#if ( ASCIICOMMANDHANDLER_ENABLE_TRIE == 1 )
+/// define the null trie node
+#define TRIE_NODE_NONE          ( 0xFFFF )
+#endif // ASCIICOMMANDHANDLER_ENABLE_TRIE
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
@@ -50,6 +58,21 @@ typedef struct _TBLSTACK
  } TBLSTACK, *PTBLSTACK;
 #define TBLSTACK_SIZE         sizeof( TBLSTACK )
 
+#if ( ASCIICOMMANDHANDLER_ENABLE_TRIE == 1 )
+/// define the trie node structure
+typedef struct _TRIENODE
+{
+  ASCCMDENTRY const * ptPrefix;     ///< entry matching a command that starts with this node
+  ASCCMDENTRY const * ptExact;      ///< entry matching a command that ends at this node
+  U16                 wPrefixOrder; ///< table order of the prefix entry
+  U16                 wExactOrder;  ///< table order of the exact entry
+  U16                 wChild;       ///< first child node
+  U16                 wSibling;     ///< next sibling node
+  C8                  cChar;        ///< character for this node
+} TRIENODE, *PTRIENODE;
+#define TRIENODE_SIZE         sizeof( TRIENODE )
+#endif // ASCIICOMMANDHANDLER_ENABLE_TRIE
+
 /// define the local control structure
 typedef struct _LCLCTL
 {
@@ -59,6 +82,12 @@ typedef struct _LCLCTL
   C8        cCurPrompt;     ///< set the prompt character
   TBLSTACK  atTableStack[ ASCIICOMMANDHANDLER_TABLE_STACK_DEPTH ];
   U8        nStackIndex;    ///< stack index
+  U32       uCnvFlags;      ///< argument value converted flags
+  #if ( ASCIICOMMANDHANDLER_ENABLE_TRIE == 1 )
+  BOOL      bTrieValid;     ///< trie has been built
+  U16       wTrieRoot;      ///< root node of the trie
+  ASCCMDSTS eTrieSts;       ///< status for a command not in the trie
+  #endif // ASCIICOMMANDHANDLER_ENABLE_TRIE
 } LCLCTL, *PLCLCTL;
 #define LCLCTL_SIZE sizeof( LCLCTL )
 
@@ -72,10 +101,22 @@ const CODE C8 g_szAsciiFmtDcb[ ]    = { "%3d " };
 // local parameter declarations -----------------------------------------------
 static  LCLCTL          atLclCtl[ ASCCMD_ENUM_MAX ];
 static  PVASCWRITEFUNC  pvCurWriteFunc;
+#if ( ASCIICOMMANDHANDLER_ENABLE_TRIE == 1 )
+static  TRIENODE        atTrieNodes[ ASCIICOMMANDHANDLER_TRIE_NUM_NODES ];
+static  U16             wNumTrieNodes;
+#endif // ASCIICOMMANDHANDLER_ENABLE_TRIE
 
 // local function prototypes --------------------------------------------------
 static  void      OutputString( const PC8 pszString );
 static  ASCCMDSTS ParseCommand( ASCCMDENUM eProtEnum, PASCCMDDEF ptDef, PLCLCTL ptCtl, U8 nCompareValue );
+static  ASCCMDSTS SearchTables( ASCCMDENUM eProtEnum, PASCCMDDEF ptDef, PLCLCTL ptCtl, U8 nCompareValue );
+static  ASCCMDSTS ExecuteEntry( ASCCMDENUM eProtEnum, ASCCMDENTRY const * ptEntry, PLCLCTL ptCtl, U8 nCompareValue );
+#if ( ASCIICOMMANDHANDLER_ENABLE_TRIE == 1 )
+static  void      BuildTrie( PLCLCTL ptCtl, ASCCMDENTRY const * ptCmdTable );
+static  BOOL      AddTrieEntry( PLCLCTL ptCtl, ASCCMDENTRY const * ptEntry, U16 wOrder );
+static  U16       AllocTrieNode( C8 cChar );
+static  ASCCMDENTRY const * FindTrieEntry( PLCLCTL ptCtl, PC8 pszCmd );
+#endif // ASCIICOMMANDHANDLER_ENABLE_TRIE
 static  void      OutputError( ASCCMDSTS eError );
 static  void      OutputPrompt( C8 nPrompt );
 
@@ -103,6 +144,11 @@ void AsciiCommandHandler_Initialize( void )
   ASCCMDENUM  eIdx;
   PASCCMDDEF  ptDef;
   
+  #if ( ASCIICOMMANDHANDLER_ENABLE_TRIE == 1 )
+  // clear the trie nodes
+  wNumTrieNodes = 0;
+  #endif // ASCIICOMMANDHANDLER_ENABLE_TRIE
+
   // for each entry in the config table
   for ( eIdx = 0; eIdx < ASCCMD_ENUM_MAX; eIdx++ )
   {
@@ -115,8 +161,14 @@ void AsciiCommandHandler_Initialize( void )
     atLclCtl[ eIdx ].pszCmd = NULL;
     atLclCtl[ eIdx ].cCurPrompt = PGM_RDBYTE( ptDef->cPromptChar );
     
-    // clear the stack index
+    // clear the stack index/converted flags
     atLclCtl[ eIdx ].nStackIndex = 0;
+    atLclCtl[ eIdx ].uCnvFlags = 0;
+
+    #if ( ASCIICOMMANDHANDLER_ENABLE_TRIE == 1 )
+    // build the trie from the command tables
+    BuildTrie( &atLclCtl[ eIdx ], ( ASCCMDENTRY const * )PGM_RDWORD( ptDef->pvCmdTable ));
+    #endif // ASCIICOMMANDHANDLER_ENABLE_TRIE
   }
 }
 
@@ -140,7 +192,6 @@ ASCCMDSTS AsciiCommandHandler_ProcessChar( ASCCMDENUM eProtEnum, C8 cRcvChar, U8
   PLCLCTL     ptCtl;
   PC8         pcBuffer, pcArg, pcDelims;
   PC8*        ppcArgs;
-  PU32        puVals;
   U8          nMaxNumArgs, nIdx;
   BOOL        bEchoFlag, bRunFlag;
   #ifdef STRTOKR_P
@@ -184,7 +235,6 @@ ASCCMDSTS AsciiCommandHandler_ProcessChar( ASCCMDENUM eProtEnum, C8 cRcvChar, U8
       {
         // get the values from the definition structure
         ppcArgs = ( PC8* )PGM_RDWORD( ptDef->ppcArgs );
-        puVals = ( PU32 )PGM_RDWORD( ptDef->puVals );
         nMaxNumArgs = PGM_RDBYTE( ptDef->nNumArgs );
 
         // get the delimitires
@@ -197,8 +247,9 @@ ASCCMDSTS AsciiCommandHandler_ProcessChar( ASCCMDENUM eProtEnum, C8 cRcvChar, U8
         pcArg = ( PC8 )STRTOK_P(( char* )pcBuffer, ( char const *)pcDelims );
         #endif
 
-        // clear the number of arguments
+        // clear the number of arguments/converted flags
         ptCtl->nNumArgs = 0;
+        ptCtl->uCnvFlags = 0;
 
         // copy to command
         ptCtl->pszCmd = pcArg;
@@ -227,13 +278,6 @@ ASCCMDSTS AsciiCommandHandler_ProcessChar( ASCCMDENUM eProtEnum, C8 cRcvChar, U8
           }
         }
 
-        // for each argument convert to numbers
-        for ( nIdx = 0; nIdx < ptCtl->nNumArgs; nIdx++ )
-        {
-          // convert to a long
-          *( puVals + nIdx ) = strtol( *( ppcArgs + nIdx ), NULL, 0 );
-        }
-
         // call the command parser
         eStatus = ParseCommand( eProtEnum, ptDef, ptCtl, nCompareValue );
         switch( eStatus )
@@ -431,7 +475,8 @@ ASCCMDSTS AsciiCommandHandler_GetArg( ASCCMDENUM  eProtEnum, U8 nArgIdx, PC8* pp
  *
  * @brief gets a value
  *
- * This function checks the index and gets a value from the arugments array
+ * This function checks the index and gets a value from the arugments array,
+ * the argument is converted on the first request for its value
  *
  * @param[in]   eProtEnum   protocol enumeration
  * @param[io]   puValue     pointer to the value storage
@@ -443,15 +488,34 @@ ASCCMDSTS AsciiCommandHandler_GetValue( ASCCMDENUM eProtEnum, U8 nArgIdx, PU32 p
 {
   ASCCMDSTS  eStatus = ASCCMD_STS_NONE;
   PU32        puVals;
+  PC8*        ppcArgs;
+  PLCLCTL     ptCtl;
   
   // check for valid protocol
   if ( eProtEnum < ASCCMD_ENUM_MAX )
   {
     // check for valid argument
-    if ( nArgIdx < atLclCtl[ eProtEnum ].nNumArgs )
+    ptCtl = &atLclCtl[ eProtEnum ];
+    if ( nArgIdx < ptCtl->nNumArgs )
     {
-      // get the pointer to the argument array
+      // get the pointer to the value array
       puVals = ( PU32 )PGM_RDWORD( g_atAscCmdDefs[ eProtEnum ].puVals );
+      
+      // check for an unconverted value
+      if (( nArgIdx >= NUM_CNV_FLAGS ) || (( ptCtl->uCnvFlags & ( 1UL << nArgIdx )) == 0 ))
+      {
+        // get the pointer to the argument array/convert to a long
+        ppcArgs = ( PC8* )PGM_RDWORD( g_atAscCmdDefs[ eProtEnum ].ppcArgs );
+        *( puVals + nArgIdx ) = strtol( *( ppcArgs + nArgIdx ), NULL, 0 );
+        
+        // flag it as converted
+        if ( nArgIdx < NUM_CNV_FLAGS )
+        {
+          ptCtl->uCnvFlags |= ( 1UL << nArgIdx );
+        }
+      }
+
+      // return the value
       *puValue = *( puVals + nArgIdx );
     }
     else
@@ -831,7 +895,8 @@ static void OutputString( const PC8 pszString )
  *
  * @brief command parser process routine
  *
- * This function initializes the diagnostic bus interfaace
+ * This function finds the command, either from the trie if enabled or by
+ * searching the command tables, and executes it
  *
  * @param[in] ptDef         pointer to the definition structure
  * @param[in] ptCtl         pointer to the control structure
@@ -840,12 +905,64 @@ static void OutputString( const PC8 pszString )
  *
  *****************************************************************************/
 static ASCCMDSTS ParseCommand( ASCCMDENUM eProtEnum, PASCCMDDEF ptDef, PLCLCTL ptCtl, U8 nCompareValue )
+{
+  ASCCMDSTS           eStatus;
+  #if ( ASCIICOMMANDHANDLER_ENABLE_TRIE == 1 )
+  ASCCMDENTRY const * ptEntry;
+  
+  // check for a valid trie
+  if ( ptCtl->bTrieValid )
+  {
+    // check for a command
+    if ( ptCtl->pszCmd == NULL )
+    {
+      // report the error as an illegal command
+      eStatus = ASCCMD_STS_ILLCOMMAND;
+    }
+    else if (( ptEntry = FindTrieEntry( ptCtl, ptCtl->pszCmd )) != NULL )
+    {
+      // execute it
+      eStatus = ExecuteEntry( eProtEnum, ptEntry, ptCtl, nCompareValue );
+    }
+    else
+    {
+      // report the error found when building
+      eStatus = ptCtl->eTrieSts;
+    }
+  }
+  else
+  {
+    // search the tables
+    eStatus = SearchTables( eProtEnum, ptDef, ptCtl, nCompareValue );
+  }
+  #else
+  // search the tables
+  eStatus = SearchTables( eProtEnum, ptDef, ptCtl, nCompareValue );
+  #endif // ASCIICOMMANDHANDLER_ENABLE_TRIE
+  
+  // return the error
+  return( eStatus );
+}
+
+/******************************************************************************
+ * @function SearchTables
+ *
+ * @brief search the command tables
+ *
+ * This function searches the command tables in order for the command and
+ * executes the first matching entry
+ *
+ * @param[in] ptDef         pointer to the definition structure
+ * @param[in] ptCtl         pointer to the control structure
+ *
+ * @return   apropriate error status
+ *
+ *****************************************************************************/
+static ASCCMDSTS SearchTables( ASCCMDENUM eProtEnum, PASCCMDDEF ptDef, PLCLCTL ptCtl, U8 nCompareValue )
 {
   ASCCMDSTS           eStatus = ASCCMD_STS_NONE;
-  U8                  nIdx, nCmpLen, nTblNumArgs, nTblCmpVal;
-  ASCFLAGCOMPARE      eFlagCompare;
-  PVASCCMDHANDLERFUNC pvFunction;
-  BOOL                bCompareFlag, bRunFlag;
+  U8                  nIdx, nCmpLen;
+  BOOL                bRunFlag;
   S16                 sCmpResult;
   PC8                 pszTblCmd;
   ASCCMDENTRY const * ptCmdTable;
@@ -910,82 +1027,22 @@ static ASCCMDSTS ParseCommand( ASCCMDENUM eProtEnum, PASCCMDDEF ptDef, PLCLCTL p
       }
       else
       {
-        // test for end of table
-        if( nCmpLen != 0 )
-        {
-          // get the pointer to the command from the table
-          pszTblCmd = ( PC8 )PGM_RDWORD(( ptCmdTable + nIdx )->pszCommand );
+        // get the pointer to the command from the table
+        pszTblCmd = ( PC8 )PGM_RDWORD(( ptCmdTable + nIdx )->pszCommand );
 
-          // compare
-          sCmpResult = STRNCMP_P(( char const* )ptCtl->pszCmd, ( char const* )pszTblCmd, nCmpLen );
+        // compare
+        sCmpResult = STRNCMP_P(( char const* )ptCtl->pszCmd, ( char const* )pszTblCmd, nCmpLen );
 
-          // is this our command
-          if( sCmpResult == 0 )
-          {
-            // now check for right number of arguments
-            nTblNumArgs = PGM_RDBYTE(( ptCmdTable + nIdx )->nNumArgs );
-            if(( nTblNumArgs == 0 ) || ( nTblNumArgs == ptCtl->nNumArgs ))
-            {
-              // check for special flag
-              eFlagCompare = PGM_RDBYTE(( ptCmdTable + nIdx )->eFlagCompare );
-              nTblCmpVal = PGM_RDBYTE(( ptCmdTable + nIdx )->nCmpValue );
-              switch( eFlagCompare )
-              {
-                case ASCFLAG_COMPARE_EQ :
-                  bCompareFlag = ( nTblCmpVal == nCompareValue ) ? TRUE : FALSE;
-                  break;
-
-                case ASCFLAG_COMPARE_NE :
-                  bCompareFlag = ( nTblCmpVal != nCompareValue ) ? TRUE : FALSE;
-                  break;
-
-                case ASCFLAG_COMPARE_GT :
-                  bCompareFlag = ( nCompareValue > nTblCmpVal ) ? TRUE : FALSE;
-                  break;
-
-                case ASCFLAG_COMPARE_LT :
-                  bCompareFlag = ( nCompareValue < nTblCmpVal ) ? TRUE : FALSE;
-                  break;
-
-                case ASCFLAG_COMPARE_GE :
-                  bCompareFlag = ( nCompareValue >= nTblCmpVal ) ? TRUE : FALSE;
-                  break;
-
-                case ASCFLAG_COMPARE_LE :
-                  bCompareFlag = ( nCompareValue <= nTblCmpVal ) ? TRUE : FALSE;
-                  break;
-
-                default :
-                  bCompareFlag = TRUE;
-                  break;
-              }
-            
-              // chek for a flag compare
-              if ( !bCompareFlag )
-              {
-                // error - flags don't match
-                eStatus = ASCCMD_STS_FLAGMISMATCH;
-                bRunFlag = FALSE;
-              }
-              else
-              {
-                // execute it/exit/clear the run flag
-                pvFunction = ( PVASCCMDHANDLERFUNC )PGM_RDWORD(( ptCmdTable + nIdx )->tPointers.pvCmdHandler );
-                eStatus = ( pvFunction )( eProtEnum );
-                bRunFlag = FALSE;
-              }
-            }
-            else
-            {
-              // indiate wrong number of arguments
-              eStatus = ASCCMD_STS_ILLNUMARGS;
-              bRunFlag = FALSE;
-            }
-          }
-
-          // increment the index
-          nIdx++;
+        // is this our command
+        if( sCmpResult == 0 )
+        {
+          // execute it/clear the run flag
+          eStatus = ExecuteEntry( eProtEnum, ptCmdTable + nIdx, ptCtl, nCompareValue );
+          bRunFlag = FALSE;
         }
+
+        // increment the index
+        nIdx++;
       }
     }
   }
@@ -1002,6 +1059,374 @@ static ASCCMDSTS ParseCommand( ASCCMDENUM eProtEnum, PASCCMDDEF ptDef, PLCLCTL p
   return( eStatus );
 }
 
+/******************************************************************************
+ * @function ExecuteEntry
+ *
+ * @brief execute a command entry
+ *
+ * This function checks the number of arguments and the flag of the matching
+ * entry and if valid, calls its handler
+ *
+ * @param[in] eProtEnum     protocol enumeration
+ * @param[in] ptEntry       pointer to the entry
+ * @param[in] ptCtl         pointer to the control structure
+ * @param[in] nCompareValue flag compare value
+ *
+ * @return   apropriate error status
+ *
+ *****************************************************************************/
+static ASCCMDSTS ExecuteEntry( ASCCMDENUM eProtEnum, ASCCMDENTRY const * ptEntry, PLCLCTL ptCtl, U8 nCompareValue )
+{
+  ASCCMDSTS           eStatus;
+  U8                  nTblNumArgs, nTblCmpVal;
+  ASCFLAGCOMPARE      eFlagCompare;
+  PVASCCMDHANDLERFUNC pvFunction;
+  BOOL                bCompareFlag;
+
+  // now check for right number of arguments
+  nTblNumArgs = PGM_RDBYTE( ptEntry->nNumArgs );
+  if(( nTblNumArgs == 0 ) || ( nTblNumArgs == ptCtl->nNumArgs ))
+  {
+    // check for special flag
+    eFlagCompare = PGM_RDBYTE( ptEntry->eFlagCompare );
+    nTblCmpVal = PGM_RDBYTE( ptEntry->nCmpValue );
+    switch( eFlagCompare )
+    {
+      case ASCFLAG_COMPARE_EQ :
+        bCompareFlag = ( nTblCmpVal == nCompareValue ) ? TRUE : FALSE;
+        break;
+
+      case ASCFLAG_COMPARE_NE :
+        bCompareFlag = ( nTblCmpVal != nCompareValue ) ? TRUE : FALSE;
+        break;
+
+      case ASCFLAG_COMPARE_GT :
+        bCompareFlag = ( nCompareValue > nTblCmpVal ) ? TRUE : FALSE;
+        break;
+
+      case ASCFLAG_COMPARE_LT :
+        bCompareFlag = ( nCompareValue < nTblCmpVal ) ? TRUE : FALSE;
+        break;
+
+      case ASCFLAG_COMPARE_GE :
+        bCompareFlag = ( nCompareValue >= nTblCmpVal ) ? TRUE : FALSE;
+        break;
+
+      case ASCFLAG_COMPARE_LE :
+        bCompareFlag = ( nCompareValue <= nTblCmpVal ) ? TRUE : FALSE;
+        break;
+
+      default :
+        bCompareFlag = TRUE;
+        break;
+    }
+  
+    // chek for a flag compare
+    if ( !bCompareFlag )
+    {
+      // error - flags don't match
+      eStatus = ASCCMD_STS_FLAGMISMATCH;
+    }
+    else
+    {
+      // execute it
+      pvFunction = ( PVASCCMDHANDLERFUNC )PGM_RDWORD( ptEntry->tPointers.pvCmdHandler );
+      eStatus = ( pvFunction )( eProtEnum );
+    }
+  }
+  else
+  {
+    // indiate wrong number of arguments
+    eStatus = ASCCMD_STS_ILLNUMARGS;
+  }
+
+  // return the error
+  return( eStatus );
+}
+
+#if ( ASCIICOMMANDHANDLER_ENABLE_TRIE == 1 )
+/******************************************************************************
+ * @function BuildTrie
+ *
+ * @brief build the command trie
+ *
+ * This function walks the command tables in the same order as the table 
+ * search, including the external tables, and adds each entry to the trie.  If
+ * the walk stops on a missing table or too many tables, that error is reported
+ * for commands that are not found.  If the trie runs out of nodes, the nodes
+ * of the partial trie are returned to the pool and the table search is used
+ * instead
+ *
+ * @param[in] ptCtl         pointer to the control structure
+ * @param[in] ptCmdTable    pointer to the command table
+ *
+ *****************************************************************************/
+static void BuildTrie( PLCLCTL ptCtl, ASCCMDENTRY const * ptCmdTable )
+{
+  U8    nIdx, nCmpLen;
+  U16   wOrder;
+  BOOL  bRunFlag;
+
+  // allocate the root/reset the index/order/stack
+  ptCtl->wTrieRoot = AllocTrieNode( '\0' );
+  ptCtl->bTrieValid = ( ptCtl->wTrieRoot != TRIE_NODE_NONE ) ? TRUE : FALSE;
+  ptCtl->eTrieSts = ASSCMD_STS_NOCMDTABLE;
+  ptCtl->nStackIndex = 0;
+  nIdx = 0;
+  wOrder = 0;
+
+  // check for a table
+  bRunFlag = (( ptCtl->bTrieValid ) && ( ptCmdTable != NULL )) ? TRUE : FALSE;
+  while( bRunFlag )
+  {
+    // get the compare length from the table
+    nCmpLen = PGM_RDBYTE(( ptCmdTable + nIdx )->nCmpLen );
+    
+    // test for end of table
+    if ( nCmpLen == CMD_LENGTH_ENDOFTABLE )
+    {
+      // is this the last table
+      if ( ptCtl->nStackIndex == 0 )
+      {
+        // commands not found are illegal/clear the run flag
+        ptCtl->eTrieSts = ASCCMD_STS_ILLCOMMAND;
+        bRunFlag = FALSE;
+      }
+      else
+      {
+        // restore the command table pointer
+        ptCtl->nStackIndex--;
+        nIdx = ptCtl->atTableStack[ ptCtl->nStackIndex ].nIndex;
+        ptCmdTable = ( ASCCMDENTRY const * )ptCtl->atTableStack[ ptCtl->nStackIndex ].ptTable;
+      }
+    }
+    else if ( nCmpLen == CMD_LENGTH_EXTTABLE )
+    {
+      // check for room on stack
+      if ( ptCtl->nStackIndex < ASCIICOMMANDHANDLER_TABLE_STACK_DEPTH )
+      {
+        // save the current table pointer/get the next table/reset index
+        ptCtl->atTableStack[ ptCtl->nStackIndex ].ptTable = ( PVASCCMDHANDLERFUNC const * )ptCmdTable;
+        ptCmdTable = ( ASCCMDENTRY const * )PGM_RDWORD(( ptCmdTable + nIdx )->tPointers.pvExtTable );
+        ptCtl->atTableStack[ ptCtl->nStackIndex ].nIndex = nIdx + 1;
+        ptCtl->nStackIndex++;
+        nIdx = 0;
+
+        // test for a null table
+        if ( ptCmdTable == NULL )
+        {
+          // set the error/exit
+          ptCtl->eTrieSts = ASCCMD_STS_ILLCOMMAND;
+          bRunFlag = FALSE;
+        }
+      }
+      else
+      {
+        // set the error/exit
+        ptCtl->eTrieSts = ASCCMD_STS_TOOMANYTBLS;
+        bRunFlag = FALSE;
+      }
+    }
+    else
+    {
+      // add the entry
+      if ( !AddTrieEntry( ptCtl, ptCmdTable + nIdx, wOrder++ ))
+      {
+        // out of nodes - the partial trie is every node from its root up, free it/use the table search
+        wNumTrieNodes = ptCtl->wTrieRoot;
+        ptCtl->wTrieRoot = TRIE_NODE_NONE;
+        ptCtl->bTrieValid = FALSE;
+        bRunFlag = FALSE;
+      }
+
+      // increment the index
+      nIdx++;
+    }
+  }
+
+  // cleanup stack
+  ptCtl->nStackIndex = 0;
+}
+
+/******************************************************************************
+ * @function AddTrieEntry
+ *
+ * @brief add an entry to the trie
+ *
+ * This function adds the compare characters of an entry to the trie.  An 
+ * entry whose command is shorter than its compare length only matches that
+ * exact command, otherwise it matches any command starting with the compare
+ * characters.  The first entry in table order is kept for each node
+ *
+ * @param[in] ptCtl         pointer to the control structure
+ * @param[in] ptEntry       pointer to the entry
+ * @param[in] wOrder        table order of the entry
+ *
+ * @return   TRUE if added, FALSE if out of nodes
+ *
+ *****************************************************************************/
+static BOOL AddTrieEntry( PLCLCTL ptCtl, ASCCMDENTRY const * ptEntry, U16 wOrder )
+{
+  PC8       pszTblCmd;
+  U8        nCmpLen, nChar;
+  C8        cChar;
+  U16       wNode, wChild;
+  PTRIENODE ptNode;
+  BOOL      bExact = FALSE;
+  BOOL      bStatus = TRUE;
+
+  // get the command/compare length
+  pszTblCmd = ( PC8 )PGM_RDWORD( ptEntry->pszCommand );
+  nCmpLen = PGM_RDBYTE( ptEntry->nCmpLen );
+  wNode = ptCtl->wTrieRoot;
+
+  // for each compare character
+  for ( nChar = 0; ( nChar < nCmpLen ) && ( !bExact ); nChar++ )
+  {
+    // get the character/check for end of command
+    cChar = PGM_RDBYTE( *( pszTblCmd + nChar ));
+    if ( cChar == '\0' )
+    {
+      // only matches this command
+      bExact = TRUE;
+    }
+    else
+    {
+      // find the child
+      for ( wChild = atTrieNodes[ wNode ].wChild; ( wChild != TRIE_NODE_NONE ) && ( atTrieNodes[ wChild ].cChar != cChar ); wChild = atTrieNodes[ wChild ].wSibling );
+
+      // if not found, add one
+      if ( wChild == TRIE_NODE_NONE )
+      {
+        if (( wChild = AllocTrieNode( cChar )) == TRIE_NODE_NONE )
+        {
+          // out of nodes
+          bStatus = FALSE;
+          break;
+        }
+
+        // link it
+        atTrieNodes[ wChild ].wSibling = atTrieNodes[ wNode ].wChild;
+        atTrieNodes[ wNode ].wChild = wChild;
+      }
+
+      // move to the child
+      wNode = wChild;
+    }
+  }
+
+  // check for all nodes added
+  if ( bStatus )
+  {
+    // store the entry if the first
+    ptNode = &atTrieNodes[ wNode ];
+    if (( bExact ) && ( ptNode->ptExact == NULL ))
+    {
+      ptNode->ptExact = ptEntry;
+      ptNode->wExactOrder = wOrder;
+    }
+    else if (( !bExact ) && ( ptNode->ptPrefix == NULL ))
+    {
+      ptNode->ptPrefix = ptEntry;
+      ptNode->wPrefixOrder = wOrder;
+    }
+  }
+
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function AllocTrieNode
+ *
+ * @brief allocate a trie node
+ *
+ * This function allocates and clears a trie node
+ *
+ * @param[in] cChar         character for this node
+ *
+ * @return   the node index or TRIE_NODE_NONE
+ *
+ *****************************************************************************/
+static U16 AllocTrieNode( C8 cChar )
+{
+  U16       wNode = TRIE_NODE_NONE;
+  PTRIENODE ptNode;
+
+  // check for room
+  if ( wNumTrieNodes < ASCIICOMMANDHANDLER_TRIE_NUM_NODES )
+  {
+    // get the node/clear it
+    wNode = wNumTrieNodes++;
+    ptNode = &atTrieNodes[ wNode ];
+    ptNode->ptPrefix = NULL;
+    ptNode->ptExact = NULL;
+    ptNode->wChild = TRIE_NODE_NONE;
+    ptNode->wSibling = TRIE_NODE_NONE;
+    ptNode->cChar = cChar;
+  }
+
+  // return the node
+  return( wNode );
+}
+
+/******************************************************************************
+ * @function FindTrieEntry
+ *
+ * @brief find the entry for a command
+ *
+ * This function walks the trie with the command and returns the entry that
+ * is first in table order of all the entries matching the command
+ *
+ * @param[in] ptCtl         pointer to the control structure
+ * @param[in] pszCmd        pointer to the command
+ *
+ * @return   pointer to the entry or NULL if not found
+ *
+ *****************************************************************************/
+static ASCCMDENTRY const * FindTrieEntry( PLCLCTL ptCtl, PC8 pszCmd )
+{
+  ASCCMDENTRY const * ptEntry = NULL;
+  U16                 wOrder = 0, wNode;
+  PTRIENODE           ptNode;
+  C8                  cChar;
+
+  // start at the root
+  wNode = ptCtl->wTrieRoot;
+  while( wNode != TRIE_NODE_NONE )
+  {
+    // check for a better prefix match
+    ptNode = &atTrieNodes[ wNode ];
+    if (( ptNode->ptPrefix != NULL ) && (( ptEntry == NULL ) || ( ptNode->wPrefixOrder < wOrder )))
+    {
+      ptEntry = ptNode->ptPrefix;
+      wOrder = ptNode->wPrefixOrder;
+    }
+
+    // check for end of the command
+    if (( cChar = *( pszCmd++ )) == '\0' )
+    {
+      // check for a better exact match
+      if (( ptNode->ptExact != NULL ) && (( ptEntry == NULL ) || ( ptNode->wExactOrder < wOrder )))
+      {
+        ptEntry = ptNode->ptExact;
+      }
+
+      // done
+      wNode = TRIE_NODE_NONE;
+    }
+    else
+    {
+      // find the child for this character
+      for ( wNode = ptNode->wChild; ( wNode != TRIE_NODE_NONE ) && ( atTrieNodes[ wNode ].cChar != cChar ); wNode = atTrieNodes[ wNode ].wSibling );
+    }
+  }
+
+  // return the entry
+  return( ptEntry );
+}
+#endif // ASCIICOMMANDHANDLER_ENABLE_TRIE
+
 /******************************************************************************
  * @function OutputError
  *
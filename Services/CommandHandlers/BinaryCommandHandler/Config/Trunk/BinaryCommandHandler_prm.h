@@ -40,6 +40,9 @@
 /// define the number of nested command tables
 #define BINARYCOMMANDHANDLER_TABLE_STACK_DEPTH  ( 4 )
 
+/// define the macro to build a 256 entry dispatch array per protocol at initialization - set to 1 to enable
+#define BINARYCOMMANDHANDLER_ENABLE_DISPATCH    ( 0 )
+
 /**@} EOF BinaryCommandHandler_prm.h */
 
 #endif  // _BINARYCOMMANDHANDLER_PRM_H
\ No newline at end of file
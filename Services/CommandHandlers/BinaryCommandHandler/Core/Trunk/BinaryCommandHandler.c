@@ -130,7 +130,12 @@ typedef struct _PROTCTRL
   MASTSTATE               eMastState;         ///< master state
   #endif // BINCMDHAND_ENABLE_MASTERMODE
   BINCMDSLVENTRY const *  atTableStack[ BINARYCOMMANDHANDLER_TABLE_STACK_DEPTH ]; ///< maximum number of tables
+  U8                      anIndexStack[ BINARYCOMMANDHANDLER_TABLE_STACK_DEPTH ]; ///< entry index to resume each table
   U8                      nStackIndex;
+  #if ( BINARYCOMMANDHANDLER_ENABLE_DISPATCH == 1 )
+  BINCMDSLVENTRY const *  aptDispatch[ 256 ];  ///< first matching entry for each command
+  BINPARSESTS             eDispatchSts;       ///< status for a command with no entry
+  #endif // BINARYCOMMANDHANDLER_ENABLE_DISPATCH
 } PROTCTRL, *PPROTCTRL;
 #define PROTCTRL_SIZE     sizeof( PROTCTRL )
 
@@ -151,6 +156,10 @@ static  BOOL        StuffRcvData( U8 nRcvChar );
 static  void        StuffXmtData( PLCLBUFCTL ptBufCtl, U8 nData, BOOL bEscapeEnb );
 static  BINCMDSTS   ProcessRcvdMsg( BINCMDENUM eProtEnum, U8 nCompareValue );
 static  BINPARSESTS ParseCommand( BINCMDENUM eProtEnum, U16 wRcvLen, U8 nCompareValue );
+static  BINPARSESTS ExecuteEntry( BINCMDENUM eProtEnum, PBINCMDSLVENTRY ptEntry, U16 wRcvLen, U8 nCompareValue );
+#if ( BINARYCOMMANDHANDLER_ENABLE_DISPATCH == 1 )
+static  void        BuildDispatch( PPROTCTRL ptCtl, BINCMDSLVENTRY const * ptCommandTable );
+#endif // BINARYCOMMANDHANDLER_ENABLE_DISPATCH
 
 // RCV_STATE_IDLE functions
 static  void  RcvStateIdleEnt( void );
@@ -279,6 +288,11 @@ void BinaryCommandHandler_Initialize( void )
     
     // initialize the state
     StateExecutionEngine_Initialize( &ptLclCtl->tStateCtl, RCV_STATE_IDLE );
+    
+    #if ( BINARYCOMMANDHANDLER_ENABLE_DISPATCH == 1 )
+    // build the dispatch array from the command tables
+    BuildDispatch( ptLclCtl, ( BINCMDSLVENTRY const * )PGM_RDWORD( ptLclDef->ptSlvCmdTbl ));
+    #endif // BINARYCOMMANDHANDLER_ENABLE_DISPATCH
 
     // if multidrop mode, set the local address
     if ( PGM_RDBYTE( ptLclDef->bMultiDropMode ) == TRUE )
@@ -2079,7 +2093,9 @@ static BINCMDSTS ProcessRcvdMsg( BINCMDENUM eProtEnum, U8 nCompareValue )
  * @brief parse the command
  *
  * This function processes the command and if a command is found in the table
- * the command is checked for length and flags
+ * the command is checked for length and flags.  If the dispatch array is 
+ * enabled, the entry is found with a single lookup, otherwise the tables are
+ * searched in order
  *
  * @param[in]   eProtEnum   protocol enumeration
  * @param[in]   wRcvLen       length of the received command
@@ -2090,12 +2106,27 @@ static BINCMDSTS ProcessRcvdMsg( BINCMDENUM eProtEnum, U8 nCompareValue )
  *****************************************************************************/
 static BINPARSESTS ParseCommand( BINCMDENUM eProtEnum, U16 wRcvLen, U8 nCompareValue )
 {
-  BINCMDSLVENTRY const *  ptCommandTable;
   BINCMDSLVENTRY          tTableEntry;
+  BINPARSESTS             eStatus = BINPARSE_STS_ERR_NOCMDTBL;
+  #if ( BINARYCOMMANDHANDLER_ENABLE_DISPATCH == 1 )
+  BINCMDSLVENTRY const *  ptEntry;
+
+  // look up the entry
+  if (( ptEntry = ptLclCtl->aptDispatch[ ptLclCtl->tRcvBuffer.nCommand ] ) != NULL )
+  {
+    // get a copy of the table entry/execute it
+    MEMCPY_P( &tTableEntry, ptEntry, BINCMDSLVENTRY_SIZE );
+    eStatus = ExecuteEntry( eProtEnum, &tTableEntry, wRcvLen, nCompareValue );
+  }
+  else
+  {
+    // report the error found when building
+    eStatus = ptLclCtl->eDispatchSts;
+  }
+  #else
+  BINCMDSLVENTRY const *  ptCommandTable;
   U8                      nIdx;
   BOOL                    bRunFlag = TRUE;
-  BOOL                    bCompareResults;
-  BINPARSESTS             eStatus = BINPARSE_STS_ERR_NOCMDTBL;
 
   // reset the index/stack index
   nIdx = 0;
@@ -2123,8 +2154,9 @@ static BINPARSESTS ParseCommand( BINCMDENUM eProtEnum, U16 wRcvLen, U8 nCompareV
         }
         else
         {
-          // get the table pointer from the stack
+          // get the table pointer/index from the stack
           ptCommandTable = ptLclCtl->atTableStack[ --ptLclCtl->nStackIndex ];
+          nIdx = ptLclCtl->anIndexStack[ ptLclCtl->nStackIndex ];
         }
       }
       else if ( tTableEntry.nCommand == BINCMD_EXT_TABLE )
@@ -2132,7 +2164,8 @@ static BINPARSESTS ParseCommand( BINCMDENUM eProtEnum, U16 wRcvLen, U8 nCompareV
         // check for room on stack
         if ( ptLclCtl->nStackIndex < BINARYCOMMANDHANDLER_TABLE_STACK_DEPTH )
         {
-          // save the table pointer on the stack/get the next table/set the index back to 0
+          // save the table pointer/index on the stack/get the next table/set the index back to 0
+          ptLclCtl->anIndexStack[ ptLclCtl->nStackIndex ] = nIdx;
           ptLclCtl->atTableStack[ ptLclCtl->nStackIndex++ ] = ptCommandTable;
           ptCommandTable = ( BINCMDSLVENTRY const *  )tTableEntry.pvExtTable;
           nIdx = 0;
@@ -2157,81 +2190,205 @@ static BINPARSESTS ParseCommand( BINCMDENUM eProtEnum, U16 wRcvLen, U8 nCompareV
         // determine if this command matches the command in the table
         if ( tTableEntry.nCommand == ( ptLclCtl->tRcvBuffer.nCommand & ~tTableEntry.nCmdMask ))
         {
-          // now check for proper length
-          if (( tTableEntry.iExpLength == -1 ) || ( tTableEntry.iExpLength == wRcvLen ))
-          {
-            // now compare flag values
-            switch( tTableEntry.eCompareFlag )
-            {
-              case BINCOMP_FLAG_EQ :
-                bCompareResults = ( nCompareValue == tTableEntry.nCompareValue ) ? TRUE : FALSE;
-                break;
-
-              case BINCOMP_FLAG_NE :
-                bCompareResults = ( nCompareValue != tTableEntry.nCompareValue ) ? TRUE : FALSE;
-                break;
-
-              case BINCOMP_FLAG_GT :
-                bCompareResults = ( nCompareValue > tTableEntry.nCompareValue ) ? TRUE : FALSE;
-                break;
-
-              case BINCOMP_FLAG_GE :
-                bCompareResults = ( nCompareValue >= tTableEntry.nCompareValue ) ? TRUE : FALSE;
-                break;
-
-              case BINCOMP_FLAG_LT :
-                bCompareResults = ( nCompareValue < tTableEntry.nCompareValue ) ? TRUE : FALSE;
-                break;
-
-              case BINCOMP_FLAG_LE :
-                bCompareResults = ( nCompareValue <= tTableEntry.nCompareValue ) ? TRUE : FALSE;
-                break;
-
-              case BINCOMP_FLAG_NONE :
-              default :
-                bCompareResults = TRUE;
-                break;
-            }
-          
-            // now test the results
-            if ( bCompareResults )
-            {
-              // if valid handler
-              if ( tTableEntry.pvCmdFunc != NULL )
-              {
-                // execute it
-                eStatus = tTableEntry.pvCmdFunc( eProtEnum );
-              }
-              else
-              {
-                // set error flag
-                eStatus = BINPARSE_STS_ERR_ILLHAND;
-              }
-
-              // in all cases, clear the run flag
-              bRunFlag = FALSE;
-            }
-            else
-            {
-              // illegal flag
-              eStatus = BINPARSE_STS_ERR_ILLFLG;
-              bRunFlag = FALSE;
-            }
-          }
-          else
-          {
-            // command lengths does not match
-            eStatus = BINPARSE_STS_ERR_ILLLEN;
-            bRunFlag = FALSE;
-          }
+          // execute it
+          eStatus = ExecuteEntry( eProtEnum, &tTableEntry, wRcvLen, nCompareValue );
+          bRunFlag = FALSE;
         }
       }
     }
   }
+  #endif // BINARYCOMMANDHANDLER_ENABLE_DISPATCH
   
   // return the status
   return ( eStatus );
 }
 
+/******************************************************************************
+ * @function ExecuteEntry
+ *
+ * @brief execute a command entry
+ *
+ * This function checks the matching entry for length and flags and if valid,
+ * calls its handler
+ *
+ * @param[in]   eProtEnum     protocol enumeration
+ * @param[in]   ptEntry       pointer to a copy of the entry
+ * @param[in]   wRcvLen       length of the received command
+ * @param[in]   nCompareValue value to use for the flag compare
+ *
+ * @return      appropriate protocol status/error
+ *
+ *****************************************************************************/
+static BINPARSESTS ExecuteEntry( BINCMDENUM eProtEnum, PBINCMDSLVENTRY ptEntry, U16 wRcvLen, U8 nCompareValue )
+{
+  BINPARSESTS eStatus;
+  BOOL        bCompareResults;
+  
+  // now check for proper length
+  if (( ptEntry->iExpLength == -1 ) || ( ptEntry->iExpLength == wRcvLen ))
+  {
+    // now compare flag values
+    switch( ptEntry->eCompareFlag )
+    {
+      case BINCOMP_FLAG_EQ :
+        bCompareResults = ( nCompareValue == ptEntry->nCompareValue ) ? TRUE : FALSE;
+        break;
+
+      case BINCOMP_FLAG_NE :
+        bCompareResults = ( nCompareValue != ptEntry->nCompareValue ) ? TRUE : FALSE;
+        break;
+
+      case BINCOMP_FLAG_GT :
+        bCompareResults = ( nCompareValue > ptEntry->nCompareValue ) ? TRUE : FALSE;
+        break;
+
+      case BINCOMP_FLAG_GE :
+        bCompareResults = ( nCompareValue >= ptEntry->nCompareValue ) ? TRUE : FALSE;
+        break;
+
+      case BINCOMP_FLAG_LT :
+        bCompareResults = ( nCompareValue < ptEntry->nCompareValue ) ? TRUE : FALSE;
+        break;
+
+      case BINCOMP_FLAG_LE :
+        bCompareResults = ( nCompareValue <= ptEntry->nCompareValue ) ? TRUE : FALSE;
+        break;
+
+      case BINCOMP_FLAG_NONE :
+      default :
+        bCompareResults = TRUE;
+        break;
+    }
+  
+    // now test the results
+    if ( bCompareResults )
+    {
+      // if valid handler
+      if ( ptEntry->pvCmdFunc != NULL )
+      {
+        // execute it
+        eStatus = ptEntry->pvCmdFunc( eProtEnum );
+      }
+      else
+      {
+        // set error flag
+        eStatus = BINPARSE_STS_ERR_ILLHAND;
+      }
+    }
+    else
+    {
+      // illegal flag
+      eStatus = BINPARSE_STS_ERR_ILLFLG;
+    }
+  }
+  else
+  {
+    // command lengths does not match
+    eStatus = BINPARSE_STS_ERR_ILLLEN;
+  }
+  
+  // return the status
+  return( eStatus );
+}
+
+#if ( BINARYCOMMANDHANDLER_ENABLE_DISPATCH == 1 )
+/******************************************************************************
+ * @function BuildDispatch
+ *
+ * @brief build the dispatch array
+ *
+ * This function walks the command tables in the same order as the table search,
+ * including the nested tables, and stores the first entry that matches each of
+ * the 256 command values.  If the walk stops on a missing table or too many
+ * nested tables, that error is reported for the commands that were not found
+ *
+ * @param[in]   ptCtl           pointer to the protocol control
+ * @param[in]   ptCommandTable  pointer to the command table
+ *
+ *****************************************************************************/
+static void BuildDispatch( PPROTCTRL ptCtl, BINCMDSLVENTRY const * ptCommandTable )
+{
+  BINCMDSLVENTRY  tTableEntry;
+  U16             wCommand;
+  U8              nIdx;
+  BOOL            bRunFlag;
+
+  // clear the array/stack index
+  memset( ptCtl->aptDispatch, 0, sizeof( ptCtl->aptDispatch ));
+  ptCtl->nStackIndex = 0;
+  nIdx = 0;
+  
+  // check for a table
+  ptCtl->eDispatchSts = BINPARSE_STS_ERR_NOCMDTBL;
+  bRunFlag = ( ptCommandTable != NULL ) ? TRUE : FALSE;
+  
+  // loop till end of table
+  while( bRunFlag )
+  {
+    // get a copy of the table entry
+    MEMCPY_P( &tTableEntry, ( ptCommandTable + nIdx ), BINCMDSLVENTRY_SIZE );
+
+    // test for end of table
+    if ( tTableEntry.nCommand == BINCMD_END_TABLE )
+    {
+      // check if is the last table
+      if ( ptCtl->nStackIndex == 0 )
+      {
+        // any command not found is an illegal command
+        ptCtl->eDispatchSts = BINPARSE_STS_ERR_ILLCMD;
+        bRunFlag = FALSE;
+      }
+      else
+      {
+        // get the table pointer/index from the stack
+        ptCommandTable = ptCtl->atTableStack[ --ptCtl->nStackIndex ];
+        nIdx = ptCtl->anIndexStack[ ptCtl->nStackIndex ];
+      }
+    }
+    else if ( tTableEntry.nCommand == BINCMD_EXT_TABLE )
+    {
+      // check for room on stack and a table
+      if ( ptCtl->nStackIndex >= BINARYCOMMANDHANDLER_TABLE_STACK_DEPTH )
+      {
+        // report an error
+        ptCtl->eDispatchSts = BINPARSE_STS_ERR_TOOMANYTBLS;
+        bRunFlag = FALSE;
+      }
+      else if ( tTableEntry.pvExtTable == NULL )
+      {
+        // report an error
+        ptCtl->eDispatchSts = BINPARSE_STS_ERR_NOCMDTBL;
+        bRunFlag = FALSE;
+      }
+      else
+      {
+        // save the table pointer/next index on the stack/get the next table
+        ptCtl->anIndexStack[ ptCtl->nStackIndex ] = nIdx + 1;
+        ptCtl->atTableStack[ ptCtl->nStackIndex++ ] = ptCommandTable;
+        ptCommandTable = ( BINCMDSLVENTRY const * )tTableEntry.pvExtTable;
+        nIdx = 0;
+      }
+    }
+    else
+    {
+      // store this entry for every command it matches that has no entry yet
+      for ( wCommand = 0; wCommand < 256; wCommand++ )
+      {
+        if (( ptCtl->aptDispatch[ wCommand ] == NULL ) && ( tTableEntry.nCommand == ( wCommand & ~tTableEntry.nCmdMask )))
+        {
+          ptCtl->aptDispatch[ wCommand ] = ptCommandTable + nIdx;
+        }
+      }
+      
+      // next entry
+      nIdx++;
+    }
+  }
+  
+  // reset the stack index
+  ptCtl->nStackIndex = 0;
+}
+#endif // BINARYCOMMANDHANDLER_ENABLE_DISPATCH
+
 /**@} EOF BinaryCommandHandler.c */
 
@@ -25,6 +25,7 @@
 #include "ConfigManager/ConfigManager.h"
 
 // library includes -----------------------------------------------------------
+#include "EepromHandler/EepromHandler.h"
 #if ( SYSTEMDEFINE_OS_SELECTION != SYSTEMDEFINE_OS_MINIMAL )
   #include "ManufInfo/ManufInfo.h"
 #endif // SYSTEMDEFINE_OS_SELECTION
@@ -43,6 +44,7 @@
 const CODE CONFIGMGRBLKDEF atConfigDefs[ CONFIG_TYPE_MAX ] =
 {
   /// create definitions here wih the below macro
+  /// with CONFIGMANAGER_ENABLE_LAZY_VERIFY the owners must access their blocks through ConfigManager_GetActual
   // CONFIGMGRFIXBLKDEF( size, getdefault, getactual )
   // CONFIGMGRVARBLKDEF( getsize, getdefault, getactual )
 };
@@ -219,6 +221,29 @@ BOOL ConfigManager_WrBlock( U16 wAddress, U16 wLength, PU8 pnData )
   return( bError );
 }
 
+/******************************************************************************
+ * @function ConfigManager_Sync
+ *
+ * @brief sync the storage
+ *
+ * This function will commit any buffered writes to the EEPROM
+ *
+ * @return        TRUE if errors detected, FALSE otherwise
+ *
+ *****************************************************************************/
+BOOL ConfigManager_Sync( void )
+{
+  BOOL bError = FALSE;
+
+  #if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+    // flush the page cache
+    bError = ( EepromHandler_Flush( ) != EEPROM_ERR_NONE ) ? TRUE : FALSE;
+  #endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
+
+  // return the error
+  return( bError );
+}
+
 #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
 /******************************************************************************
  * @function ConfigManager_ProcessUpdate
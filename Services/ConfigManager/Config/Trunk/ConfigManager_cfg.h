@@ -60,6 +60,7 @@ extern  BOOL  ConfigManager_RdWord( U16 wAddress, PU16 wValue );
 extern  BOOL  ConfigManager_RdBlock( U16 wAddress, U16 wLength, PU8 pnData );
 extern  BOOL  ConfigManager_WrWord( U16 wAddress, U16 wValue );
 extern  BOOL  ConfigManager_WrBlock( U16 wAddress, U16 wLength, PU8 pnData );
+extern  BOOL  ConfigManager_Sync( void );
 
 #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER )
   extern  BOOL  ConfigManager_ProcessUpdate( TASKARG xArg );
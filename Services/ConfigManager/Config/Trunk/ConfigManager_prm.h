@@ -52,6 +52,24 @@
   #endif	// CONFIGMANAGER_ENABLE_CALLBACKS
 #endif	// CONFIGMANAGER_ENABLE_NOTIFICATIONS
 
+/// define the macro to enable per block CRC's ( only changed blocks are written )
+#define CONFIGMANAGER_ENABLE_BLOCK_CRCS         ( 0 )
+
+#if ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+  /// define the macro to load/verify each block on the first access, blocks must then be accessed with ConfigManager_GetActual
+  #define CONFIGMANAGER_ENABLE_LAZY_VERIFY      ( 0 )
+#endif
+
+/// define the macro to enable A/B slots ( the image is written to the inactive
+/// slot and committed with its header )
+#define CONFIGMANAGER_ENABLE_AB_SLOTS           ( 0 )
+
+#if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+  /// define the size of a slot, must hold the header and all blocks ( checked at initialization, nothing is stored if they do not fit ),
+  /// both slots must fit between EEPROMHANDLER_CFGBLOCK_BASE_ADDR and EEPROMHANDLER_LOGBLOCK_BASE_ADDR
+  #define CONFIGMANAGER_SLOT_SIZE               ( 64 )
+#endif
+
 /// define the macro to enable config version reset
 #define CONFIGMGR_ENABLE_CONFIGFVER             ( ON )
 
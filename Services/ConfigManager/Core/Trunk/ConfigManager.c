@@ -38,19 +38,93 @@
 /// define the address of the version block
 #define CFGBLK_VERS_ADDR          ( CFGBLK_CHCK_ADDR + sizeof( U16 ))  
 
-/// define the address of the config block
-#define CFGBLK_DATA_ADDR          ( CFGBLK_VERS_ADDR + sizeof( U16 ))
+#if ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+  /// define the address of the block CRC table
+  #define CFGBLK_BCRC_ADDR        ( CFGBLK_VERS_ADDR + sizeof( U16 ))
+
+  /// define the address of the config block
+  #define CFGBLK_DATA_ADDR        ( CFGBLK_BCRC_ADDR + ( CONFIG_TYPE_MAX * sizeof( U16 )))
+#else
+  /// define the address of the config block
+  #define CFGBLK_DATA_ADDR        ( CFGBLK_VERS_ADDR + sizeof( U16 ))
+#endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
+
+#if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+  #if ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+    #error A/B slots and block CRCs can not both be enabled in ConfigManager_prm.h
+  #endif
+
+  /// define the number of slots
+  #define CFGSLOT_NUM_SLOTS       ( 2 )
+
+  /// define the address of a slot/the config block in a slot
+  #define CFGSLOT_BASE_ADDR( slot )   ( EEPROMHANDLER_CFGBLOCK_BASE_ADDR + (( slot ) * CONFIGMANAGER_SLOT_SIZE ))
+  #define CFGSLOT_DATA_ADDR( slot )   ( CFGSLOT_BASE_ADDR( slot ) + SLOTHEADER_SIZE )
+
+  /// define the end of the slots
+  #define CFGSLOT_END_ADDR        ( EEPROMHANDLER_CFGBLOCK_BASE_ADDR + ( CFGSLOT_NUM_SLOTS * CONFIGMANAGER_SLOT_SIZE ))
+
+  // the slots must fit in the device and stay clear of the parameter block
+  // and of the log block, which runs to the end of the device
+  #if ( CFGSLOT_END_ADDR > EEPROMHANDLER_DEV_SIZE )
+    #error The A/B slots do not fit in the EEPROM, check CONFIGMANAGER_SLOT_SIZE in ConfigManager_prm.h
+  #endif
+  #if ( EEPROMHANDLER_LOGBLOCK_BASE_ADDR < CFGSLOT_END_ADDR )
+    #error The A/B slots overlap the log block, check CONFIGMANAGER_SLOT_SIZE in ConfigManager_prm.h
+  #endif
+  #if (( EEPROMHANDLER_PRMBLOCK_BASE_ADDR < CFGSLOT_END_ADDR ) && ( EEPROMHANDLER_PRMBLOCK_BASE_ADDR > EEPROMHANDLER_CFGBLOCK_BASE_ADDR ))
+    #error The A/B slots overlap the parameter block, check CONFIGMANAGER_SLOT_SIZE in ConfigManager_prm.h
+  #endif
+#endif // CONFIGMANAGER_ENABLE_AB_SLOTS
 
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
+#if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+/// define the slot header
+typedef struct _SLOTHEADER
+{
+  U16   wSequence;        ///< sequence number, the newest slot is active
+  U16   wVersion;         ///< configuration version
+  U16   wImageCrc;        ///< CRC of the blocks
+  U16   wHeaderCrc;       ///< CRC of the above fields
+} SLOTHEADER, *PSLOTHEADER;
+#define SLOTHEADER_SIZE   sizeof( SLOTHEADER )
+#endif // CONFIGMANAGER_ENABLE_AB_SLOTS
 
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
+#if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+  static  U8          nActiveSlot;
+  static  SLOTHEADER  tActiveHeader;
+  static  BOOL        bSlotFits;
+#endif // CONFIGMANAGER_ENABLE_AB_SLOTS
+#if ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+  static  U16   awBlockCrc[ CONFIG_TYPE_MAX ];
+  static  U16   awBlockBase[ CONFIG_TYPE_MAX ];
+  #if ( CONFIGMANAGER_ENABLE_LAZY_VERIFY == 1 )
+    static  BOOL  abBlockLoaded[ CONFIG_TYPE_MAX ];
+  #endif // CONFIGMANAGER_ENABLE_LAZY_VERIFY
+#endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
 
 // local function prototypes --------------------------------------------------
 static  U16 GetBlockSize( PCONFIGMGRBLKDEF  ptDef );
+#if ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+  static  void  LoadBlock( CONFIGTYPE eCfgType );
+  static  BOOL  StoreBlock( CONFIGTYPE eCfgType, BOOL bUpdateHeader );
+  static  BOOL  GetSourceCrc( CONFIGTYPE eCfgType, CONFIGSOURCE eSource, PU16 pwCrc );
+  static  BOOL  WriteHeader( void );
+#endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
+#if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+  static  BOOL  LoadNewestSlot( U16 wVersion );
+  static  U16   LoadSlot( U8 nSlot );
+  static  BOOL  ReadSlotHeader( U8 nSlot, PSLOTHEADER ptHeader );
+  static  BOOL  CommitSlot( void );
+#endif // CONFIGMANAGER_ENABLE_AB_SLOTS
+#if (( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 ) || ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 ))
+  static  BOOL  CompareBlock( U16 wBase, U16 wSize, PU8 pnData );
+#endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS || CONFIGMANAGER_ENABLE_AB_SLOTS
 
 /// command handlers
 #if ( CONFIGMANAGER_ENABLE_DEBUG_COMMANDS == 1 )
@@ -83,14 +157,23 @@ const CODE ASCCMDENTRY g_atConfigManagerCmdHandlerTable[ ] =
  *****************************************************************************/
 void ConfigManager_Initialize( BOOL bForceReset )
 {
-  U16               wCalcCrc, wActCrc, wSize, wActVersion;
+  #if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 0 )
+  U16               wCalcCrc, wActCrc, wActVersion;
   CONFIGTYPE        eCfgBlkIdx;
+  #if ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 0 )
+  U16               wSize;
   PCONFIGMGRBLKDEF  ptDef;
   PVGETPOINTER      pvGetPointerActual;
   PU8               pnActual;
+  BOOL              bCrcError;
+  #endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
   U16               wBase;
+  #else
+  U32               uImageSize;
+  CONFIGTYPE        eCfgBlkIdx;
+  #endif // CONFIGMANAGER_ENABLE_AB_SLOTS
   U16UN             tExpVersion;
-  
+
   // perform any local initialization
   ConfigManager_LocalInitialize( );
 
@@ -98,12 +181,40 @@ void ConfigManager_Initialize( BOOL bForceReset )
   tExpVersion.anValue[ LE_U16_MSB_IDX ] = ConfigManager_GetVerMajor( );
   tExpVersion.anValue[ LE_U16_LSB_IDX ] = ConfigManager_GetVerMinor( );
 
+  #if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+  // compute the size of the header and all blocks
+  uImageSize = SLOTHEADER_SIZE;
+  for ( eCfgBlkIdx = 0; eCfgBlkIdx < CONFIG_TYPE_MAX; eCfgBlkIdx++ )
+  {
+    uImageSize += GetBlockSize(( PCONFIGMGRBLKDEF )&atConfigDefs[ eCfgBlkIdx ] );
+  }
+
+  // the slots are never read or written if the image does not fit
+  bSlotFits = ( uImageSize <= CONFIGMANAGER_SLOT_SIZE ) ? TRUE : FALSE;
+
+  // load the newest valid slot
+  if (( bSlotFits == FALSE ) || ( LoadNewestSlot( tExpVersion.wValue ) == FALSE ) || ( bForceReset == TRUE ))
+  {
+    // reset to defaults
+    ConfigManager_ResetDefaults( );
+  }
+  #else
   // get the stored CRC/version
   ConfigManager_RdWord( CFGBLK_CHCK_ADDR, &wActCrc );
   ConfigManager_RdWord( CFGBLK_VERS_ADDR, &wActVersion );
-  
-  // get the actual CRC
-  wCalcCrc = ConfigManager_ComputeBlockCrc( CONFIG_SOURCE_EEPROM );
+
+  #if ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+  // compute the base address of each block
+  wBase = CFGBLK_DATA_ADDR;
+  for ( eCfgBlkIdx = 0; eCfgBlkIdx < CONFIG_TYPE_MAX; eCfgBlkIdx++ )
+  {
+    awBlockBase[ eCfgBlkIdx ] = wBase;
+    wBase += GetBlockSize(( PCONFIGMGRBLKDEF )&atConfigDefs[ eCfgBlkIdx ] );
+  }
+
+  // read the block CRC's/check them against the header
+  ConfigManager_RdBlock( CFGBLK_BCRC_ADDR, sizeof( awBlockCrc ), ( PU8 )awBlockCrc );
+  wCalcCrc = CRC16_CalculateBlock(( PU8 )awBlockCrc, sizeof( awBlockCrc ));
 
   // are they the same
   if (( bForceReset == TRUE ) || ( wActCrc != wCalcCrc ) || ( wActVersion != tExpVersion.wValue ))
@@ -111,6 +222,30 @@ void ConfigManager_Initialize( BOOL bForceReset )
     // reset to defaults
     ConfigManager_ResetDefaults( );
   }
+  else
+  {
+    // for each block
+    for ( eCfgBlkIdx = 0; eCfgBlkIdx < CONFIG_TYPE_MAX; eCfgBlkIdx++ )
+    {
+      #if ( CONFIGMANAGER_ENABLE_LAZY_VERIFY == 1 )
+        // load on the first access
+        abBlockLoaded[ eCfgBlkIdx ] = FALSE;
+      #else
+        // load/verify it
+        LoadBlock( eCfgBlkIdx );
+      #endif // CONFIGMANAGER_ENABLE_LAZY_VERIFY
+    }
+  }
+  #else
+  // get the actual CRC, a CRC that could not be computed does not reset the stored block
+  bCrcError = ConfigManager_ComputeBlockCrc( CONFIG_SOURCE_EEPROM, &wCalcCrc );
+
+  // are they the same
+  if (( bForceReset == TRUE ) || (( bCrcError == FALSE ) && ( wActCrc != wCalcCrc )) || ( wActVersion != tExpVersion.wValue ))
+  {
+    // reset to defaults
+    ConfigManager_ResetDefaults( );
+  }
 
   // now copy the EEPROM to the local storage
   wBase = CFGBLK_DATA_ADDR;
@@ -132,6 +267,8 @@ void ConfigManager_Initialize( BOOL bForceReset )
     // adjust the size
     wBase += wSize;
   }
+  #endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
+  #endif // CONFIGMANAGER_ENABLE_AB_SLOTS
 
   // post the config done event
   #if ( CONFIGMANAGER_ENABLE_NOTIFICATIONS == 1 )
@@ -157,6 +294,7 @@ BOOL ConfigManager_ResetDefaults( void )
   PVGETPOINTER      pvGetPointer;
   PU8               pnActual, pnDefault;
   BOOL              bStatus = FALSE;
+  #if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 0 )
   U16               wBase;
   U16UN             tVersion;
 
@@ -169,42 +307,68 @@ BOOL ConfigManager_ResetDefaults( void )
 
   // set the base address for the config blocks  
   wBase = CFGBLK_DATA_ADDR;
+  #endif // CONFIGMANAGER_ENABLE_AB_SLOTS
 
   // for each block copy the data to EEPROM
   for ( eCfgBlkIdx = 0; eCfgBlkIdx < CONFIG_TYPE_MAX; eCfgBlkIdx++ )
   {
     // get the definition
     ptDef = ( PCONFIGMGRBLKDEF )&atConfigDefs[ eCfgBlkIdx ];
-    
+
     // now get a pointer to the actual/defaults/size
     pvGetPointer = ( PVOID )PGM_RDWORD( ptDef->pvGetActual );
     pnActual = ( PU8 )pvGetPointer( );
     pvGetPointer = ( PVOID )PGM_RDWORD( ptDef->pvGetDefault );
     pnDefault = ( PU8 )pvGetPointer( );
     wSize = GetBlockSize( ptDef );
-    
+
     // now copy the default to the actual
     MEMCPY_P( pnActual, pnDefault, wSize );
 
+    #if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+      // the image is written to the inactive slot when committed
+    #elif ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+      // set the base/write the block if changed
+      awBlockBase[ eCfgBlkIdx ] = wBase;
+      #if ( CONFIGMANAGER_ENABLE_LAZY_VERIFY == 1 )
+        abBlockLoaded[ eCfgBlkIdx ] = TRUE;
+      #endif // CONFIGMANAGER_ENABLE_LAZY_VERIFY
+      bStatus = StoreBlock( eCfgBlkIdx, FALSE );
+    #else
     // now write the data to the EEPROM
-    if ( ConfigManager_WrBlock( wBase, wSize, pnActual ))
+    bStatus = ConfigManager_WrBlock( wBase, wSize, pnActual );
+    #endif // CONFIGMANAGER_ENABLE_AB_SLOTS
+    if ( bStatus )
     {
       // set the error flag/exit loop
       bStatus = TRUE;
       break;
     }
-    
+
+    #if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 0 )
     // adjust the size
     wBase += wSize;
+    #endif // CONFIGMANAGER_ENABLE_AB_SLOTS
   }
-  
+
   // if no error
   if ( bStatus == FALSE )
   {
+    #if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+      // commit the image
+      bStatus = CommitSlot( );
+    #elif ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+      // update the header
+      bStatus = WriteHeader( );
+    #else
     // update the CRC
     ConfigManager_UpdateCRC( CONFIG_SOURCE_EEPROM );
+    #endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
   }
 
+  // sync the storage
+  ConfigManager_Sync( );
+
   // test for log handler
   #if ( CONFIGMANAGER_ENABLE_LOGEVENTS == 1 )
     LogHandler_AddEntry( LOG_TYPE_CFGRST, wCrc, bStatus );
@@ -227,9 +391,14 @@ BOOL ConfigManager_ResetDefaults( void )
 U16 ConfigManager_GetSignature( void )
 {
   U16         wActCrc;
-  
+
+  #if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+    // get the CRC of the active slot
+    wActCrc = tActiveHeader.wImageCrc;
+  #else
   // get the stored CRC
   ConfigManager_RdWord( CFGBLK_CHCK_ADDR, &wActCrc );
+  #endif // CONFIGMANAGER_ENABLE_AB_SLOTS
 
   // return the actual CRC
   return( wActCrc );
@@ -240,7 +409,8 @@ U16 ConfigManager_GetSignature( void )
  *
  * @brief update the CRC of the entire block
  *
- * This function calculates the CRC of the block and returns the CRC
+ * This function calculates the CRC of the block and returns the CRC.  If the
+ * CRC can not be computed the stored CRC is left unchanged
  *
  * @param[in]   eSource   source to calculate the CRC on
  *
@@ -250,10 +420,50 @@ U16 ConfigManager_GetSignature( void )
 U16 ConfigManager_UpdateCRC( CONFIGSOURCE eSource )
 {
   U16 wCalcCrc;
+  #if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+  // the image is always computed from the actual blocks
+  ( void )eSource;
+
+  // the CRC is only written with the image, commit the actual blocks
+  CommitSlot( );
+  wCalcCrc = tActiveHeader.wImageCrc;
+  #elif ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+  CONFIGTYPE  eCfgBlkIdx;
+  U16         awSourceCrc[ CONFIG_TYPE_MAX ];
+  BOOL        bError = FALSE;
+
+  // compute each block CRC
+  for ( eCfgBlkIdx = 0; ( eCfgBlkIdx < CONFIG_TYPE_MAX ) && ( bError == FALSE ); eCfgBlkIdx++ )
+  {
+    bError = GetSourceCrc( eCfgBlkIdx, eSource, &awSourceCrc[ eCfgBlkIdx ] );
+  }
+
+  // only a complete table is written
+  if ( bError == FALSE )
+  {
+    // write the table/header
+    memcpy( awBlockCrc, awSourceCrc, sizeof( awBlockCrc ));
+    ConfigManager_WrBlock( CFGBLK_BCRC_ADDR, sizeof( awBlockCrc ), ( PU8 )awBlockCrc );
+    WriteHeader( );
+  }
+  wCalcCrc = CRC16_CalculateBlock(( PU8 )awBlockCrc, sizeof( awBlockCrc ));
+  #else
 
   // calculate the CRC block
-  wCalcCrc = ConfigManager_ComputeBlockCrc( eSource );
-  ConfigManager_WrWord( CFGBLK_CHCK_ADDR, wCalcCrc );
+  if ( ConfigManager_ComputeBlockCrc( eSource, &wCalcCrc ) == FALSE )
+  {
+    // write it
+    ConfigManager_WrWord( CFGBLK_CHCK_ADDR, wCalcCrc );
+  }
+  else
+  {
+    // return the stored one
+    ConfigManager_RdWord( CFGBLK_CHCK_ADDR, &wCalcCrc );
+  }
+  #endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
+
+  // sync the storage
+  ConfigManager_Sync( );
 
   // return the CRC
   return( wCalcCrc );
@@ -267,12 +477,78 @@ U16 ConfigManager_UpdateCRC( CONFIGSOURCE eSource )
  * This function computes the CRC of the defined configuration block (EEPROM/RAM)
  *
  * @param[in]   eSource   source to compute the CRC on
+ * @param[io]   pwCrc     pointer to store the CRC of the block
  *
- * @return      the CRC of the block
+ * @return      TRUE if the CRC could not be computed, FALSE otherwise
  *
  *****************************************************************************/
-U16 ConfigManager_ComputeBlockCrc( CONFIGSOURCE eSource )
+BOOL ConfigManager_ComputeBlockCrc( CONFIGSOURCE eSource, PU16 pwCrc )
 {
+  BOOL              bError = FALSE;
+  #if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+  U16               wCrc, wSize, wBase;
+  CONFIGTYPE        eCfgBlkIdx;
+  PCONFIGMGRBLKDEF  ptDef;
+  PVGETPOINTER      pvGetPointer;
+  PU8               pnData;
+
+  // get the initial value
+  wCrc = CRC16_GetInitialValue( );
+
+  // for each block in the active slot
+  wBase = CFGSLOT_DATA_ADDR( nActiveSlot );
+  for( eCfgBlkIdx = 0; ( eCfgBlkIdx < CONFIG_TYPE_MAX ) && ( bError == FALSE ); eCfgBlkIdx++ )
+  {
+    // get the definition/size
+    ptDef = ( PCONFIGMGRBLKDEF )&atConfigDefs[ eCfgBlkIdx ];
+    wSize = GetBlockSize( ptDef );
+
+    // determine source
+    switch( eSource )
+    {
+      case CONFIG_SOURCE_EEPROM :
+        // allocate temporary space/read the block
+        if (( pnData = malloc( wSize )) != NULL )
+        {
+          bError = ConfigManager_RdBlock( wBase, wSize, pnData );
+          wCrc = CRC16_Update( wCrc, pnData, wSize );
+          free( pnData );
+        }
+        else
+        {
+          // no space
+          bError = TRUE;
+        }
+        break;
+
+      case CONFIG_SOURCE_RAM :
+        // get a pointer to the actual data
+        pvGetPointer = ( PVOID )PGM_RDWORD( ptDef->pvGetActual );
+        pnData = ( PU8 )pvGetPointer( );
+        wCrc = CRC16_Update( wCrc, pnData, wSize );
+        break;
+
+      default :
+        break;
+    }
+
+    // adjust the base
+    wBase += wSize;
+  }
+  #elif ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+  U16         wCrc, wBlkCrc;
+  CONFIGTYPE  eCfgBlkIdx;
+
+  // get the initial value
+  wCrc = CRC16_GetInitialValue( );
+
+  // the CRC is computed over the block CRC's
+  for( eCfgBlkIdx = 0; ( eCfgBlkIdx < CONFIG_TYPE_MAX ) && ( bError == FALSE ); eCfgBlkIdx++ )
+  {
+    bError = GetSourceCrc( eCfgBlkIdx, eSource, &wBlkCrc );
+    wCrc = CRC16_Update( wCrc, ( PU8 )&wBlkCrc, sizeof( U16 ));
+  }
+  #else
   U16               wCrc, wBlkDataIdx, wSize;
   CONFIGTYPE        eCfgBlkIdx;
   PCONFIGMGRBLKDEF  ptDef;
@@ -287,7 +563,7 @@ U16 ConfigManager_ComputeBlockCrc( CONFIGSOURCE eSource )
   wBase = CFGBLK_DATA_ADDR;
   
   // for each config block
-  for( eCfgBlkIdx = 0; eCfgBlkIdx < CONFIG_TYPE_MAX; eCfgBlkIdx++ )
+  for( eCfgBlkIdx = 0; ( eCfgBlkIdx < CONFIG_TYPE_MAX ) && ( bError == FALSE ); eCfgBlkIdx++ )
   {
     // get the definition
     ptDef = ( PCONFIGMGRBLKDEF )&atConfigDefs[ eCfgBlkIdx ];
@@ -301,10 +577,16 @@ U16 ConfigManager_ComputeBlockCrc( CONFIGSOURCE eSource )
     {
       case CONFIG_SOURCE_EEPROM :
         // allocate temporary space for the config block
-        pnActData = malloc( wSize );
-
-        // read a byte from EEPROM
-        ConfigManager_RdBlock( wBase, wSize, pnActData );
+        if (( pnActData = malloc( wSize )) != NULL )
+        {
+          // read the block from EEPROM
+          bError = ConfigManager_RdBlock( wBase, wSize, pnActData );
+        }
+        else
+        {
+          // no space
+          bError = TRUE;
+        }
         break;
         
       case CONFIG_SOURCE_RAM :
@@ -317,7 +599,7 @@ U16 ConfigManager_ComputeBlockCrc( CONFIGSOURCE eSource )
     }
 
     // now for each byte 
-    for ( wBlkDataIdx = 0; wBlkDataIdx < wSize; wBlkDataIdx++ )
+    for ( wBlkDataIdx = 0; ( wBlkDataIdx < wSize ) && ( pnActData != NULL ); wBlkDataIdx++ )
     {
       // now add to crc
       wCrc = CRC16_CalculateByte( wCrc, *( pnActData + wBlkDataIdx ));
@@ -333,9 +615,16 @@ U16 ConfigManager_ComputeBlockCrc( CONFIGSOURCE eSource )
     // adjust the size
     wBase += wSize;
   }
-  
-  // return the CRC
-  return( wCrc );
+  #endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
+
+  // store the CRC
+  if ( bError == FALSE )
+  {
+    *( pwCrc ) = wCrc;
+  }
+
+  // return the error
+  return( bError );
 }
 
 /******************************************************************************
@@ -350,6 +639,24 @@ U16 ConfigManager_ComputeBlockCrc( CONFIGSOURCE eSource )
  *****************************************************************************/
 void ConfigManager_UpdateConfig( CONFIGTYPE eConfigType )
 {
+  #if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+  // the whole image is committed
+  ( void )eConfigType;
+
+  // commit the image
+  CommitSlot( );
+  #elif ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+  #if ( CONFIGMANAGER_ENABLE_LAZY_VERIFY == 1 )
+    // an unloaded actual was never read from EEPROM, load it before storing
+    if ( abBlockLoaded[ eConfigType ] == FALSE )
+    {
+      LoadBlock( eConfigType );
+    }
+  #endif // CONFIGMANAGER_ENABLE_LAZY_VERIFY
+
+  // write the block if changed
+  StoreBlock( eConfigType, TRUE );
+  #else
   PU8               pnActData;
   PCONFIGMGRBLKDEF  ptDef;
   PVGETPOINTER      pvGetPointer;
@@ -392,6 +699,10 @@ void ConfigManager_UpdateConfig( CONFIGTYPE eConfigType )
     // now update the CRC
     ConfigManager_UpdateCRC( CONFIG_SOURCE_EEPROM );
   }
+  #endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
+
+  // sync the storage
+  ConfigManager_Sync( );
 
   // log event
   #if ( CONFIGMANAGER_ENABLE_LOGEVENTS == 1 )
@@ -399,9 +710,487 @@ void ConfigManager_UpdateConfig( CONFIGTYPE eConfigType )
   #endif
 }
 
+#if ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
 /******************************************************************************
- * @function GetBLockSize
+ * @function ConfigManager_GetActual
+ *
+ * @brief get a pointer to the actual block
+ *
+ * This function will return a pointer to the actual data of a block, loading
+ * and verifying the block on the first access.  With lazy verify enabled the
+ * owners must access their blocks through this function, the pvGetActual
+ * pointer of an unloaded block does not hold the stored data
+ *
+ * @param[in]   eConfigType   configuration type
+ *
+ * @return      pointer to the actual data
+ *
+ *****************************************************************************/
+PU8 ConfigManager_GetActual( CONFIGTYPE eConfigType )
+{
+  PVGETPOINTER  pvGetPointer;
+
+  #if ( CONFIGMANAGER_ENABLE_LAZY_VERIFY == 1 )
+    // load the block if not already loaded
+    if ( abBlockLoaded[ eConfigType ] == FALSE )
+    {
+      LoadBlock( eConfigType );
+    }
+  #endif // CONFIGMANAGER_ENABLE_LAZY_VERIFY
+
+  // get the pointer to the actual
+  pvGetPointer = ( PVOID )PGM_RDWORD( atConfigDefs[ eConfigType ].pvGetActual );
+
+  // return it
+  return( pvGetPointer( ));
+}
+
+/******************************************************************************
+ * @function LoadBlock
+ *
+ * @brief load a block
+ *
+ * This function will read a block from the EEPROM and check it against its
+ * CRC, restoring the defaults of that block only if invalid
+ *
+ * @param[in]   eCfgType    configuration type
+ *
+ *****************************************************************************/
+static void LoadBlock( CONFIGTYPE eCfgType )
+{
+  PCONFIGMGRBLKDEF  ptDef;
+  PVGETPOINTER      pvGetPointer;
+  PU8               pnActual, pnDefault;
+  U16               wSize;
+
+  // get the definition/actual/size
+  ptDef = ( PCONFIGMGRBLKDEF )&atConfigDefs[ eCfgType ];
+  pvGetPointer = ( PVOID )PGM_RDWORD( ptDef->pvGetActual );
+  pnActual = ( PU8 )pvGetPointer( );
+  wSize = GetBlockSize( ptDef );
+
+  // read the block/check it
+  if (( ConfigManager_RdBlock( awBlockBase[ eCfgType ], wSize, pnActual )) ||
+      ( CRC16_CalculateBlock( pnActual, wSize ) != awBlockCrc[ eCfgType ] ))
+  {
+    // copy the defaults
+    pvGetPointer = ( PVOID )PGM_RDWORD( ptDef->pvGetDefault );
+    pnDefault = ( PU8 )pvGetPointer( );
+    MEMCPY_P( pnActual, pnDefault, wSize );
+
+    // write the block
+    StoreBlock( eCfgType, TRUE );
+  }
+
+  #if ( CONFIGMANAGER_ENABLE_LAZY_VERIFY == 1 )
+    // flag it loaded
+    abBlockLoaded[ eCfgType ] = TRUE;
+  #endif // CONFIGMANAGER_ENABLE_LAZY_VERIFY
+}
+
+/******************************************************************************
+ * @function StoreBlock
+ *
+ * @brief store a block
+ *
+ * This function will write the actual block and its CRC to EEPROM if it has
+ * changed, a matching CRC is confirmed against the stored block
+ *
+ * @param[in]   eCfgType        configuration type
+ * @param[in]   bUpdateHeader   TRUE to write the header if changed
+ *
+ * @return      TRUE if errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL StoreBlock( CONFIGTYPE eCfgType, BOOL bUpdateHeader )
+{
+  BOOL              bError = FALSE;
+  PCONFIGMGRBLKDEF  ptDef;
+  PVGETPOINTER      pvGetPointer;
+  PU8               pnActual;
+  U16               wSize, wCrc;
+
+  // get the definition/actual/size
+  ptDef = ( PCONFIGMGRBLKDEF )&atConfigDefs[ eCfgType ];
+  pvGetPointer = ( PVOID )PGM_RDWORD( ptDef->pvGetActual );
+  pnActual = ( PU8 )pvGetPointer( );
+  wSize = GetBlockSize( ptDef );
+
+  // compute the CRC
+  wCrc = CRC16_CalculateBlock( pnActual, wSize );
+
+  // check for changed
+  if (( wCrc != awBlockCrc[ eCfgType ] ) || ( CompareBlock( awBlockBase[ eCfgType ], wSize, pnActual )))
+  {
+    // write the block/its CRC
+    if (( bError = ConfigManager_WrBlock( awBlockBase[ eCfgType ], wSize, pnActual )) == FALSE )
+    {
+      awBlockCrc[ eCfgType ] = wCrc;
+      bError = ConfigManager_WrWord( CFGBLK_BCRC_ADDR + ( eCfgType * sizeof( U16 )), wCrc );
+    }
+
+    // update the header if requested
+    if (( bError == FALSE ) && ( bUpdateHeader == TRUE ))
+    {
+      bError = WriteHeader( );
+    }
+  }
+
+  // return the error
+  return( bError );
+}
+
+#endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
+
+#if (( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 ) || ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 ))
+/******************************************************************************
+ * @function CompareBlock
+ *
+ * @brief compare a block with the EEPROM
+ *
+ * This function will read the stored block and compare it to the data
+ *
+ * @param[in]   wBase       base address of the block
+ * @param[in]   wSize       size of the block
+ * @param[in]   pnData      pointer to the data
+ *
+ * @return      TRUE if different or unable to compare, FALSE if the same
+ *
+ *****************************************************************************/
+static BOOL CompareBlock( U16 wBase, U16 wSize, PU8 pnData )
+{
+  BOOL  bDifferent = TRUE;
+  PU8   pnStored;
+
+  // allocate temporary space for the block
+  if (( pnStored = malloc( wSize )) != NULL )
+  {
+    // read/compare it
+    if ( !ConfigManager_RdBlock( wBase, wSize, pnStored ))
+    {
+      bDifferent = ( memcmp( pnStored, pnData, wSize ) != 0 ) ? TRUE : FALSE;
+    }
+
+    // free it
+    free( pnStored );
+  }
+
+  // return the status
+  return( bDifferent );
+}
+#endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS || CONFIGMANAGER_ENABLE_AB_SLOTS
+
+#if ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+
+/******************************************************************************
+ * @function GetSourceCrc
+ *
+ * @brief compute a block CRC
+ *
+ * This function will compute the CRC of a block from the given source
+ *
+ * @param[in]   eCfgType    configuration type
+ * @param[in]   eSource     source to compute the CRC on
+ * @param[io]   pwCrc       pointer to store the CRC of the block
+ *
+ * @return      TRUE if the CRC could not be computed, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL GetSourceCrc( CONFIGTYPE eCfgType, CONFIGSOURCE eSource, PU16 pwCrc )
+{
+  BOOL              bError = TRUE;
+  PCONFIGMGRBLKDEF  ptDef;
+  PVGETPOINTER      pvGetPointer;
+  PU8               pnData;
+  U16               wSize;
+
+  // get the definition/size
+  ptDef = ( PCONFIGMGRBLKDEF )&atConfigDefs[ eCfgType ];
+  wSize = GetBlockSize( ptDef );
+
+  // determine source
+  switch( eSource )
+  {
+    case CONFIG_SOURCE_EEPROM :
+      // allocate temporary space/read the block
+      if (( pnData = malloc( wSize )) != NULL )
+      {
+        if (( bError = ConfigManager_RdBlock( awBlockBase[ eCfgType ], wSize, pnData )) == FALSE )
+        {
+          *( pwCrc ) = CRC16_CalculateBlock( pnData, wSize );
+        }
+        free( pnData );
+      }
+      break;
+
+    case CONFIG_SOURCE_RAM :
+      #if ( CONFIGMANAGER_ENABLE_LAZY_VERIFY == 1 )
+        // an unloaded actual was never read from EEPROM, load it first
+        if ( abBlockLoaded[ eCfgType ] == FALSE )
+        {
+          LoadBlock( eCfgType );
+        }
+      #endif // CONFIGMANAGER_ENABLE_LAZY_VERIFY
+
+      // get a pointer to the actual data
+      pvGetPointer = ( PVOID )PGM_RDWORD( ptDef->pvGetActual );
+      pnData = ( PU8 )pvGetPointer( );
+      *( pwCrc ) = CRC16_CalculateBlock( pnData, wSize );
+      bError = FALSE;
+      break;
+
+    default :
+      break;
+  }
+
+  // return the error
+  return( bError );
+}
+
+/******************************************************************************
+ * @function WriteHeader
+ *
+ * @brief write the header CRC
+ *
+ * This function will write the CRC of the block CRC table
+ *
+ * @return      TRUE if errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL WriteHeader( void )
+{
+  BOOL  bError;
+
+  // write the CRC of the table
+  bError = ConfigManager_WrWord( CFGBLK_CHCK_ADDR, CRC16_CalculateBlock(( PU8 )awBlockCrc, sizeof( awBlockCrc )));
+
+  // return the error
+  return( bError );
+}
+#endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
+
+#if ( CONFIGMANAGER_ENABLE_AB_SLOTS == 1 )
+/******************************************************************************
+ * @function LoadNewestSlot
+ *
+ * @brief load the newest valid slot
+ *
+ * This function will load the newest slot with a valid header, version and
+ * image, falling back to the other slot
+ *
+ * @param[in]   wVersion    expected version
+ *
+ * @return      TRUE if a slot was loaded, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL LoadNewestSlot( U16 wVersion )
+{
+  SLOTHEADER  atHeader[ CFGSLOT_NUM_SLOTS ];
+  BOOL        abValid[ CFGSLOT_NUM_SLOTS ];
+  BOOL        bLoaded = FALSE;
+  U8          nSlot, nIdx;
+
+  // read the headers
+  for ( nSlot = 0; nSlot < CFGSLOT_NUM_SLOTS; nSlot++ )
+  {
+    abValid[ nSlot ] = ReadSlotHeader( nSlot, &atHeader[ nSlot ] );
+  }
+
+  // start with the newest slot
+  nSlot = (( abValid[ 1 ] == TRUE ) && (( abValid[ 0 ] == FALSE ) || (( S16 )( atHeader[ 1 ].wSequence - atHeader[ 0 ].wSequence ) > 0 ))) ? 1 : 0;
+
+  // if none loaded, the next commit goes to the other slot
+  nActiveSlot = nSlot;
+  tActiveHeader.wSequence = ( abValid[ nSlot ] == TRUE ) ? atHeader[ nSlot ].wSequence : 0;
+
+  // try each slot
+  for ( nIdx = 0; ( nIdx < CFGSLOT_NUM_SLOTS ) && ( bLoaded == FALSE ); nIdx++ )
+  {
+    // check the header/load the image
+    if (( abValid[ nSlot ] == TRUE ) && ( atHeader[ nSlot ].wVersion == wVersion ) && ( LoadSlot( nSlot ) == atHeader[ nSlot ].wImageCrc ))
+    {
+      // this is the active slot
+      nActiveSlot = nSlot;
+      tActiveHeader = atHeader[ nSlot ];
+      bLoaded = TRUE;
+    }
+
+    // try the other slot
+    nSlot ^= 1;
+  }
+
+  // return the status
+  return( bLoaded );
+}
+
+/******************************************************************************
+ * @function LoadSlot
+ *
+ * @brief load a slot
+ *
+ * This function will read each block of a slot to the actual
+ *
+ * @param[in]   nSlot       slot
  *
+ * @return      the CRC of the image
+ *
+ *****************************************************************************/
+static U16 LoadSlot( U8 nSlot )
+{
+  U16               wCrc, wSize, wBase;
+  CONFIGTYPE        eCfgBlkIdx;
+  PCONFIGMGRBLKDEF  ptDef;
+  PVGETPOINTER      pvGetPointer;
+  PU8               pnActual;
+
+  // get the initial value
+  wCrc = CRC16_GetInitialValue( );
+
+  // for each block
+  wBase = CFGSLOT_DATA_ADDR( nSlot );
+  for ( eCfgBlkIdx = 0; eCfgBlkIdx < CONFIG_TYPE_MAX; eCfgBlkIdx++ )
+  {
+    // get the definition/actual/size
+    ptDef = ( PCONFIGMGRBLKDEF )&atConfigDefs[ eCfgBlkIdx ];
+    pvGetPointer = ( PVOID )PGM_RDWORD( ptDef->pvGetActual );
+    pnActual = ( PU8 )pvGetPointer( );
+    wSize = GetBlockSize( ptDef );
+
+    // read it/add to the CRC
+    ConfigManager_RdBlock( wBase, wSize, pnActual );
+    wCrc = CRC16_Update( wCrc, pnActual, wSize );
+
+    // adjust the base
+    wBase += wSize;
+  }
+
+  // return the CRC
+  return( wCrc );
+}
+
+/******************************************************************************
+ * @function ReadSlotHeader
+ *
+ * @brief read a slot header
+ *
+ * This function will read the header of a slot and check its CRC
+ *
+ * @param[in]   nSlot       slot
+ * @param[io]   ptHeader    pointer to store the header
+ *
+ * @return      TRUE if valid, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL ReadSlotHeader( U8 nSlot, PSLOTHEADER ptHeader )
+{
+  BOOL  bValid = FALSE;
+
+  // read/check it
+  if ( !ConfigManager_RdBlock( CFGSLOT_BASE_ADDR( nSlot ), SLOTHEADER_SIZE, ( PU8 )ptHeader ))
+  {
+    bValid = ( CRC16_CalculateBlock(( PU8 )ptHeader, SLOTHEADER_SIZE - sizeof( U16 )) == ptHeader->wHeaderCrc ) ? TRUE : FALSE;
+  }
+
+  // return the status
+  return( bValid );
+}
+
+/******************************************************************************
+ * @function CommitSlot
+ *
+ * @brief commit the actual blocks
+ *
+ * This function will write the changed blocks to the inactive slot and then
+ * make it active by writing its header with the next sequence number.  Nothing
+ * is written if the image does not fit in a slot
+ *
+ * @return      TRUE if errors, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL CommitSlot( void )
+{
+  BOOL              bError;
+  SLOTHEADER        tHeader;
+  U16               wSize, wBase;
+  U16UN             tVersion;
+  U8                nSlot;
+  CONFIGTYPE        eCfgBlkIdx;
+  PCONFIGMGRBLKDEF  ptDef;
+  PVGETPOINTER      pvGetPointer;
+  PU8               pnActual;
+
+  // refuse the commit if the image would overrun the slot
+  bError = ( bSlotFits == TRUE ) ? FALSE : TRUE;
+
+  // get the inactive slot
+  nSlot = nActiveSlot ^ 1;
+
+  // for each block
+  tHeader.wImageCrc = CRC16_GetInitialValue( );
+  wBase = CFGSLOT_DATA_ADDR( nSlot );
+  for ( eCfgBlkIdx = 0; ( eCfgBlkIdx < CONFIG_TYPE_MAX ) && ( bError == FALSE ); eCfgBlkIdx++ )
+  {
+    // get the definition/actual/size
+    ptDef = ( PCONFIGMGRBLKDEF )&atConfigDefs[ eCfgBlkIdx ];
+    pvGetPointer = ( PVOID )PGM_RDWORD( ptDef->pvGetActual );
+    pnActual = ( PU8 )pvGetPointer( );
+    wSize = GetBlockSize( ptDef );
+
+    // add to the CRC/write it if different
+    tHeader.wImageCrc = CRC16_Update( tHeader.wImageCrc, pnActual, wSize );
+    if ( CompareBlock( wBase, wSize, pnActual ))
+    {
+      bError = ConfigManager_WrBlock( wBase, wSize, pnActual );
+    }
+
+    // adjust the base
+    wBase += wSize;
+  }
+
+  // the blocks must be on the device before the header that activates them
+  if ( bError == FALSE )
+  {
+    bError = ConfigManager_Sync( );
+  }
+
+  // if no errors
+  if ( bError == FALSE )
+  {
+    // get the version
+    tVersion.anValue[ LE_U16_MSB_IDX ] = ConfigManager_GetVerMajor( );
+    tVersion.anValue[ LE_U16_LSB_IDX ] = ConfigManager_GetVerMinor( );
+
+    // build the header
+    tHeader.wSequence = tActiveHeader.wSequence + 1;
+    tHeader.wVersion = tVersion.wValue;
+    tHeader.wHeaderCrc = CRC16_CalculateBlock(( PU8 )&tHeader, SLOTHEADER_SIZE - sizeof( U16 ));
+
+    // now write it
+    bError = ConfigManager_WrBlock( CFGSLOT_BASE_ADDR( nSlot ), SLOTHEADER_SIZE, ( PU8 )&tHeader );
+    
+    // sync the header
+    if ( bError == FALSE )
+    {
+      bError = ConfigManager_Sync( );
+    }
+    
+    // check for written
+    if ( bError == FALSE )
+    {
+      // this is now the active slot
+      nActiveSlot = nSlot;
+      tActiveHeader = tHeader;
+    }
+  }
+
+  // return the error
+  return( bError );
+}
+#endif // CONFIGMANAGER_ENABLE_AB_SLOTS
+
+/******************************************************************************
+ * @function GetBLockSize
+*
  * @brief get the block size
  *
  * This function will determine the block size and return it
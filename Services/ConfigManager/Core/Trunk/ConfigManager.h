@@ -52,8 +52,11 @@ extern  void  ConfigManager_Initialize( BOOL bForceReset );
 extern  U16   ConfigManager_GetSignature( void );
 extern  BOOL  ConfigManager_ResetDefaults( void );
 extern  U16   ConfigManager_UpdateCRC( CONFIGSOURCE eSource );
-extern  U16   ConfigManager_ComputeBlockCrc( CONFIGSOURCE eSource );
+extern  BOOL  ConfigManager_ComputeBlockCrc( CONFIGSOURCE eSource, PU16 pwCrc );
 extern  void  ConfigManager_UpdateConfig( CONFIGTYPE eConfigType );
+#if ( CONFIGMANAGER_ENABLE_BLOCK_CRCS == 1 )
+extern  PU8   ConfigManager_GetActual( CONFIGTYPE eConfigType );
+#endif // CONFIGMANAGER_ENABLE_BLOCK_CRCS
 
 /**@} EOF ConfigManager.h */
 
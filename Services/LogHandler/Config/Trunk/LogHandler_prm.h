@@ -36,6 +36,12 @@
 /// define the debug command enable macro
 #define LOGHANDLER_ENABLE_DEBUGOMMANDS            ( 0 )
 
+/// define the macro to enable the staged append only log - set to 1 to enable
+#define LOGHANDLER_ENABLE_STAGED_WRITES           ( 0 )
+
+/// define the number of entries staged in RAM before they are written
+#define LOGHANDLER_STAGE_NUM_ENTRIES              ( 4 )
+
 /**@} EOF LogHandler_prm.h */
 
 #endif  // _LOGHANDLER_PRM_H
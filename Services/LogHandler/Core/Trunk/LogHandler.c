@@ -29,6 +29,9 @@
 
 // library includes -----------------------------------------------------------
 #include "EepromHandler/Eepromhandler.h"
+#if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+#include "CRC16/Crc16.h"
+#endif // LOGHANDLER_ENABLE_STAGED_WRITES
 
 // Macros and Defines ---------------------------------------------------------
 #define WRIDXADR_EEP_OFFSET   ( EEPROMHANDLER_LOGBLOCK_BASE_ADDR )
@@ -37,6 +40,11 @@
 #define RDIDXCHK_EEP_OFFSET   ( RDIDXADR_EEP_OFFSET + sizeof( U16 ))
 #define LOGDATA_EEP_OFFSET    ( RDIDXCHK_EEP_OFFSET + sizeof( U16 ))
 
+#if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+/// define the record offset
+#define LOGRECORD_EEP_OFFSET  ( EEPROMHANDLER_LOGBLOCK_BASE_ADDR )
+#endif // LOGHANDLER_ENABLE_STAGED_WRITES
+
 // structures -----------------------------------------------------------------
 /// define the log data structure
 typedef struct PACKED _LOGDATA
@@ -48,15 +56,43 @@ typedef struct PACKED _LOGDATA
 } LOGDATA, *PLOGDATA;
 #define LOGDATA_SIZE    sizeof( LOGDATA )
 
+#if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+/// define the log record structure
+typedef struct PACKED _LOGRECORD
+{
+  U16       wSequence;    ///< sequence number
+  LOGDATA   tData;        ///< log data
+  U16       wCrc;         ///< CRC of the sequence and data
+} LOGRECORD, *PLOGRECORD;
+#define LOGRECORD_SIZE  sizeof( LOGRECORD )
+#define LOGRECORD_CRC_SIZE  ( LOGRECORD_SIZE - sizeof( U16 ))
+
+/// define the size of the stage, the records are packed
+#define LOGSTAGE_SIZE   ( LOGHANDLER_STAGE_NUM_ENTRIES * LOGRECORD_SIZE )
+#endif // LOGHANDLER_ENABLE_STAGED_WRITES
+
 // local parameter declarations -----------------------------------------------
 static  U16   wCurIndex;
 static  U16   wMaxNumEntries;
 static  U16   wCurNumEntries;
+#if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+  static  U16       wHeadIndex;
+  static  U16       wOldestIndex;
+  static  U16       wSequence;
+  static  U16       wStageAddr;
+  static  U16       wStageLength;
+  static  U8        anStage[ LOGSTAGE_SIZE ];
+#endif // LOGHANDLER_ENABLE_STAGED_WRITES
 #if ( LOGHANDLER_ENABLE_DEBUGCOMMANDS == 1 )
   static  PC8   pcLclBuf;
 #endif // LOGHANDLER_ENABLE_DEBUGCOMMANDS
 
 // local function prototypes --------------------------------------------------
+#if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+  static  void  StageEntry( LOGTYPE eType, U32 uArg1, U32 uArg2 );
+  static  void  WriteStage( U16 wLength );
+  static  BOOL  ReadRecord( U16 wIndex, PLOGRECORD ptRecord );
+#endif // LOGHANDLER_ENABLE_STAGED_WRITES
 #if ( LOGHANDLER_ENABLE_DEBUGCOMMANDS == 1 )
   static  ASCCMDSTS CmdDmpLog( U8 nCmdEnum );
   static  ASCCMDSTS CmdRstLog( U8 nCmdEnum );
@@ -90,11 +126,66 @@ static  U16   wCurNumEntries;
  * @brief initialize the log handler
  *
  * This function checks to see if there is a valid log by checking the read/
- * write indices for proper values.  If not, it will reset the log to empty
+ * write indices for proper values.  If not, it will reset the log to empty.
+ * For the staged log, every record is scanned for the valid record with the
+ * highest sequence number, which is the newest, and the log extends back from
+ * it while the records continue the sequence
  *
  *****************************************************************************/
 void LogHandler_Initialize( void )
 {
+  #if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+  LOGRECORD tRecord;
+  U16       wIndex, wNewestIndex, wNewestSequence;
+  BOOL      bFound;
+  
+  // compute the number of entries/clear the stage
+  wMaxNumEntries = ( EEPROMHANDLER_DEV_SIZE - LOGRECORD_EEP_OFFSET ) / LOGRECORD_SIZE;
+  wStageLength = 0;
+  
+  // find the valid record with the highest sequence number
+  bFound = FALSE;
+  wNewestIndex = 0;
+  wNewestSequence = 0;
+  for ( wIndex = 0; wIndex < wMaxNumEntries; wIndex++ )
+  {
+    // check for valid and newer
+    if (( ReadRecord( wIndex, &tRecord )) && (( !bFound ) || (( S16 )( tRecord.wSequence - wNewestSequence ) > 0 )))
+    {
+      // this is the newest so far
+      wNewestIndex = wIndex;
+      wNewestSequence = tRecord.wSequence;
+      bFound = TRUE;
+    }
+  }
+  
+  // check for any valid record
+  if ( bFound )
+  {
+    // count the records back from the newest that continue the sequence
+    wCurNumEntries = 1;
+    while(( wCurNumEntries < wMaxNumEntries ) &&
+          ( ReadRecord(( wNewestIndex + wMaxNumEntries - wCurNumEntries ) % wMaxNumEntries, &tRecord )) &&
+          ( tRecord.wSequence == ( U16 )( wNewestSequence - wCurNumEntries )))
+    {
+      wCurNumEntries++;
+    }
+    
+    // the next record follows the newest
+    wSequence = wNewestSequence + 1;
+    wHeadIndex = ( wNewestIndex + 1 ) % wMaxNumEntries;
+    wOldestIndex = ( wNewestIndex + wMaxNumEntries + 1 - wCurNumEntries ) % wMaxNumEntries;
+  }
+  else
+  {
+    // invalid log - clear all entries
+    wSequence = 0;
+    LogHandler_ClearAllEntries( );
+  }
+  
+  // set the current index to the beginning
+  wCurIndex = wOldestIndex;
+  #else
   U16 wRdIdx, wWrIdx, wTemp;
   
   // read the write index address/add the check
@@ -135,6 +226,7 @@ void LogHandler_Initialize( void )
   
   // compute the number of entries
   wMaxNumEntries = ( EEPROMHANDLER_DEV_SIZE - WRIDXADR_EEP_OFFSET ) / LOGDATA_SIZE;
+  #endif // LOGHANDLER_ENABLE_STAGED_WRITES
 
   #if ( LOGHANDLER_ENABLE_DEBUGCOMMANDS == 1 )
   pcLclBuf = NULL;
@@ -147,7 +239,8 @@ void LogHandler_Initialize( void )
  * @brief add an entry into the log
  *
  * This function will get the system time, and add the log to the end of the
- * log.  It will update indices as neccesary
+ * log.  It will update indices as neccesary.  For the staged log, the entry
+ * is added to the stage and the stage is written when full
  *
  * @param[in]   eType   log entry enumeration
  * @param[in]   uArg1   log entry argument #1
@@ -158,12 +251,41 @@ void LogHandler_Initialize( void )
  *****************************************************************************/
 BOOL LogHandler_AddEntry( LOGTYPE eType, U32 uArg1, U32 uArg2 )
 {
+  #if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+  U16   wBoundary;
+  #else
   U16   wRdIdx, wWrIdx;
+  #endif // LOGHANDLER_ENABLE_STAGED_WRITES
   BOOL  bStatus = FALSE;
   
   // is this a valid log entry type
   if ( eType < LOG_TYPE_MAX )
   {
+    #if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+    // stage it
+    StageEntry( eType, uArg1, uArg2 );
+    
+    // write the whole stage at the end of the log
+    if ( wHeadIndex == 0 )
+    {
+      LogHandler_Flush( );
+    }
+    // if there is no room for another record, write up to the last page boundary
+    else if (( wStageLength + LOGRECORD_SIZE ) > LOGSTAGE_SIZE )
+    {
+      wBoundary = (( wStageAddr + wStageLength ) / EEPROMHANDLER_BLK_SIZE ) * EEPROMHANDLER_BLK_SIZE;
+      if ( wBoundary > wStageAddr )
+      {
+        WriteStage( wBoundary - wStageAddr );
+      }
+      
+      // write the rest if there is still no room
+      if (( wStageLength + LOGRECORD_SIZE ) > LOGSTAGE_SIZE )
+      {
+        LogHandler_Flush( );
+      }
+    }
+    #else
     // create the entry
     LOGDATA tData =
     {
@@ -206,6 +328,7 @@ BOOL LogHandler_AddEntry( LOGTYPE eType, U32 uArg1, U32 uArg2 )
       // return the max count
       wCurNumEntries = wMaxNumEntries;
     }
+    #endif // LOGHANDLER_ENABLE_STAGED_WRITES
 
     // set good status
     bStatus = TRUE;
@@ -235,6 +358,63 @@ BOOL LogHandler_AddEntry( LOGTYPE eType, U32 uArg1, U32 uArg2 )
 BOOL LogHandler_GetEntry( LOGPOS ePos, PLOGTYPE peType, PU32 puArg1, PU32 puArg2, PU64 phTime )
 {
   BOOL    bStatus = TRUE;
+  #if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+  LOGRECORD tRecord;
+  
+  // write any staged entries
+  LogHandler_Flush( );
+  
+  // determine the position
+  switch( ePos )
+  {
+    case LOG_POS_OLDEST :
+      // set the current index to the oldest
+      wCurIndex = wOldestIndex;
+      break;
+      
+    case LOG_POS_NEXT :
+      // increment the index/check for none
+      wCurIndex = ( wCurIndex + 1 ) % wMaxNumEntries;
+      bStatus = ( wCurIndex != wHeadIndex ) ? TRUE : FALSE;
+      break;
+      
+    case LOG_POS_PREV :
+      // check for the oldest/decrement the index
+      if ( wCurIndex != wOldestIndex )
+      {
+        wCurIndex = ( wCurIndex + wMaxNumEntries - 1 ) % wMaxNumEntries;
+      }
+      else
+      {
+        // end of records - set error
+        bStatus = FALSE;
+      }
+      break;
+      
+    case LOG_POS_NEWEST :
+      // set the current index to the entry before the head
+      wCurIndex = ( wHeadIndex + wMaxNumEntries - 1 ) % wMaxNumEntries;
+      break;
+      
+    default :
+      break;
+  }
+  
+  // check for OK/read the record
+  if (( bStatus == TRUE ) && ( wCurNumEntries != 0 ) && ( ReadRecord( wCurIndex, &tRecord )))
+  {
+    // copy the values
+    *peType = tRecord.tData.eType;
+    *puArg1 = tRecord.tData.uArg1;
+    *puArg2 = tRecord.tData.uArg2;
+    *phTime = tRecord.tData.hSystemTimeUsec;
+  }
+  else
+  {
+    // set error
+    bStatus = FALSE;
+  }
+  #else
   LOGDATA tData;
   U16     wTemp;
   
@@ -306,6 +486,7 @@ BOOL LogHandler_GetEntry( LOGPOS ePos, PLOGTYPE peType, PU32 puArg1, PU32 puArg2
     *puArg2 = tData.uArg2;
     *phTime = tData.hSystemTimeUsec;
   }
+  #endif // LOGHANDLER_ENABLE_STAGED_WRITES
   
   // return the status
   return( bStatus );
@@ -365,6 +546,21 @@ PC8 LogHandler_GetDescription( LOGTYPE eType )
  *****************************************************************************/
 void LogHandler_ClearAllEntries( void )
 {
+  #if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+  // discard the stage/skip the sequence past any existing record
+  wStageLength = 0;
+  wSequence += wMaxNumEntries + 1;
+  
+  // reset the indices
+  wHeadIndex = 0;
+  wOldestIndex = 0;
+  wCurIndex = 0;
+  wCurNumEntries = 0;
+  
+  // create an entry/write it
+  StageEntry( LOG_TYPE_INIT, 0, 0 );
+  LogHandler_Flush( );
+  #else
   U16 wIndex;
   
   // clear the indices
@@ -395,7 +591,131 @@ void LogHandler_ClearAllEntries( void )
 
   // set the count
   wCurNumEntries = 1;
+  #endif // LOGHANDLER_ENABLE_STAGED_WRITES
+}
+
+#if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+/******************************************************************************
+ * @function LogHandler_Flush
+ *
+ * @brief write the staged entries
+ *
+ * This function will write all of the staged entries after the newest entry
+ * written to the log
+ *
+ *****************************************************************************/
+void LogHandler_Flush( void )
+{
+  // write the stage
+  WriteStage( wStageLength );
+
+  #if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+    // sync the EEPROM
+    EepromHandler_Flush( );
+  #endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
+}
+
+/******************************************************************************
+ * @function StageEntry
+ *
+ * @brief stage an entry
+ *
+ * This function will create a record with the next sequence number in the 
+ * stage and update the head, oldest and count
+ *
+ * @param[in]   eType   log entry enumeration
+ * @param[in]   uArg1   log entry argument #1
+ * @param[in]   uArg2   log entry argument #2
+ *
+ *****************************************************************************/
+static void StageEntry( LOGTYPE eType, U32 uArg1, U32 uArg2 )
+{
+  LOGRECORD tRecord;
+  
+  // an empty stage starts at the head
+  if ( wStageLength == 0 )
+  {
+    wStageAddr = LOGRECORD_EEP_OFFSET + ( wHeadIndex * LOGRECORD_SIZE );
+  }
+  
+  // fill the record/append it to the stage
+  tRecord.wSequence = wSequence++;
+  tRecord.tData.eType = eType;
+  tRecord.tData.hSystemTimeUsec = LogHandler_GetSystemTime( );
+  tRecord.tData.uArg1 = uArg1;
+  tRecord.tData.uArg2 = uArg2;
+  tRecord.wCrc = CRC16_CalculateBlock(( PU8 )&tRecord, LOGRECORD_CRC_SIZE );
+  memcpy( &anStage[ wStageLength ], &tRecord, LOGRECORD_SIZE );
+  wStageLength += LOGRECORD_SIZE;
+  
+  // adjust the head
+  wHeadIndex = ( wHeadIndex + 1 ) % wMaxNumEntries;
+  
+  // adjust the count, if full the oldest is the next to be written
+  if ( wCurNumEntries < wMaxNumEntries )
+  {
+    wCurNumEntries++;
+  }
+  else
+  {
+    wOldestIndex = wHeadIndex;
+  }
+}
+
+/******************************************************************************
+ * @function WriteStage
+ *
+ * @brief write the stage
+ *
+ * This function will write the beginning of the stage in one block write and
+ * move the remainder to the front.  A remainder holds the start of a record
+ * that is completed by the next write
+ *
+ * @param[in]   wLength   number of bytes to write
+ *
+ *****************************************************************************/
+static void WriteStage( U16 wLength )
+{
+  // check for any bytes
+  if ( wLength != 0 )
+  {
+    // write them
+    EepromHandler_WrBlock( wStageAddr, wLength, anStage );
+    
+    // move the remainder to the front
+    wStageLength -= wLength;
+    wStageAddr += wLength;
+    memmove( anStage, &anStage[ wLength ], wStageLength );
+  }
+}
+
+/******************************************************************************
+ * @function ReadRecord
+ *
+ * @brief read a record
+ *
+ * This function will read a record from the log and check its CRC
+ *
+ * @param[in]   wIndex    record index
+ * @param[io]   ptRecord  pointer to store the record
+ *
+ * @return      TRUE if valid, FALSE otherwise
+ *
+ *****************************************************************************/
+static BOOL ReadRecord( U16 wIndex, PLOGRECORD ptRecord )
+{
+  BOOL  bValid = FALSE;
+  
+  // read the record/check the CRC
+  if ( EepromHandler_RdBlock( LOGRECORD_EEP_OFFSET + ( wIndex * LOGRECORD_SIZE ), LOGRECORD_SIZE, ( PU8 )ptRecord ) == EEPROM_ERR_NONE )
+  {
+    bValid = ( CRC16_CalculateBlock(( PU8 )ptRecord, LOGRECORD_CRC_SIZE ) == ptRecord->wCrc ) ? TRUE : FALSE;
+  }
+  
+  // return the status
+  return( bValid );
 }
+#endif // LOGHANDLER_ENABLE_STAGED_WRITES
 
 #if ( LOGHANDLER_ENABLE_DEBUGCOMMANDS == 1 )
   /******************************************************************************
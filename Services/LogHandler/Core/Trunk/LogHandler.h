@@ -69,6 +69,9 @@ extern  BOOL  LogHandler_GetEntry( LOGPOS ePos, PLOGTYPE peType, PU32 puArg1, PU
 extern  U16   LogHandler_GetCount( void );
 extern  PC8   LogHandler_GetDescription( LOGTYPE eType );
 extern  void  LogHandler_ClearAllEntries( void );
+#if ( LOGHANDLER_ENABLE_STAGED_WRITES == 1 )
+extern  void  LogHandler_Flush( void );
+#endif // LOGHANDLER_ENABLE_STAGED_WRITES
 
 /**@} EOF LogHandler.h */
 
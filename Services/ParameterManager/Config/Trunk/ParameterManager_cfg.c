@@ -30,7 +30,7 @@
 #endif // PARAM_ENABLE_CONFIGVER
 
 // library includes -----------------------------------------------------------
-
+#include "EepromHandler/EepromHandler.h"
 
 // Macros and Defines ---------------------------------------------------------
 
@@ -267,4 +267,27 @@ BOOL ParameterManager_WrBlock( U16 wAddress, U16 wLength, PU8 pnData )
   return( bStatus );
 }
 
+/******************************************************************************
+ * @function ParamaterManager_Sync
+ *
+ * @brief sync the storage
+ *
+ * This function will commit any buffered writes to the storage device
+ *
+ * @return        TRUE if errors detected, FALSE otherwise
+ *
+ *****************************************************************************/
+BOOL ParameterManager_Sync( void )
+{
+  BOOL  bStatus = FALSE;
+  
+  #if ( EEPROMHANDLER_ENABLE_PAGE_CACHE == 1 )
+    // flush the page cache
+    bStatus = ( EepromHandler_Flush( ) != EEPROM_ERR_NONE ) ? TRUE : FALSE;
+  #endif // EEPROMHANDLER_ENABLE_PAGE_CACHE
+
+  // return status
+  return( bStatus );
+}
+
 /**@} EOF ParamaterManager_cfg.c */
@@ -55,6 +55,7 @@ extern  BOOL  ParameterManager_WrByte( U16 wAddress, U8 nData );
 extern  BOOL  ParameterManager_WrWord( U16 wAddress, U16 wData );
 extern  BOOL  ParameterManager_WrLong( U16 wAddress, U32 uData );
 extern  BOOL  ParameterManager_WrBlock( U16 wAddress, U16 wLength, PU8 pnData );
+extern  BOOL  ParameterManager_Sync( void );
 
 /**@} EOF ParameterManager_cfg.h */
 
@@ -53,8 +53,11 @@ static  BOOL    bDefaultParameters;
 static  BOOL    bErrorDetected;
 
 // local function prototypes --------------------------------------------------
-static  U16   ComputeParamCheck( BOOL bUpdateFlag );
-static  void  SetDefaults( PARAMSELENUM eBegParam, PARAMSELENUM eEndParam );
+static  U16       ComputeParamCheck( BOOL bUpdateFlag );
+static  U16       UpdateCheck( U16 wCheckValue, PU8 pnData, U16 wLength );
+static  U16       FinishCheck( U16 wCheckValue, BOOL bUpdateFlag );
+static  void      SetDefaults( PARAMSELENUM eBegParam, PARAMSELENUM eEndParam );
+static  PARAMARG  ReadDefault( PARAMSELENUM eParam );
 
 /// command handlers
 #if ( PARAM_ENABLE_DEBUG_COMMANDS == 1 )
@@ -152,9 +155,14 @@ void ParameterManager_SetDefaults( void )
 /******************************************************************************
  * @function ParameterMangaer_SetDefaultsRange
  *
- * @brief reset all parameters to their default values
+ * @brief reset a range of parameters to their default values
  *
- * This function will copy the default values to the eeprom
+ * This function will copy the default values of the parameters from the
+ * begin parameter up to but not including the end parameter to the eeprom.
+ * The default status is only set when the range covers all parameters
+ *
+ * @param[in]   eBegParam     first parameter
+ * @param[in]   eEndParam     parameter after the last
  *
  *****************************************************************************/
 void ParameterManager_SetDefaultsRange( PARAMSELENUM eBegParam, PARAMSELENUM eEndParam )
@@ -262,6 +270,9 @@ PARAMERRS	ParameterManager_PutValue( PARAMSELENUM eParam, PARAMARG xValue, BOOL
       // update the checksum
       ComputeParamCheck( TRUE );
     
+      // sync the storage
+      ParameterManager_Sync( );
+    
       // clear the default parameters
       bDefaultParameters = FALSE;
     }
@@ -390,7 +401,7 @@ PARAMERRS ParameterManager_GetDefaultValue( PARAMSELENUM eParam, PPARAMARG pxDfl
   if ( eParam < PARAMSEL_MAX_NUM )
   {
     // get the value
-    *pxDfltValue = PGM_RDBYTE( atParamDefaults[ eParam ].xDefVal );
+    *pxDfltValue = ReadDefault( eParam );
   }
   
   // return the error
@@ -417,17 +428,23 @@ BOOL ParameterManager_GetDefaultStatus( void )
  *
  * @brief set all parameter so their default values
  *
- * This function will set all parameter to their default values
+ * This function will set a range of parameters to their default values, one
+ * block write per buffer of values.  When the whole table is reset the check
+ * value is computed from the written blocks instead of reading them back
+ *
+ * @param[in]   eBegParam     first parameter
+ * @param[in]   eEndParam     parameter after the last
  *
  *****************************************************************************/
 static void SetDefaults( PARAMSELENUM eBegParam, PARAMSELENUM eEndParam )
 {
-  U16UN       tVersion;
-  U16         wWriteLength, wAddress;
-  PPARAMARG   ptValues;
-  PARAMARG    tValue;
-  U8          nNumParams, nParamCount, nParamIdx;
-  PPARAMDFLTS ptDefaults;
+  U16UN         tVersion;
+  U16           wWriteLength, wAddress, wCheckValue;
+  PPARAMARG     ptValues;
+  PARAMARG      tValue;
+  U16           wNumParams, wParamCount, wParamIdx;
+  PARAMSELENUM  eParam;
+  BOOL          bFullRange;
 
   // update the version
   tVersion.anValue[ LE_U16_MSB_IDX ] = ParameterManager_GetVerMajor( );
@@ -436,65 +453,125 @@ static void SetDefaults( PARAMSELENUM eBegParam, PARAMSELENUM eEndParam )
   // write it
   ParameterManager_WrWord( PARAMETER_VERS_ADDR, tVersion.wValue );
 
-  // set the parameter count/set the beginning address
-  nParamCount = PARAMSEL_MAX_NUM;
-  wAddress = PARAMETER_DATA_ADDR;
-  
+  // limit the range/set the parameter count
+  eEndParam = MIN( eEndParam, PARAMSEL_MAX_NUM );
+  wParamCount = ( eEndParam > eBegParam ) ? ( eEndParam - eBegParam ) : 0;
+  bFullRange = (( eBegParam == 0 ) && ( eEndParam == PARAMSEL_MAX_NUM )) ? TRUE : FALSE;
+
   // create a local buffer
   if (( ptValues = ( PPARAMARG )malloc( PARAM_UPDATE_BLOCK_SIZE )) != NULL )
   {
     // set the block length
-    nNumParams = PARAM_UPDATE_BLOCK_SIZE / sizeof( PARAMARG );
+    wNumParams = PARAM_UPDATE_BLOCK_SIZE / sizeof( PARAMARG );
   }
   else
   {
     // force length to 1
     ptValues = &tValue;
-    nNumParams = 1;
+    wNumParams = 1;
   }
 
-  // set the addresses
-  wAddress = PARAMETER_DATA_ADDR;
-  ptDefaults = ( PPARAMDFLTS )&atParamDefaults;
+  // set the address/parameter/initial check value
+  wAddress = PARAMADDR( eBegParam );
+  eParam = eBegParam;
+  #if ( PARAM_USE_CRC == 1 )
+    wCheckValue = CRC16_GetInitialValue( );
+  #else
+    wCheckValue = 0;
+  #endif // PARAM_USE_CRC
 
   // while there is data
-  while( nParamCount != 0 )
+  while( wParamCount != 0 )
   {
-    // clear the write length
-    wWriteLength = 0;
-    
     // set the number of parameters to iterate this loop
-    nNumParams = MIN( nNumParams, nParamCount );
-    
+    wNumParams = MIN( wNumParams, wParamCount );
+
     // get the default values for this block
-    for ( nParamIdx = 0; nParamIdx < nNumParams; nParamIdx++ )
+    for ( wParamIdx = 0; wParamIdx < wNumParams; wParamIdx++ )
     {
       // copy the defaults
-      *( ptValues + nParamIdx ) = ptDefaults++->xDefVal;
-      wWriteLength += sizeof( PARAMARG );
+      *( ptValues + wParamIdx ) = ReadDefault( eParam++ );
     }
 
     // now write it
+    wWriteLength = wNumParams * sizeof( PARAMARG );
     if (( bErrorDetected = ParameterManager_WrBlock( wAddress, wWriteLength, ( PU8 )ptValues )) == TRUE )
     {
       // exit
       break;
     }
 
+    // add the block to the check value
+    wCheckValue = UpdateCheck( wCheckValue, ( PU8 )ptValues, wWriteLength );
+
     // adjust address
     wAddress += wWriteLength;
-    
+
     // adjust the parameter count
-    nParamCount -= nNumParams;
+    wParamCount -= wNumParams;
   }
-  
+
+  // free the buffer if allocated
+  if ( ptValues != &tValue )
+  {
+    free( ptValues );
+  }
+
   // if no error detected
   if ( !bErrorDetected )
   {
     // force an update of the Check value
-    bDefaultParameters = TRUE;
-    ComputeParamCheck( TRUE );
+    if ( bFullRange == TRUE )
+    {
+      // the written blocks are the entire parameter block
+      bDefaultParameters = TRUE;
+      FinishCheck( wCheckValue, TRUE );
+    }
+    else
+    {
+      // recompute it
+      ComputeParamCheck( TRUE );
+    }
   }
+
+  // sync the storage
+  ParameterManager_Sync( );
+}
+
+/******************************************************************************
+ * @function ReadDefault
+ *
+ * @brief read a default value
+ *
+ * This function will read the default value of a parameter from the table
+ *
+ * @param[in]   eParam      parameter number
+ *
+ * @return      default value
+ *
+ *****************************************************************************/
+static PARAMARG ReadDefault( PARAMSELENUM eParam )
+{
+  PARAMARG  xValue;
+
+  // get the value
+  switch( sizeof( PARAMARG ))
+  {
+    case 2 :
+      xValue = PGM_RDWORD( atParamDefaults[ eParam ].xDefVal );
+      break;
+
+    case 4 :
+      xValue = PGM_RDDWRD( atParamDefaults[ eParam ].xDefVal );
+      break;
+
+    default :
+      xValue = PGM_RDBYTE( atParamDefaults[ eParam ].xDefVal );
+      break;
+  }
+
+  // return the value
+  return( xValue );
 }
 
 /******************************************************************************
@@ -512,7 +589,7 @@ static void SetDefaults( PARAMSELENUM eBegParam, PARAMSELENUM eEndParam )
  *****************************************************************************/
 static U16 ComputeParamCheck( BOOL bUpdateFlag )
 {
-  U16         wCheckValue, wIdx, wTotalLength, wBlockLength, wReadLength, wAddress;
+  U16         wCheckValue, wTotalLength, wBlockLength, wReadLength, wAddress;
   PU8         pnValues;
   U8          nValue;
   BOOL        bErrorDetected = FALSE;
@@ -549,21 +626,9 @@ static U16 ComputeParamCheck( BOOL bUpdateFlag )
     // set the current block length
     wReadLength = MIN( wBlockLength, wTotalLength );
 
-    // read the block
+    // read the block/add it to the check value
     bErrorDetected = ParameterManager_RdBlock( wAddress, wReadLength, pnValues );
-
-    // now for each byte in block
-    for( wIdx = 0; wIdx < wReadLength; wIdx++ )
-    {
-      // now add it to the local check value
-      #if ( PARAM_USE_CRC == 1 )
-      // update with Crc
-      wCheckValue = CRC16_CalculateByte( wCheckValue, *( pnValues + wIdx ));
-      #else
-      // just add if this is a checksum
-      wCheckValue += *( pnValues + wIdx );
-      #endif // PARAM_USE_CRC
-    }
+    wCheckValue = UpdateCheck( wCheckValue, pnValues, wReadLength );
 
     // adjust address
     wAddress += wReadLength;
@@ -572,25 +637,85 @@ static U16 ComputeParamCheck( BOOL bUpdateFlag )
     wTotalLength -= wReadLength;
   }
 
+  // free the buffer if allocated
+  if ( pnValues != &nValue )
+  {
+    free( pnValues );
+  }
+
   // check for error
   if ( !bErrorDetected )
   {
-    // if this is a checksum - 2's complement it
-    #if ( PARAM_USE_CRC == 0 )
-    {
-      wCheckValue ^= wCheckValue;
-      wCheckValue++;
-    }
-    #endif // PARAM_USE_CRC == 0
+    // finish it
+    wCheckValue = FinishCheck( wCheckValue, bUpdateFlag );
+  }
+
+  // return the calculated value
+  return( wCheckValue );
+}
 
-    // determine if we are to write this value
-    if ( bUpdateFlag )
+/******************************************************************************
+ * @function UpdateCheck
+ *
+ * @brief add a block to the check value
+ *
+ * This function will add a block of data to the check value
+ *
+ * @param[in]   wCheckValue   current check value
+ * @param[in]   pnData        pointer to the data
+ * @param[in]   wLength       length of the data
+ *
+ * @return      new check value
+ *
+ *****************************************************************************/
+static U16 UpdateCheck( U16 wCheckValue, PU8 pnData, U16 wLength )
+{
+  #if ( PARAM_USE_CRC == 1 )
+    // update with Crc
+    wCheckValue = CRC16_Update( wCheckValue, pnData, wLength );
+  #else
+    // just add if this is a checksum
+    while( wLength-- != 0 )
     {
-      ParameterManager_WrWord( PARAMETER_CHECK_ADDR, wCheckValue );
+      wCheckValue += *( pnData++ );
     }
+  #endif // PARAM_USE_CRC
+
+  // return the check value
+  return( wCheckValue );
+}
+
+/******************************************************************************
+ * @function FinishCheck
+ *
+ * @brief finish the check value
+ *
+ * This function will finish the check value and update the stored check
+ * value if requested
+ *
+ * @param[in]   wCheckValue   current check value
+ * @param[in]   bUpdateFlag   request and udpate of the Check value
+ *
+ * @return      final check value
+ *
+ *****************************************************************************/
+static U16 FinishCheck( U16 wCheckValue, BOOL bUpdateFlag )
+{
+  // if this is a checksum - 2's complement it
+  #if ( PARAM_USE_CRC == 0 )
+  {
+    wCheckValue ^= wCheckValue;
+    wCheckValue++;
   }
+  #endif // PARAM_USE_CRC == 0
 
-  // return the calculated value
+  // determine if we are to write this value
+  if ( bUpdateFlag )
+  {
+    ParameterManager_WrWord( PARAMETER_CHECK_ADDR, wCheckValue );
+  }
+
+  // return the check value
   return( wCheckValue );
 }
 
@@ -51,6 +51,10 @@
 /// declare all the average filter buffers here
 // SENMANAVGFILTSTORAGE( bufname, size )
 
+/// declare all the FIR history and IIR state buffers here
+// SENMANFIRFILTSTORAGE( bufname, numtaps )
+// SENMANIIRFILTSTORAGE( bufname, numstages )
+
 // local function prototypes --------------------------------------------------
 #if ( SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_FREERTOS )
 static void ScanTask( PVOID pvParameters );
@@ -66,6 +70,8 @@ const CODE SENMANDEF  atSensorMngrDefs[ SENMAN_ENUM_MAX ] =
   // SENMANINTAVGFILTLIN( chan, samprate, minraw, maxraw, minegu, maxegu, numsamps, bufname, linfunc )
   // SENMANINTLDLGFILT( chan, samprate, minraw, maxraw, minegu, maxegu, lagtc, leadtc )
   // SENMANINTLDLGFILTLIN( chan, samprate, minraw, maxraw, minegu, maxegu, lagtc, leadtc, linfunc )
+  // SENMANINTFIRFILT( chan, samprate, minraw, maxraw, minegu, maxegu, numtaps, coefs, bufname )
+  // SENMANINTIIRFILT( chan, samprate, minraw, maxraw, minegu, maxegu, numstages, coefs, bufname )
 
   // SENMANEXTNOFILT( chan, samprate, minraw, maxraw, minegu, maxegu, getfunc )
   // SENMANEXTNOFILTLIN( chan, samprate, minraw, maxraw, minegu, maxegu, linfunc )
@@ -73,6 +79,8 @@ const CODE SENMANDEF  atSensorMngrDefs[ SENMAN_ENUM_MAX ] =
   // SENMANEXTAVGFILTLIN( chan, samprate, minraw, maxraw, minegu, maxegu, numsamps, bufname, getfunc, linfunc )
   // SENMANEXTLDLGFILT( chan, samprate, minraw, maxraw, minegu, maxegu, lagtc, leadtc )
   // SENMANEXTLDLGFILTLIN( chan, samprate, minraw, maxraw, minegu, maxegu, lagtc, leadtc, linfunc )
+  // SENMANEXTFIRFILT( chan, samprate, minraw, maxraw, minegu, maxegu, numtaps, coefs, bufname, getfunc )
+  // SENMANEXTIIRFILT( chan, samprate, minraw, maxraw, minegu, maxegu, numstages, coefs, bufname, getfunc )
 
   // SENMANSPCNOFILT( samprate, minraw, maxraw, minegu, maxegu, getfunc )
   // SENMANSPCNOFILTLIN( samprate, minraw, maxraw, minegu, maxegu, getfunc, linfunc )
@@ -80,6 +88,8 @@ const CODE SENMANDEF  atSensorMngrDefs[ SENMAN_ENUM_MAX ] =
   // SENMANSPCAVGFILTLIN( samprate, minraw, maxraw, minegu, maxegu, numsamps, bufname, getfunc, linfunc )
   // SENMANSPCLDLGFILT( samprate, minraw, maxraw, minegu, maxegu, lagtc, leadtc, getfunc )
   // SENMANSPCLDLGFILTLIN( samprate, minraw, maxraw, minegu, maxegu, lagtc, leadtc, getfunc, linfunc )
+  // SENMANSPCFIRFILT( samprate, minraw, maxraw, minegu, maxegu, numtaps, coefs, bufname, getfunc )
+  // SENMANSPCIIRFILT( samprate, minraw, maxraw, minegu, maxegu, numstages, coefs, bufname, getfunc )
   SENMANSPCNOFILT( BME280_SCAN_RATE_MSECS, 0, 0, 0, 0, SenBME280_GetPressure ),
   SENMANSPCNOFILT( BME280_SCAN_RATE_MSECS, 0, 0, 0, 0, SenBME280_GetTemperature ),
   SENMANSPCNOFILT( BME280_SCAN_RATE_MSECS, 0, 0, 0, 0, SenBME280_GetHumidity ),
@@ -162,4 +172,30 @@ U16 SensorManager_InternalAdcConvertChannel( U8 nChannel )
   return( wValue );
 }
 
+#if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+/******************************************************************************
+ * @function SensorManager_InternalAdcConvertChannels
+ *
+ * @brief convert a set of internal AtoD channels
+ *
+ * This function will convert a set of internal AtoD channels, replace with a
+ * single scan sequence where the AtoD supports one
+ *
+ * @param[in]     pnChannels    pointer to the channels to convert
+ * @param[io]     pwValues      pointer to the storage for the values
+ * @param[in]     nNumChannels  number of channels
+ *
+ *****************************************************************************/
+void SensorManager_InternalAdcConvertChannels( PU8 pnChannels, PU16 pwValues, U8 nNumChannels )
+{
+  U8  nIdx;
+
+  // convert each channel
+  for ( nIdx = 0; nIdx < nNumChannels; nIdx++ )
+  {
+    *( pwValues + nIdx ) = SensorManager_InternalAdcConvertChannel( *( pnChannels + nIdx ));
+  }
+}
+#endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
+
 /**@} EOF SemsprMamager_cfg.c */
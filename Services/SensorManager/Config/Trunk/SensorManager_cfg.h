@@ -67,6 +67,9 @@ extern  void  SensorManager_LocalInitialize( void );
 extern  BOOL  SensorManager_ScanTask( TASKARG xArg );
 #endif // SYSTEMDEFINE_OS_SELECTION == SYSTEMDEFINE_OS_TASKMANAGER
 extern  U16   SensorManager_InternalAdcConvertChannel( U8 nChannel );
+#if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+extern  void  SensorManager_InternalAdcConvertChannels( PU8 pnChannels, PU16 pwValues, U8 nNumChannels );
+#endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
 
 /**@} EOF SensorManager_cfg.h */
 
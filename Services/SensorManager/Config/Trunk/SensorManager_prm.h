@@ -42,6 +42,9 @@
 #define SENSORMANAGER_IIR_FILTER_ENABLE         ( 0 )
 #define SENSORMANAGER_USR_FILTER_ENABLE         ( 0 )
 
+/// define the macro to enable the rate grouped scan schedule
+#define SENSORMANAGER_ENABLE_RATE_SCHEDULE      ( 0 )
+
 /// define the argument types
 #define SENSORMANAGER_TYPE_SIGNED16             ( 0 )
 #define SENSORMANAGER_TYPE_SIGNED32             ( 1 )
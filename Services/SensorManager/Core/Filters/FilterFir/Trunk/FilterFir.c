@@ -0,0 +1,227 @@
+/******************************************************************************
+ * @file FilterFir.c
+ *
+ * @brief FIR filter implementation
+ *
+ * This file provides a direct form FIR filter.  The history is kept twice,
+ * one copy after the other, so the newest taps samples are always contiguous
+ * and the convolution runs without a modulo.  The coefficients are stored in
+ * time reversed order, as in CMSIS-DSP, and are read from program memory
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * $Date: $
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ *
+ *
+ * \addtogroup FilterFir
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "SensorManager/Filters/FilterFir/FilterFir.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+
+// local function prototypes --------------------------------------------------
+static  FIRSAMPLE ProcessSample( PFILTFIRCTL ptCtl, FIRSAMPLE xNewSample );
+
+// constant parameter initializations -----------------------------------------
+
+/******************************************************************************
+ * @function FilterFir_Initialize
+ *
+ * @brief FIR filter initialization
+ *
+ * This function will clear the history and output of a FIR filter
+ *
+ * @param[in]   ptCtl       pointer to a control structure
+ *
+ *****************************************************************************/
+void FilterFir_Initialize( PFILTFIRCTL ptCtl )
+{
+  U16 wIdx;
+
+  // clear both copies of the history
+  for ( wIdx = 0; wIdx < ( ptCtl->tDef.wNumTaps * 2 ); wIdx++ )
+  {
+    *( ptCtl->tDef.pxHistory + wIdx ) = 0;
+  }
+
+  // clear the index/output/valid
+  ptCtl->wIndex = 0;
+  ptCtl->xOutput = 0;
+  ptCtl->bValid = FALSE;
+}
+
+/******************************************************************************
+ * @function FilterFir_Execute
+ *
+ * @brief FIR filter execution
+ *
+ * This function will perform a FIR filter iteration
+ *
+ * @param[in]   ptCtl       pointer to a control structure
+ * @param[in]   xNewSample  new sample to add
+ *
+ * @return      TRUE if valid filter value, FALSE if not
+ *
+ *****************************************************************************/
+BOOL FilterFir_Execute( PFILTFIRCTL ptCtl, FIRSAMPLE xNewSample )
+{
+  BOOL bValidValue;
+
+  // set the return status
+  bValidValue = ptCtl->bValid;
+
+  // process the sample
+  ptCtl->xOutput = ProcessSample( ptCtl, xNewSample );
+
+  // return the validity
+  return( bValidValue );
+}
+
+/******************************************************************************
+ * @function FilterFir_ExecuteBlock
+ *
+ * @brief FIR filter block execution
+ *
+ * This function will filter a block of samples, the input and output may be
+ * the same buffer
+ *
+ * @param[in]   ptCtl         pointer to a control structure
+ * @param[in]   pxInput       pointer to the input samples
+ * @param[io]   pxOutput      pointer to the output samples
+ * @param[in]   wNumSamples   number of samples
+ *
+ * @return      TRUE if the last output is valid, FALSE if not
+ *
+ *****************************************************************************/
+BOOL FilterFir_ExecuteBlock( PFILTFIRCTL ptCtl, PFIRSAMPLE pxInput, PFIRSAMPLE pxOutput, U16 wNumSamples )
+{
+  U16 wIdx;
+
+  // for each sample
+  for ( wIdx = 0; wIdx < wNumSamples; wIdx++ )
+  {
+    // process it
+    *( pxOutput + wIdx ) = ProcessSample( ptCtl, *( pxInput + wIdx ));
+  }
+
+  // update the output if samples were processed
+  if ( wNumSamples != 0 )
+  {
+    ptCtl->xOutput = *( pxOutput + wNumSamples - 1 );
+  }
+
+  // return the validity
+  return( ptCtl->bValid );
+}
+
+/******************************************************************************
+ * @function FilterFir_GetValue
+ *
+ * @brief get the FIR filter output
+ *
+ * This function will get the current FIR filter output
+ *
+ * @param[in]   ptCtl       pointer to a control structure
+ *
+ * @return      current filtered value
+ *
+ *****************************************************************************/
+FIRSAMPLE FilterFir_GetValue( PFILTFIRCTL ptCtl )
+{
+  // return the value
+  return( ptCtl->xOutput );
+}
+
+/******************************************************************************
+ * @function ProcessSample
+ *
+ * @brief process one sample
+ *
+ * This function will add a sample to the history and compute the output
+ *
+ * @param[in]   ptCtl       pointer to a control structure
+ * @param[in]   xNewSample  new sample to add
+ *
+ * @return      filter output
+ *
+ *****************************************************************************/
+static FIRSAMPLE ProcessSample( PFILTFIRCTL ptCtl, FIRSAMPLE xNewSample )
+{
+  PFIRSAMPLE  pxHistory;
+  PFIRCOEF    pxCoefs;
+  U16         wNumTaps, wTap;
+  FIRSAMPLE   xOutput;
+  #if ( SENSORMANAGER_ARGUMENT_TYPE == SENSORMANAGER_TYPE_FLOAT )
+  FLOAT       fAccum;
+  U32UN       tCoef;
+  #else
+  S64         hAccum;
+  #endif // SENSORMANAGER_ARGUMENT_TYPE
+
+  // get the number of taps
+  wNumTaps = ptCtl->tDef.wNumTaps;
+
+  // store the sample over the oldest in both copies
+  *( ptCtl->tDef.pxHistory + ptCtl->wIndex ) = xNewSample;
+  *( ptCtl->tDef.pxHistory + ptCtl->wIndex + wNumTaps ) = xNewSample;
+
+  // adjust the index/check for wrap
+  if ( ++ptCtl->wIndex >= wNumTaps )
+  {
+    // the history is now full
+    ptCtl->wIndex = 0;
+    ptCtl->bValid = TRUE;
+  }
+
+  // the samples from the index on are oldest to newest
+  pxHistory = ptCtl->tDef.pxHistory + ptCtl->wIndex;
+  pxCoefs = ptCtl->tDef.pxCoefs;
+
+  // compute the output
+  #if ( SENSORMANAGER_ARGUMENT_TYPE == SENSORMANAGER_TYPE_FLOAT )
+  fAccum = 0.0;
+  for ( wTap = 0; wTap < wNumTaps; wTap++ )
+  {
+    // read the coefficient from program memory
+    tCoef.uValue = PGM_RDDWRD( *(( PU32 )pxCoefs + wTap ));
+    fAccum += tCoef.fValue * *( pxHistory + wTap );
+  }
+  xOutput = fAccum;
+  #else
+  hAccum = 0;
+  for ( wTap = 0; wTap < wNumTaps; wTap++ )
+  {
+    hAccum += ( S64 )(( FIRCOEF )PGM_RDWORD( *( pxCoefs + wTap ))) * *( pxHistory + wTap );
+  }
+  xOutput = ( FIRSAMPLE )(( hAccum + ( 1L << ( FILTFIR_COEF_FRAC_BITS - 1 ))) >> FILTFIR_COEF_FRAC_BITS );
+  #endif // SENSORMANAGER_ARGUMENT_TYPE
+
+  // return the output
+  return( xOutput );
+}
+
+/**@} EOF FilterFir.c */
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * @file FilterFir.h
+ *
+ * @brief FIR filter declarations
+ *
+ * This file provides the declaration for the FIR filter implementation
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * $Date: $
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ *
+ *
+ * \addtogroup FilterFir
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _FILTERFIR_H
+#define _FILTERFIR_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "SensorManager/SensorManager_prm.h"
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the number of fractional bits in a fixed point coefficient
+#define FILTFIR_COEF_FRAC_BITS        ( 15 )
+
+/// define the limits of a fixed point coefficient
+#define FILTFIR_COEF_MAX              ( 32767 )
+#define FILTFIR_COEF_MIN              ( -32768 )
+
+/// define the helper macro for converting a real coefficient, rounded to fixed point and saturated for integer types
+#if ( SENSORMANAGER_ARGUMENT_TYPE == SENSORMANAGER_TYPE_FLOAT )
+  #define FILTFIR_COEF( val ) \
+    (( FIRCOEF )( val ))
+#else
+  #define FILTFIR_COEF_SCALED( val ) \
+    ((( val ) * ( 1L << FILTFIR_COEF_FRAC_BITS )) + ((( val ) < 0 ) ? -0.5 : 0.5 ))
+  #define FILTFIR_COEF( val ) \
+    (( FIRCOEF )(( FILTFIR_COEF_SCALED( val ) > FILTFIR_COEF_MAX ) ? FILTFIR_COEF_MAX : \
+                 (( FILTFIR_COEF_SCALED( val ) < FILTFIR_COEF_MIN ) ? FILTFIR_COEF_MIN : FILTFIR_COEF_SCALED( val ))))
+#endif // SENSORMANAGER_ARGUMENT_TYPE
+
+/// define the helper macro for defining the FIR filter history buffer
+#define SENMANFIRFILTSTORAGE( bufname, numtaps ) \
+  static  FIRSAMPLE ax ## bufname ## FirFilt[ numtaps * 2 ];
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// define the sample and coefficient types, Q15 coefficients for integer types
+#if ( SENSORMANAGER_ARGUMENT_TYPE == SENSORMANAGER_TYPE_FLOAT )
+  typedef FLOAT   FIRSAMPLE;
+  typedef PFLOAT  PFIRSAMPLE;
+  typedef FLOAT   FIRCOEF;
+  typedef PFLOAT  PFIRCOEF;
+#else
+  typedef S32     FIRSAMPLE;
+  typedef PS32    PFIRSAMPLE;
+  typedef S16     FIRCOEF;
+  typedef PS16    PFIRCOEF;
+#endif // SENSORMANAGER_ARGUMENT_TYPE
+
+/// define the FIR filter definition structure
+typedef struct _FILTFIRDEF
+{
+  PFIRCOEF    pxCoefs;          ///< pointer to the coefficients, time reversed
+  PFIRSAMPLE  pxHistory;        ///< pointer to the history buffer, 2 * taps
+  U16         wNumTaps;         ///< number of taps
+} FILTFIRDEF, *PFILTFIRDEF;
+#define FILTFIRDEF_SIZE       sizeof( FILTFIRDEF )
+
+/// define the FIR filter control structure
+typedef struct _FILTFIRCTL
+{
+  FILTFIRDEF  tDef;             ///< definition
+  U16         wIndex;           ///< index of the oldest sample
+  FIRSAMPLE   xOutput;          ///< current output
+  BOOL        bValid;           ///< valid
+} FILTFIRCTL, *PFILTFIRCTL;
+#define FILTFIRCTL_SIZE       sizeof( FILTFIRCTL )
+
+// global parameter declarations -----------------------------------------------
+
+// global function prototypes --------------------------------------------------
+extern  void      FilterFir_Initialize( PFILTFIRCTL ptCtl );
+extern  BOOL      FilterFir_Execute( PFILTFIRCTL ptCtl, FIRSAMPLE xNewSample );
+extern  BOOL      FilterFir_ExecuteBlock( PFILTFIRCTL ptCtl, PFIRSAMPLE pxInput, PFIRSAMPLE pxOutput, U16 wNumSamples );
+extern  FIRSAMPLE FilterFir_GetValue( PFILTFIRCTL ptCtl );
+
+/**@} EOF FilterFir.h */
+
+#endif  // _FILTERFIR_H
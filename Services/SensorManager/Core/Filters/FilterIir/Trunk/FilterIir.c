@@ -0,0 +1,226 @@
+/******************************************************************************
+ * @file FilterIir.c
+ *
+ * @brief IIR filter implementation
+ *
+ * This file provides a cascade of direct form I biquad stages.  Each stage
+ * computes y = b0*x + b1*x1 + b2*x2 + a1*y1 + a2*y2, so the feedback
+ * coefficients are stored negated, as in CMSIS-DSP
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * $Date: $
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ *
+ *
+ * \addtogroup FilterIir
+ * @{
+ *****************************************************************************/
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "SensorManager/Filters/FilterIir/FilterIir.h"
+
+// library includes -----------------------------------------------------------
+
+// Macros and Defines ---------------------------------------------------------
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+
+// global parameter declarations ----------------------------------------------
+
+// local parameter declarations -----------------------------------------------
+
+// local function prototypes --------------------------------------------------
+static  IIRSAMPLE ProcessSample( PFILTIIRCTL ptCtl, IIRSAMPLE xNewSample );
+
+// constant parameter initializations -----------------------------------------
+
+/******************************************************************************
+ * @function FilterIir_Initialize
+ *
+ * @brief IIR filter initialization
+ *
+ * This function will clear the state and output of an IIR filter
+ *
+ * @param[in]   ptCtl       pointer to a control structure
+ *
+ *****************************************************************************/
+void FilterIir_Initialize( PFILTIIRCTL ptCtl )
+{
+  U16 wIdx;
+
+  // clear the state of each stage
+  for ( wIdx = 0; wIdx < ( ptCtl->tDef.nNumStages * FILTIIR_STATES_PER_STAGE ); wIdx++ )
+  {
+    *( ptCtl->tDef.pxState + wIdx ) = 0;
+  }
+
+  // clear the output/valid
+  ptCtl->xOutput = 0;
+  ptCtl->bValid = FALSE;
+}
+
+/******************************************************************************
+ * @function FilterIir_Execute
+ *
+ * @brief IIR filter execution
+ *
+ * This function will perform an IIR filter iteration
+ *
+ * @param[in]   ptCtl       pointer to a control structure
+ * @param[in]   xNewSample  new sample to add
+ *
+ * @return      TRUE if valid filter value, FALSE if not
+ *
+ *****************************************************************************/
+BOOL FilterIir_Execute( PFILTIIRCTL ptCtl, IIRSAMPLE xNewSample )
+{
+  // process the sample
+  ptCtl->xOutput = ProcessSample( ptCtl, xNewSample );
+  ptCtl->bValid = TRUE;
+
+  // return the validity
+  return( ptCtl->bValid );
+}
+
+/******************************************************************************
+ * @function FilterIir_ExecuteBlock
+ *
+ * @brief IIR filter block execution
+ *
+ * This function will filter a block of samples, the input and output may be
+ * the same buffer
+ *
+ * @param[in]   ptCtl         pointer to a control structure
+ * @param[in]   pxInput       pointer to the input samples
+ * @param[io]   pxOutput      pointer to the output samples
+ * @param[in]   wNumSamples   number of samples
+ *
+ * @return      TRUE if the last output is valid, FALSE if not
+ *
+ *****************************************************************************/
+BOOL FilterIir_ExecuteBlock( PFILTIIRCTL ptCtl, PIIRSAMPLE pxInput, PIIRSAMPLE pxOutput, U16 wNumSamples )
+{
+  U16 wIdx;
+
+  // for each sample
+  for ( wIdx = 0; wIdx < wNumSamples; wIdx++ )
+  {
+    // process it
+    *( pxOutput + wIdx ) = ProcessSample( ptCtl, *( pxInput + wIdx ));
+  }
+
+  // update the output/valid if samples were processed
+  if ( wNumSamples != 0 )
+  {
+    ptCtl->xOutput = *( pxOutput + wNumSamples - 1 );
+    ptCtl->bValid = TRUE;
+  }
+
+  // return the validity
+  return( ptCtl->bValid );
+}
+
+/******************************************************************************
+ * @function FilterIir_GetValue
+ *
+ * @brief get the IIR filter output
+ *
+ * This function will get the current IIR filter output
+ *
+ * @param[in]   ptCtl       pointer to a control structure
+ *
+ * @return      current filtered value
+ *
+ *****************************************************************************/
+IIRSAMPLE FilterIir_GetValue( PFILTIIRCTL ptCtl )
+{
+  // return the value
+  return( ptCtl->xOutput );
+}
+
+/******************************************************************************
+ * @function ProcessSample
+ *
+ * @brief process one sample
+ *
+ * This function will run a sample through each stage of the cascade
+ *
+ * @param[in]   ptCtl       pointer to a control structure
+ * @param[in]   xNewSample  new sample to add
+ *
+ * @return      filter output
+ *
+ *****************************************************************************/
+static IIRSAMPLE ProcessSample( PFILTIIRCTL ptCtl, IIRSAMPLE xNewSample )
+{
+  PIIRCOEF    pxCoefs;
+  PIIRSAMPLE  pxState;
+  IIRCOEF     axCoefs[ FILTIIR_COEFS_PER_STAGE ];
+  U8          nStage, nCoef;
+  IIRSAMPLE   xOutput;
+  #if ( SENSORMANAGER_ARGUMENT_TYPE == SENSORMANAGER_TYPE_FLOAT )
+  FLOAT       fAccum;
+  U32UN       tCoef;
+  #else
+  S64         hAccum;
+  #endif // SENSORMANAGER_ARGUMENT_TYPE
+
+  // get the pointers
+  pxCoefs = ptCtl->tDef.pxCoefs;
+  pxState = ptCtl->tDef.pxState;
+
+  // for each stage
+  for ( nStage = 0; nStage < ptCtl->tDef.nNumStages; nStage++ )
+  {
+    // read the stage coefficients from program memory
+    for ( nCoef = 0; nCoef < FILTIIR_COEFS_PER_STAGE; nCoef++ )
+    {
+      #if ( SENSORMANAGER_ARGUMENT_TYPE == SENSORMANAGER_TYPE_FLOAT )
+      tCoef.uValue = PGM_RDDWRD( *(( PU32 )pxCoefs + nCoef ));
+      axCoefs[ nCoef ] = tCoef.fValue;
+      #else
+      axCoefs[ nCoef ] = ( IIRCOEF )PGM_RDWORD( *( pxCoefs + nCoef ));
+      #endif // SENSORMANAGER_ARGUMENT_TYPE
+    }
+
+    // compute the stage output
+    #if ( SENSORMANAGER_ARGUMENT_TYPE == SENSORMANAGER_TYPE_FLOAT )
+    fAccum = ( axCoefs[ 0 ] * xNewSample ) + ( axCoefs[ 1 ] * pxState[ 0 ] ) + ( axCoefs[ 2 ] * pxState[ 1 ] );
+    fAccum += ( axCoefs[ 3 ] * pxState[ 2 ] ) + ( axCoefs[ 4 ] * pxState[ 3 ] );
+    xOutput = fAccum;
+    #else
+    hAccum = (( S64 )axCoefs[ 0 ] * xNewSample ) + (( S64 )axCoefs[ 1 ] * pxState[ 0 ] ) + (( S64 )axCoefs[ 2 ] * pxState[ 1 ] );
+    hAccum += (( S64 )axCoefs[ 3 ] * pxState[ 2 ] ) + (( S64 )axCoefs[ 4 ] * pxState[ 3 ] );
+    xOutput = ( IIRSAMPLE )(( hAccum + ( 1L << ( FILTIIR_COEF_FRAC_BITS - 1 ))) >> FILTIIR_COEF_FRAC_BITS );
+    #endif // SENSORMANAGER_ARGUMENT_TYPE
+
+    // shift the state
+    pxState[ 1 ] = pxState[ 0 ];
+    pxState[ 0 ] = xNewSample;
+    pxState[ 3 ] = pxState[ 2 ];
+    pxState[ 2 ] = xOutput;
+
+    // the output feeds the next stage
+    xNewSample = xOutput;
+    pxCoefs += FILTIIR_COEFS_PER_STAGE;
+    pxState += FILTIIR_STATES_PER_STAGE;
+  }
+
+  // return the output
+  return( xNewSample );
+}
+
+/**@} EOF FilterIir.c */
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * @file FilterIir.h
+ *
+ * @brief IIR filter declarations
+ *
+ * This file provides the declaration for the biquad cascade IIR filter
+ * implementation
+ *
+ * @copyright Copyright (c) 2012 CyberIntegration
+ * This document contains proprietary data and information of CyberIntegration
+ * LLC. It is the exclusive property of CyberIntegration, LLC and will not be
+ * disclosed in any form to any party without prior written permission of
+ * CyberIntegration, LLC. This document may not be reproduced or further used
+ * without the prior written permission of CyberIntegration, LLC.
+ *
+ * $Date: $
+ *
+ * Version History
+ * ======
+ * $Rev: $
+ *
+ *
+ * \addtogroup FilterIir
+ * @{
+ *****************************************************************************/
+
+// ensure only one instantiation
+#ifndef _FILTERIIR_H
+#define _FILTERIIR_H
+
+// system includes ------------------------------------------------------------
+
+// local includes -------------------------------------------------------------
+#include "SensorManager/SensorManager_prm.h"
+
+// library includes -----------------------------------------------------------
+#include "Types/Types.h"
+
+// Macros and Defines ---------------------------------------------------------
+/// define the number of fractional bits in a fixed point coefficient
+#define FILTIIR_COEF_FRAC_BITS        ( 14 )
+
+/// define the number of coefficients/states per stage
+#define FILTIIR_COEFS_PER_STAGE       ( 5 )
+#define FILTIIR_STATES_PER_STAGE      ( 4 )
+
+/// define the limits of a fixed point coefficient
+#define FILTIIR_COEF_MAX              ( 32767 )
+#define FILTIIR_COEF_MIN              ( -32768 )
+
+/// define the helper macro for converting a real coefficient, rounded to fixed point and saturated for integer types
+#if ( SENSORMANAGER_ARGUMENT_TYPE == SENSORMANAGER_TYPE_FLOAT )
+  #define FILTIIR_COEF( val ) \
+    (( IIRCOEF )( val ))
+#else
+  #define FILTIIR_COEF_SCALED( val ) \
+    ((( val ) * ( 1L << FILTIIR_COEF_FRAC_BITS )) + ((( val ) < 0 ) ? -0.5 : 0.5 ))
+  #define FILTIIR_COEF( val ) \
+    (( IIRCOEF )(( FILTIIR_COEF_SCALED( val ) > FILTIIR_COEF_MAX ) ? FILTIIR_COEF_MAX : \
+                 (( FILTIIR_COEF_SCALED( val ) < FILTIIR_COEF_MIN ) ? FILTIIR_COEF_MIN : FILTIIR_COEF_SCALED( val ))))
+#endif // SENSORMANAGER_ARGUMENT_TYPE
+
+/// define the helper macro for defining the IIR filter state buffer
+#define SENMANIIRFILTSTORAGE( bufname, numstages ) \
+  static  IIRSAMPLE ax ## bufname ## IirFilt[ numstages * FILTIIR_STATES_PER_STAGE ];
+
+// enumerations ---------------------------------------------------------------
+
+// structures -----------------------------------------------------------------
+/// define the sample and coefficient types, Q14 coefficients for integer types
+#if ( SENSORMANAGER_ARGUMENT_TYPE == SENSORMANAGER_TYPE_FLOAT )
+  typedef FLOAT   IIRSAMPLE;
+  typedef PFLOAT  PIIRSAMPLE;
+  typedef FLOAT   IIRCOEF;
+  typedef PFLOAT  PIIRCOEF;
+#else
+  typedef S32     IIRSAMPLE;
+  typedef PS32    PIIRSAMPLE;
+  typedef S16     IIRCOEF;
+  typedef PS16    PIIRCOEF;
+#endif // SENSORMANAGER_ARGUMENT_TYPE
+
+/// define the IIR filter definition structure
+typedef struct _FILTIIRDEF
+{
+  PIIRCOEF    pxCoefs;          ///< pointer to the coefficients, b0 b1 b2 a1 a2 per stage
+  PIIRSAMPLE  pxState;          ///< pointer to the state, x1 x2 y1 y2 per stage
+  U8          nNumStages;       ///< number of stages
+} FILTIIRDEF, *PFILTIIRDEF;
+#define FILTIIRDEF_SIZE       sizeof( FILTIIRDEF )
+
+/// define the IIR filter control structure
+typedef struct _FILTIIRCTL
+{
+  FILTIIRDEF  tDef;             ///< definition
+  IIRSAMPLE   xOutput;          ///< current output
+  BOOL        bValid;           ///< valid
+} FILTIIRCTL, *PFILTIIRCTL;
+#define FILTIIRCTL_SIZE       sizeof( FILTIIRCTL )
+
+// global parameter declarations -----------------------------------------------
+
+// global function prototypes --------------------------------------------------
+extern  void      FilterIir_Initialize( PFILTIIRCTL ptCtl );
+extern  BOOL      FilterIir_Execute( PFILTIIRCTL ptCtl, IIRSAMPLE xNewSample );
+extern  BOOL      FilterIir_ExecuteBlock( PFILTIIRCTL ptCtl, PIIRSAMPLE pxInput, PIIRSAMPLE pxOutput, U16 wNumSamples );
+extern  IIRSAMPLE FilterIir_GetValue( PFILTIIRCTL ptCtl );
+
+/**@} EOF FilterIir.h */
+
+#endif  // _FILTERIIR_H
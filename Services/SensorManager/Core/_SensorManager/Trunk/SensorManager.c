@@ -35,18 +35,6 @@
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
-/// define the FIR filter control structure
-typedef struct _FIRFILTCTL
-{
-} FIRFILTCTL, *PFIRFILTCTL;
-#define FIRFILTCTL_SIZE   sizeof ( FIRFILTCTL )
-
-/// define the IIR filter control structure
-typedef struct _IIRFILTCTL
-{
-} IIRFILTCTL, *PIIRFILTCTL;
-#define IIRFILTCTL_SIZE   sizeof ( IIRFILTCTL )
-
 /// define the overall control structure
 typedef struct _SENMANCTL
 {
@@ -63,21 +51,52 @@ typedef struct _SENMANCTL
       FILTLDLGCTL     tLeadLag;   ///< lead/lag control
     #endif
     #if ( SENSORMANAGER_FIR_FILTER_ENABLE == 1 )
-      FIRFILTCTL      tFir;       ///< FIR control
+      FILTFIRCTL      tFir;       ///< FIR control
     #endif
     #if ( SENSORMANAGER_IIR_FILTER_ENABLE == 1 )
-      IIRFILTCTL      tIir;       ///< IIR control
+      FILTIIRCTL      tIir;       ///< IIR control
     #endif
   } tFilters;
+  #if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+  SENMANINPTYPE   eInpType;       ///< input type
+  SENMANFILTTYPE  eFiltType;      ///< filter type
+  U8              nChannel;       ///< channel
+  PVSENMANGEREXT  pvExtGet;       ///< external channel get function
+  PVSENMANGERSPC  pvSpcGet;       ///< special get function
+  #endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
 } SENMANCTL, *PSENMANCTL;
 #define SENMANCTL_SIZE    sizeof( SENMANCTL )
 
+#if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+/// define the rate group structure
+typedef struct _SCANGROUP
+{
+  U32         uDesExecCount;      ///< desired execution counts
+  U32         uCurExecCount;      ///< current execution counts
+  U8          nFirst;             ///< index of the first sensor in the schedule
+  U8          nNumSensors;        ///< number of sensors
+  U8          nNumIntAna;         ///< number of internal analog sensors, first in the group
+} SCANGROUP, *PSCANGROUP;
+#define SCANGROUP_SIZE    sizeof( SCANGROUP )
+#endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
+
 // global parameter declarations ----------------------------------------------
 
 // local parameter declarations -----------------------------------------------
 static  SENMANCTL   atCtls[ SENMAN_ENUM_MAX ];
+#if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+static  SENMANENUM  aeSchedule[ SENMAN_ENUM_MAX ];
+static  SCANGROUP   atGroups[ SENMAN_ENUM_MAX ];
+static  U8          nNumGroups;
+static  U8          anAdcChannels[ SENMAN_ENUM_MAX ];
+static  U16         awAdcValues[ SENMAN_ENUM_MAX ];
+#endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
 
 // local function prototypes --------------------------------------------------
+static  void  FilterSample( SENMANENUM eSensor, SENMANFILTTYPE eFiltType, S32 lSenValue );
+#if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+static  void  BuildSchedule( void );
+#endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
 
 // constant parameter initializations -----------------------------------------
 
@@ -110,6 +129,15 @@ void SensorManager_Initialize( void )
     ptCtl->uCurExecCount = 0;
     ptCtl->bValid = FALSE;
     
+    #if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+    // cache the scan fields
+    ptCtl->eInpType = PGM_RDBYTE( ptDef->eInpType );
+    ptCtl->eFiltType = PGM_RDBYTE( ptDef->eFiltType );
+    ptCtl->nChannel = PGM_RDBYTE( ptDef->nChannel );
+    ptCtl->pvExtGet = ( ptCtl->eInpType == SENMAN_INPTYPE_EXTANA ) ? PGM_RDWORD_PTR( ptDef->tGetFuncs.pvExt ) : NULL;
+    ptCtl->pvSpcGet = ( ptCtl->eInpType == SENMAN_INPTYPE_SPCANA ) ? PGM_RDWORD_PTR( ptDef->tGetFuncs.pvSpc ) : NULL;
+    #endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
+
     // determine the type of filter
     switch( PGM_RDBYTE( ptDef->eFiltType ))
     {
@@ -134,11 +162,21 @@ void SensorManager_Initialize( void )
         
     #if ( SENSORMANAGER_FIR_FILTER_ENABLE == 1 )
       case SENMAN_FILTTYPE_FIR :
+        // copy the definition/clear the history
+        ptCtl->tFilters.tFir.tDef.pxCoefs = ( PFIRCOEF )PGM_RDWORD_PTR( ptDef->tFilters.tFir.pxCoefs );
+        ptCtl->tFilters.tFir.tDef.pxHistory = ( PFIRSAMPLE )PGM_RDWORD_PTR( ptDef->tFilters.tFir.pxHistory );
+        ptCtl->tFilters.tFir.tDef.wNumTaps = PGM_RDWORD( ptDef->tFilters.tFir.wNumTaps );
+        FilterFir_Initialize( &ptCtl->tFilters.tFir );
         break;
     #endif
         
     #if ( SENSORMANAGER_IIR_FILTER_ENABLE == 1 )
       case SENMAN_FILTTYPE_IIR :
+        // copy the definition/clear the state
+        ptCtl->tFilters.tIir.tDef.pxCoefs = ( PIIRCOEF )PGM_RDWORD_PTR( ptDef->tFilters.tIir.pxCoefs );
+        ptCtl->tFilters.tIir.tDef.pxState = ( PIIRSAMPLE )PGM_RDWORD_PTR( ptDef->tFilters.tIir.pxState );
+        ptCtl->tFilters.tIir.tDef.nNumStages = PGM_RDBYTE( ptDef->tFilters.tIir.nNumStages );
+        FilterIir_Initialize( &ptCtl->tFilters.tIir );
         break;
     #endif
         
@@ -152,6 +190,11 @@ void SensorManager_Initialize( void )
         break;
     }
   }
+
+  #if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+  // build the scan schedule
+  BuildSchedule( );
+  #endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
 }
 
 /******************************************************************************
@@ -164,13 +207,74 @@ void SensorManager_Initialize( void )
  *****************************************************************************/
 void SensorManager_ProcessScan( void )
 {
-  PSENMANDEF      ptDef;
   PSENMANCTL      ptCtl;
   SENMANENUM      eSensor;
   S32             lSenValue;
+  #if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+  PSCANGROUP      ptGroup;
+  U8              nGroup, nIdx;
+  #else
+  PSENMANDEF      ptDef;
   PVSENMANGEREXT  pvExtGet;
   PVSENMANGERSPC  pvSpcGet;
+  #endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
   
+  #if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+  // for each rate group
+  for ( nGroup = 0; nGroup < nNumGroups; nGroup++ )
+  {
+    // get a pointer to the group
+    ptGroup = &atGroups[ nGroup ];
+
+    // now increment the group time/check for ready
+    if ( ++ptGroup->uCurExecCount == ptGroup->uDesExecCount )
+    {
+      // reset the time
+      ptGroup->uCurExecCount = 0;
+
+      // convert all internal channels of this group at once
+      if ( ptGroup->nNumIntAna != 0 )
+      {
+        for ( nIdx = 0; nIdx < ptGroup->nNumIntAna; nIdx++ )
+        {
+          anAdcChannels[ nIdx ] = atCtls[ aeSchedule[ ptGroup->nFirst + nIdx ]].nChannel;
+        }
+        SensorManager_InternalAdcConvertChannels( anAdcChannels, awAdcValues, ptGroup->nNumIntAna );
+      }
+
+      // for each sensor in the group
+      for ( nIdx = 0; nIdx < ptGroup->nNumSensors; nIdx++ )
+      {
+        // get the sensor/control
+        eSensor = aeSchedule[ ptGroup->nFirst + nIdx ];
+        ptCtl = &atCtls[ eSensor ];
+
+        // get a value based on type
+        switch( ptCtl->eInpType )
+        {
+          case SENMAN_INPTYPE_INTANA :
+            lSenValue = ( U32 )awAdcValues[ nIdx ];
+            break;
+
+          case SENMAN_INPTYPE_EXTANA :
+            lSenValue = ( U32 )ptCtl->pvExtGet( ptCtl->nChannel );
+            break;
+
+          case SENMAN_INPTYPE_SPCANA :
+            lSenValue = ( U32 )ptCtl->pvSpcGet( );
+            break;
+
+          default :
+            lSenValue = 0;
+            break;
+        }
+
+        // filter it
+        FilterSample( eSensor, ptCtl->eFiltType, lSenValue );
+      }
+    }
+  }
+  #else
   // for each sensor
   for ( eSensor = 0; eSensor < SENMAN_ENUM_MAX; eSensor++ )
   {
@@ -206,46 +310,11 @@ void SensorManager_ProcessScan( void )
           break;
       }
       
-      // determine the type of filter
-      switch( PGM_RDBYTE( ptDef->eFiltType ))
-      {
-      #if ( SENSORMANAGER_AVERAGE_FILTER_ENABLE == 1 )
-        case SENMAN_FILTTYPE_AVERAGE :
-          ptCtl->bValid = FilterAveraging_Execute( &ptCtl->tFilters.tAverage, lSenValue );
-          break;
-      #endif
-          
-      #if ( SENSORMANAGER_LEADLAG_FILTER_ENABLE == 1 )
-        case SENMAN_FILTTYPE_LEADLAG :
-          ptCtl->bValid = FilterLeadLag_Execute( &ptCtl->tFilters.tLeadLag, lSenValue, ( U32 )TASK_TIME_MSECS( PGM_RDWORD( ptDef->wSampleRate )));
-          break;
-      #endif
-          
-      #if ( SENSORMANAGER_FIR_FILTER_ENABLE == 1 )
-        case SENMAN_FILTTYPE_FIR :
-          break;
-      #endif
-          
-      #if ( SENSORMANAGER_IIR_FILTER_ENABLE == 1 )
-        case SENMAN_FILTTYPE_IIR :
-          break;
-      #endif
-          
-      #if ( SENSORMANAGER_USR_FILTER_ENABLE == 1 )
-        case SENMAN_FILTTYPE_USER :
-          break;
-      #endif
-
-        case SENMAN_FILTTYPE_NONE :
-          ptCtl->bValid = TRUE;
-          ptCtl->xCurrentValue = ( SENMANARG )lSenValue;
-          break;
-          
-        default :
-          break;
-      }
+      // filter it
+      FilterSample( eSensor, PGM_RDBYTE( ptDef->eFiltType ), lSenValue );
     }
   }
+  #endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
 }
 
 /******************************************************************************
@@ -296,6 +365,18 @@ SENMANERROR SensorManager_GetValue( SENMANENUM eSenEnum, PSENMANARG pxValue )
           ptCtl->xCurrentValue = FilterLeadLag_GetValue( &ptCtl->tFilters.tLeadLag );
           break;
       #endif
+
+      #if ( SENSORMANAGER_FIR_FILTER_ENABLE == 1 )
+        case SENMAN_FILTTYPE_FIR :
+          ptCtl->xCurrentValue = ( SENMANARG )FilterFir_GetValue( &ptCtl->tFilters.tFir );
+          break;
+      #endif
+
+      #if ( SENSORMANAGER_IIR_FILTER_ENABLE == 1 )
+        case SENMAN_FILTTYPE_IIR :
+          ptCtl->xCurrentValue = ( SENMANARG )FilterIir_GetValue( &ptCtl->tFilters.tIir );
+          break;
+      #endif
         
         default :
           break;
@@ -333,4 +414,148 @@ SENMANERROR SensorManager_GetValue( SENMANENUM eSenEnum, PSENMANARG pxValue )
   return( eError );
 }
 
+/******************************************************************************
+ * @function FilterSample
+ *
+ * @brief filter a new sample
+ *
+ * This function will apply the sensor's filter to a new sample
+ *
+ * @param[in]   eSensor     sensor enumeration
+ * @param[in]   eFiltType   filter type
+ * @param[in]   lSenValue   new sample
+ *
+ *****************************************************************************/
+static void FilterSample( SENMANENUM eSensor, SENMANFILTTYPE eFiltType, S32 lSenValue )
+{
+  PSENMANCTL  ptCtl;
+  #if ( SENSORMANAGER_LEADLAG_FILTER_ENABLE == 1 )
+  PSENMANDEF  ptDef;
+
+  // get a pointer to the definition
+  ptDef = ( PSENMANDEF )&atSensorMngrDefs[ eSensor ];
+  #endif // SENSORMANAGER_LEADLAG_FILTER_ENABLE
+
+  // get a pointer to the control
+  ptCtl = ( PSENMANCTL )&atCtls[ eSensor ];
+
+  // determine the type of filter
+  switch( eFiltType )
+  {
+  #if ( SENSORMANAGER_AVERAGE_FILTER_ENABLE == 1 )
+    case SENMAN_FILTTYPE_AVERAGE :
+      ptCtl->bValid = FilterAveraging_Execute( &ptCtl->tFilters.tAverage, lSenValue );
+      break;
+  #endif
+      
+  #if ( SENSORMANAGER_LEADLAG_FILTER_ENABLE == 1 )
+    case SENMAN_FILTTYPE_LEADLAG :
+      ptCtl->bValid = FilterLeadLag_Execute( &ptCtl->tFilters.tLeadLag, lSenValue, ( U32 )TASK_TIME_MSECS( PGM_RDWORD( ptDef->wSampleRate )));
+      break;
+  #endif
+      
+  #if ( SENSORMANAGER_FIR_FILTER_ENABLE == 1 )
+    case SENMAN_FILTTYPE_FIR :
+      ptCtl->bValid = FilterFir_Execute( &ptCtl->tFilters.tFir, ( FIRSAMPLE )lSenValue );
+      break;
+  #endif
+      
+  #if ( SENSORMANAGER_IIR_FILTER_ENABLE == 1 )
+    case SENMAN_FILTTYPE_IIR :
+      ptCtl->bValid = FilterIir_Execute( &ptCtl->tFilters.tIir, ( IIRSAMPLE )lSenValue );
+      break;
+  #endif
+      
+  #if ( SENSORMANAGER_USR_FILTER_ENABLE == 1 )
+    case SENMAN_FILTTYPE_USER :
+      break;
+  #endif
+
+    case SENMAN_FILTTYPE_NONE :
+      ptCtl->bValid = TRUE;
+      ptCtl->xCurrentValue = ( SENMANARG )lSenValue;
+      break;
+      
+    default :
+      break;
+  }
+}
+
+#if ( SENSORMANAGER_ENABLE_RATE_SCHEDULE == 1 )
+/******************************************************************************
+ * @function BuildSchedule
+ *
+ * @brief build the scan schedule
+ *
+ * This function will sort the sensors by their execution count, internal
+ * analog sensors first within a count, and group the sensors that share a
+ * count so a scan only visits the groups that are due
+ *
+ *****************************************************************************/
+static void BuildSchedule( void )
+{
+  SENMANENUM  eSensor;
+  PSENMANCTL  ptCtl, ptOther;
+  PSCANGROUP  ptGroup;
+  U8          nNumScheduled, nIdx;
+  BOOL        bIntAna;
+
+  // clear the schedule
+  nNumScheduled = 0;
+  nNumGroups = 0;
+
+  // insert each sensor in sorted order
+  for ( eSensor = 0; eSensor < SENMAN_ENUM_MAX; eSensor++ )
+  {
+    // sensors that can never be due are not scheduled
+    ptCtl = &atCtls[ eSensor ];
+    if ( ptCtl->uDesExecCount != 0 )
+    {
+      // move the later entries up
+      bIntAna = ( ptCtl->eInpType == SENMAN_INPTYPE_INTANA ) ? TRUE : FALSE;
+      for ( nIdx = nNumScheduled; nIdx > 0; nIdx-- )
+      {
+        // stop at the first entry that sorts before this one
+        ptOther = &atCtls[ aeSchedule[ nIdx - 1 ]];
+        if (( ptOther->uDesExecCount < ptCtl->uDesExecCount ) ||
+            (( ptOther->uDesExecCount == ptCtl->uDesExecCount ) && (( ptOther->eInpType == SENMAN_INPTYPE_INTANA ) || ( bIntAna == FALSE ))))
+        {
+          break;
+        }
+        aeSchedule[ nIdx ] = aeSchedule[ nIdx - 1 ];
+      }
+
+      // insert it
+      aeSchedule[ nIdx ] = eSensor;
+      nNumScheduled++;
+    }
+  }
+
+  // now split into groups
+  for ( nIdx = 0; nIdx < nNumScheduled; nIdx++ )
+  {
+    // check for a new count
+    ptCtl = &atCtls[ aeSchedule[ nIdx ]];
+    if (( nNumGroups == 0 ) || ( atGroups[ nNumGroups - 1 ].uDesExecCount != ptCtl->uDesExecCount ))
+    {
+      // start a new group
+      ptGroup = &atGroups[ nNumGroups++ ];
+      ptGroup->uDesExecCount = ptCtl->uDesExecCount;
+      ptGroup->uCurExecCount = 0;
+      ptGroup->nFirst = nIdx;
+      ptGroup->nNumSensors = 0;
+      ptGroup->nNumIntAna = 0;
+    }
+
+    // add the sensor
+    ptGroup = &atGroups[ nNumGroups - 1 ];
+    ptGroup->nNumSensors++;
+    if ( ptCtl->eInpType == SENMAN_INPTYPE_INTANA )
+    {
+      ptGroup->nNumIntAna++;
+    }
+  }
+}
+#endif // SENSORMANAGER_ENABLE_RATE_SCHEDULE
+
 /**@} EOF Sensormanager.c */
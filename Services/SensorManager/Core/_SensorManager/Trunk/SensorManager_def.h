@@ -35,6 +35,12 @@
 #if ( SENSORMANAGER_LEADLAG_FILTER_ENABLE == 1 )
 #include "SensorManager/Filters/FilterLeadLag/FilterLeadLag.h"
 #endif // SENSORMANAGER_LEADLAG_FILTER_ENABLE
+#if ( SENSORMANAGER_FIR_FILTER_ENABLE == 1 )
+#include "SensorManager/Filters/FilterFir/FilterFir.h"
+#endif // SENSORMANAGER_FIR_FILTER_ENABLE
+#if ( SENSORMANAGER_IIR_FILTER_ENABLE == 1 )
+#include "SensorManager/Filters/FilterIir/FilterIir.h"
+#endif // SENSORMANAGER_IIR_FILTER_ENABLE
 
 // library includes -----------------------------------------------------------
 #include "Types/Types.h"
@@ -151,6 +157,50 @@
   }
 #endif // SENSORMANAGER_LEADLAG_FILTER_ENABLE
 
+#if ( SENSORMANAGER_FIR_FILTER_ENABLE == 1 )
+/// define the helper macro for defining a internal channel with FIR filter
+#define SENMANINTFIRFILT( chan, samprate, minraw, maxraw, minegu, maxegu, numtaps, coefs, bufname ) \
+  { \
+    .eInpType = SENMAN_INPTYPE_INTANA, \
+    .nChannel = chan, \
+    .wSampleRate = samprate, \
+    .xMinRawValue = minraw, \
+    .xMaxRawValue = maxraw, \
+    .xMinEguValue = minegu, \
+    .xMaxEguValue = maxegu, \
+    .eFiltType = SENMAN_FILTTYPE_FIR, \
+    .tFilters.tFir = \
+    { \
+      .pxCoefs = ( PFIRCOEF )coefs, \
+      .pxHistory = ( PFIRSAMPLE )&ax ## bufname ## FirFilt, \
+      .wNumTaps = numtaps, \
+    }, \
+    .pvLinearize = NULL, \
+  }
+#endif // SENSORMANAGER_FIR_FILTER_ENABLE
+
+#if ( SENSORMANAGER_IIR_FILTER_ENABLE == 1 )
+/// define the helper macro for defining a internal channel with IIR filter
+#define SENMANINTIIRFILT( chan, samprate, minraw, maxraw, minegu, maxegu, numstages, coefs, bufname ) \
+  { \
+    .eInpType = SENMAN_INPTYPE_INTANA, \
+    .nChannel = chan, \
+    .wSampleRate = samprate, \
+    .xMinRawValue = minraw, \
+    .xMaxRawValue = maxraw, \
+    .xMinEguValue = minegu, \
+    .xMaxEguValue = maxegu, \
+    .eFiltType = SENMAN_FILTTYPE_IIR, \
+    .tFilters.tIir = \
+    { \
+      .pxCoefs = ( PIIRCOEF )coefs, \
+      .pxState = ( PIIRSAMPLE )&ax ## bufname ## IirFilt, \
+      .nNumStages = numstages, \
+    }, \
+    .pvLinearize = NULL, \
+  }
+#endif // SENSORMANAGER_IIR_FILTER_ENABLE
+
 /// define the helper macro for defining an external channel no filter
 #define SENMANEXTNOFILT( chan, samprate, minraw, maxraw, minegu, maxegu, getfunc ) \
   { \
@@ -265,6 +315,52 @@
     .nLinOption = linopt, \
   }
 #endif // SENSORMANAGER_LEADLAG_FILTER_ENABLE
+
+#if ( SENSORMANAGER_FIR_FILTER_ENABLE == 1 )
+/// define the helper macro for defining a external channel with FIR filter
+#define SENMANEXTFIRFILT( chan, samprate, minraw, maxraw, minegu, maxegu, numtaps, coefs, bufname, getfunc ) \
+  { \
+    .eInpType = SENMAN_INPTYPE_EXTANA, \
+    .nChannel = chan, \
+    .wSampleRate = samprate, \
+    .xMinRawValue = minraw, \
+    .xMaxRawValue = maxraw, \
+    .xMinEguValue = minegu, \
+    .xMaxEguValue = maxegu, \
+    .eFiltType = SENMAN_FILTTYPE_FIR, \
+    .tFilters.tFir = \
+    { \
+      .pxCoefs = ( PFIRCOEF )coefs, \
+      .pxHistory = ( PFIRSAMPLE )&ax ## bufname ## FirFilt, \
+      .wNumTaps = numtaps, \
+    }, \
+    .tGetFuncs.pvExt = getfunc, \
+    .pvLinearize = NULL, \
+  }
+#endif // SENSORMANAGER_FIR_FILTER_ENABLE
+
+#if ( SENSORMANAGER_IIR_FILTER_ENABLE == 1 )
+/// define the helper macro for defining a external channel with IIR filter
+#define SENMANEXTIIRFILT( chan, samprate, minraw, maxraw, minegu, maxegu, numstages, coefs, bufname, getfunc ) \
+  { \
+    .eInpType = SENMAN_INPTYPE_EXTANA, \
+    .nChannel = chan, \
+    .wSampleRate = samprate, \
+    .xMinRawValue = minraw, \
+    .xMaxRawValue = maxraw, \
+    .xMinEguValue = minegu, \
+    .xMaxEguValue = maxegu, \
+    .eFiltType = SENMAN_FILTTYPE_IIR, \
+    .tFilters.tIir = \
+    { \
+      .pxCoefs = ( PIIRCOEF )coefs, \
+      .pxState = ( PIIRSAMPLE )&ax ## bufname ## IirFilt, \
+      .nNumStages = numstages, \
+    }, \
+    .tGetFuncs.pvExt = getfunc, \
+    .pvLinearize = NULL, \
+  }
+#endif // SENSORMANAGER_IIR_FILTER_ENABLE
   
 /// define the helper macro for defining a special channel no filter
 #define SENMANSPCNOFILT( samprate, minraw, maxraw, minegu, maxegu, getfunc ) \
@@ -376,6 +472,50 @@
     .nLinOption = linopt, \
   }
 #endif // SENSORMANAGER_LEADLAG_FILTER_ENABLE
+
+#if ( SENSORMANAGER_FIR_FILTER_ENABLE == 1 )
+/// define the helper macro for defining a special channel with FIR filter
+#define SENMANSPCFIRFILT( samprate, minraw, maxraw, minegu, maxegu, numtaps, coefs, bufname, getfunc ) \
+  { \
+    .eInpType = SENMAN_INPTYPE_SPCANA, \
+    .wSampleRate = samprate, \
+    .xMinRawValue = minraw, \
+    .xMaxRawValue = maxraw, \
+    .xMinEguValue = minegu, \
+    .xMaxEguValue = maxegu, \
+    .eFiltType = SENMAN_FILTTYPE_FIR, \
+    .tFilters.tFir = \
+    { \
+      .pxCoefs = ( PFIRCOEF )coefs, \
+      .pxHistory = ( PFIRSAMPLE )&ax ## bufname ## FirFilt, \
+      .wNumTaps = numtaps, \
+    }, \
+    .tGetFuncs.pvSpc = getfunc, \
+    .pvLinearize = NULL, \
+  }
+#endif // SENSORMANAGER_FIR_FILTER_ENABLE
+
+#if ( SENSORMANAGER_IIR_FILTER_ENABLE == 1 )
+/// define the helper macro for defining a special channel with IIR filter
+#define SENMANSPCIIRFILT( samprate, minraw, maxraw, minegu, maxegu, numstages, coefs, bufname, getfunc ) \
+  { \
+    .eInpType = SENMAN_INPTYPE_SPCANA, \
+    .wSampleRate = samprate, \
+    .xMinRawValue = minraw, \
+    .xMaxRawValue = maxraw, \
+    .xMinEguValue = minegu, \
+    .xMaxEguValue = maxegu, \
+    .eFiltType = SENMAN_FILTTYPE_IIR, \
+    .tFilters.tIir = \
+    { \
+      .pxCoefs = ( PIIRCOEF )coefs, \
+      .pxState = ( PIIRSAMPLE )&ax ## bufname ## IirFilt, \
+      .nNumStages = numstages, \
+    }, \
+    .tGetFuncs.pvSpc = getfunc, \
+    .pvLinearize = NULL, \
+  }
+#endif // SENSORMANAGER_IIR_FILTER_ENABLE
   
 // enumerations ---------------------------------------------------------------
 /// enumerate the analog input type
@@ -450,10 +590,10 @@ typedef struct _SENMANDEF
       FILTLDLGDEF     tLeadLag;     /// lead/lag definition
     #endif // SENSORMANAGER_LEADLAG_FILTER_ENABLE
     #if ( SENSORMANAGER_FIR_FILTER_ENABLE == 1 )
-      SENMANFIRFILT   tFir;         /// FIR definition
+      FILTFIRDEF      tFir;         /// FIR definition
     #endif // SENSORMANAGER_FIR_FILTER_ENABLE
     #if ( SENSORMANAGER_IIR_FILTER_ENABLE == 1 )
-      SENMANIIRFILT   tIir;         /// IIR definition
+      FILTIIRDEF      tIir;         /// IIR definition
     #endif // SENSORMANAGER_IIR_FILTER_ENABLE
     #if ( SENSORMANAGER_USR_FILTER_ENABLE == 1 )
       SENMANUSERFILT  tUser;        /// user definition
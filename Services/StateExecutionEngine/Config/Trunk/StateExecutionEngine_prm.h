@@ -56,6 +56,18 @@
   #define STATEEXECENG_ARG_SIZE_BYTES             ( 2 )
 #endif  // SYSTEMDEFINE_OS_SELECTION
 
+/// define the macro to compile the event tables into sorted tables - set to 1 to enable
+#define STATEEXECENG_ENABLE_COMPILED_EVENTS       ( 0 )
+
+/// define the number of compiled states, must be a power of 2
+#define STATEEXECENG_NUM_COMPILED_STATES          ( 32 )
+
+/// define the number of compiled events for all states
+#define STATEEXECENG_NUM_COMPILED_EVENTS          ( 128 )
+
+/// define the macro to enable the per state hit counters - set to 1 to enable
+#define STATEEXECENG_ENABLE_HIT_COUNTERS          ( 0 )
+
 // enumerations ---------------------------------------------------------------
 
 // structures -----------------------------------------------------------------
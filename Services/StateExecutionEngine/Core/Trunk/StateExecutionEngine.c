@@ -24,9 +24,53 @@
 // local includes -------------------------------------------------------------
 #include "StateExecutionEngine/StateExecutionEngine.h"
 
+// library includes -----------------------------------------------------------
+#if ( STATEEXECENG_ENABLE_COMPILED_EVENTS == 1 )
+#include "Interrupt/Interrupt.h"
+#endif // STATEEXECENG_ENABLE_COMPILED_EVENTS
+
+// Macros and Defines ---------------------------------------------------------
+#if ( STATEEXECENG_ENABLE_HIT_COUNTERS == 1 ) && ( STATEEXECENG_ENABLE_COMPILED_EVENTS == 0 )
+  #error The hit counters require STATEEXECENG_ENABLE_COMPILED_EVENTS
+#endif
+
+#if ( STATEEXECENG_ENABLE_COMPILED_EVENTS == 1 )
+/// define the compiled state hash mask
+#define COMPILED_STATE_MASK       ( STATEEXECENG_NUM_COMPILED_STATES - 1 )
+
+/// define the illegal compiled index
+#define COMPILED_IDX_NONE         ( 0xFF )
+
+// structures -----------------------------------------------------------------
+/// define the compiled state structure
+typedef struct _COMPILEDSTATE
+{
+  STATEEXECENGTABLE const*  ptStates;     ///< state table, NULL if free
+  U16                       wOffset;      ///< offset of the first event
+  U8                        nState;       ///< state
+  U8                        nNumEvents;   ///< number of events
+  BOOL                      bValid;       ///< events are compiled
+  #if ( STATEEXECENG_ENABLE_HIT_COUNTERS == 1 )
+  U32                       uHits;        ///< number of events processed in this state
+  #endif // STATEEXECENG_ENABLE_HIT_COUNTERS
+} COMPILEDSTATE, *PCOMPILEDSTATE;
+#define COMPILEDSTATE_SIZE        sizeof( COMPILEDSTATE )
+
+// local parameter declarations -----------------------------------------------
+static  COMPILEDSTATE     atCompiledStates[ STATEEXECENG_NUM_COMPILED_STATES ];
+static  STATEEXECENGEVENT atCompiledEvents[ STATEEXECENG_NUM_COMPILED_EVENTS ];
+static  U16               wNumCompiledEvents;
+#endif // STATEEXECENG_ENABLE_COMPILED_EVENTS
+
 // local function prototypes --------------------------------------------------
 static  void            ChangeStates( PSTATEEXECENGCONTROL ptControl, U8 nNewState );
 static  STATEEXECENGARG GetEventFromTable( STATEEXECENGEVENT const* ptEvents, U8 nEventIndex );
+#if ( STATEEXECENG_ENABLE_COMPILED_EVENTS == 1 )
+static  PCOMPILEDSTATE  GetCompiledState( PSTATEEXECENGCONTROL ptControl );
+static  PCOMPILEDSTATE  FindCompiledState( STATEEXECENGTABLE const* ptStates, U8 nState, BOOL bCreate );
+static  void            CompileEvents( PCOMPILEDSTATE ptCompiled );
+static  STATEEXECENGEVENT const* SearchCompiledEvents( PCOMPILEDSTATE ptCompiled, STATEEXECENGARG xEvent );
+#endif // STATEEXECENG_ENABLE_COMPILED_EVENTS
 
 /******************************************************************************
  * @function StateExecutionEngine_Initialize
@@ -47,6 +91,12 @@ void StateExecutionEngine_Initialize( PSTATEEXECENGCONTROL ptControl, U8 nDefaul
   ptControl->nLastState = STATEEXECENG_STATE_NONE;
   ptControl->xLastEvent = 0;
   ptControl->nCurState = nDefaultState;
+  
+  #if ( STATEEXECENG_ENABLE_COMPILED_EVENTS == 1 )
+  // clear the compiled state
+  ptControl->nCompiledState = STATEEXECENG_STATE_NONE;
+  ptControl->nCompiledIdx = COMPILED_IDX_NONE;
+  #endif // STATEEXECENG_ENABLE_COMPILED_EVENTS
 
   // get the entry function
   pvEntryFunc = ( PVSTATEEXECENGENTFUNC )PGM_RDWORD( ptControl->ptStates[ ptControl->nCurState ].tFuncs.pvEntryFunc );
@@ -77,6 +127,10 @@ void StateExecutionEngine_Process( PSTATEEXECENGCONTROL ptControl, STATEEXECENGA
   PVSTATEEXECENGEXCFUNC		  pvExecFunc;
   STATEEXECENGEVENT const*  ptEvents;
   STATEEXECENGTABLE const*  ptStates;
+  #if ( STATEEXECENG_ENABLE_COMPILED_EVENTS == 1 )
+  PCOMPILEDSTATE            ptCompiled;
+  STATEEXECENGEVENT const*  ptEvent;
+  #endif // STATEEXECENG_ENABLE_COMPILED_EVENTS
   
   // get the pointer to the current state table
   ptStates = &ptControl->ptStates[ ptControl->nCurState ];
@@ -91,6 +145,32 @@ void StateExecutionEngine_Process( PSTATEEXECENGCONTROL ptControl, STATEEXECENGA
   // clear the state change flag
   bStateChangeReq = FALSE;
 
+  #if ( STATEEXECENG_ENABLE_COMPILED_EVENTS == 1 )
+  // get the compiled state
+  ptCompiled = GetCompiledState( ptControl );
+  
+  #if ( STATEEXECENG_ENABLE_HIT_COUNTERS == 1 )
+  // update the hit counter
+  if ( ptCompiled != NULL )
+  {
+    ptCompiled->uHits++;
+  }
+  #endif // STATEEXECENG_ENABLE_HIT_COUNTERS
+  
+  // are the events compiled
+  if (( ptCompiled != NULL ) && ( ptCompiled->bValid ))
+  {
+    // search for the event
+    if (( ptEvent = SearchCompiledEvents( ptCompiled, xEvent )) != NULL )
+    {
+      // set the found flag/next state/exit flag
+      bStateChangeReq = TRUE;
+      nNextState = ptEvent->nNextState;
+      ptControl->bExecExit = ptEvent->bExecuteExit;
+    }
+  }
+  else
+  #endif // STATEEXECENG_ENABLE_COMPILED_EVENTS
   // do we have an event table
   if ( ptEvents != NULL )
   {
@@ -217,4 +297,276 @@ static STATEEXECENGARG GetEventFromTable( STATEEXECENGEVENT const* ptEvents, U8
   return( xEvent );
 }
 
+#if ( STATEEXECENG_ENABLE_HIT_COUNTERS == 1 )
+/******************************************************************************
+ * @function StateExecutionEngine_GetHitCount
+ *
+ * @brief get a state hit count
+ *
+ * This function will return the number of events processed in a state, the
+ * count is shared by all instances using the same state table
+ *
+ * @param[in]   ptControl   pointer to the control structure
+ * @param[in]   nState      state
+ * @param[io]   puHits      pointer to store the count
+ *
+ * @return      TRUE if the state has a counter, FALSE if not
+ *
+ *****************************************************************************/
+BOOL StateExecutionEngine_GetHitCount( PSTATEEXECENGCONTROL ptControl, U8 nState, PU32 puHits )
+{
+  PCOMPILEDSTATE  ptCompiled;
+  BOOL            bStatus = FALSE;
+  
+  // find the state
+  *( puHits ) = 0;
+  if (( ptCompiled = FindCompiledState( ptControl->ptStates, nState, FALSE )) != NULL )
+  {
+    // return the count
+    *( puHits ) = ptCompiled->uHits;
+    bStatus = TRUE;
+  }
+  
+  // return the status
+  return( bStatus );
+}
+
+/******************************************************************************
+ * @function StateExecutionEngine_ClearHitCounts
+ *
+ * @brief clear the hit counts
+ *
+ * This function will clear the hit counts for all states
+ *
+ *****************************************************************************/
+void StateExecutionEngine_ClearHitCounts( void )
+{
+  U8  nIdx;
+  
+  // for each compiled state
+  for ( nIdx = 0; nIdx < STATEEXECENG_NUM_COMPILED_STATES; nIdx++ )
+  {
+    // clear the count
+    atCompiledStates[ nIdx ].uHits = 0;
+  }
+}
+#endif // STATEEXECENG_ENABLE_HIT_COUNTERS
+
+#if ( STATEEXECENG_ENABLE_COMPILED_EVENTS == 1 )
+/******************************************************************************
+ * @function GetCompiledState
+ *
+ * @brief get the compiled state
+ *
+ * This function will return the compiled state for the current state, it is
+ * looked up again if the current state has changed since the last event
+ *
+ * @param[in]   ptControl   pointer to the control structure
+ *
+ * @return      pointer to the compiled state or NULL if none
+ *
+ *****************************************************************************/
+static PCOMPILEDSTATE GetCompiledState( PSTATEEXECENGCONTROL ptControl )
+{
+  PCOMPILEDSTATE  ptCompiled = NULL;
+  
+  // check for a change of state
+  if ( ptControl->nCompiledState != ptControl->nCurState )
+  {
+    // find/create the compiled state
+    ptCompiled = FindCompiledState( ptControl->ptStates, ptControl->nCurState, TRUE );
+    ptControl->nCompiledState = ptControl->nCurState;
+    ptControl->nCompiledIdx = ( ptCompiled != NULL ) ? ( U8 )( ptCompiled - atCompiledStates ) : COMPILED_IDX_NONE;
+  }
+  else if ( ptControl->nCompiledIdx != COMPILED_IDX_NONE )
+  {
+    // use the saved index
+    ptCompiled = &atCompiledStates[ ptControl->nCompiledIdx ];
+  }
+  
+  // return the compiled state
+  return( ptCompiled );
+}
+
+/******************************************************************************
+ * @function FindCompiledState
+ *
+ * @brief find a compiled state
+ *
+ * This function will hash the state table and state to find its compiled 
+ * state, optionally creating and compiling it if not found
+ *
+ * @param[in]   ptStates    pointer to the state table
+ * @param[in]   nState      state
+ * @param[in]   bCreate     TRUE to create the state if not found
+ *
+ * @return      pointer to the compiled state or NULL if none
+ *
+ *****************************************************************************/
+static PCOMPILEDSTATE FindCompiledState( STATEEXECENGTABLE const* ptStates, U8 nState, BOOL bCreate )
+{
+  PCOMPILEDSTATE  ptCompiled = NULL;
+  U8              nIdx, nProbe;
+  
+  // compute the hash
+  nIdx = ( U8 )((( size_t )ptStates >> 2 ) + ( nState * 7 )) & COMPILED_STATE_MASK;
+  
+  // disable interrupts
+  Interrupt_Disable( );
+  
+  // probe for the state
+  for ( nProbe = 0; nProbe < STATEEXECENG_NUM_COMPILED_STATES; nProbe++, nIdx = ( nIdx + 1 ) & COMPILED_STATE_MASK )
+  {
+    // check for a match
+    if (( atCompiledStates[ nIdx ].ptStates == ptStates ) && ( atCompiledStates[ nIdx ].nState == nState ))
+    {
+      // found it
+      ptCompiled = &atCompiledStates[ nIdx ];
+      break;
+    }
+    else if ( atCompiledStates[ nIdx ].ptStates == NULL )
+    {
+      // check for create
+      if ( bCreate )
+      {
+        // create it/compile it
+        ptCompiled = &atCompiledStates[ nIdx ];
+        ptCompiled->ptStates = ptStates;
+        ptCompiled->nState = nState;
+        #if ( STATEEXECENG_ENABLE_HIT_COUNTERS == 1 )
+        ptCompiled->uHits = 0;
+        #endif // STATEEXECENG_ENABLE_HIT_COUNTERS
+        CompileEvents( ptCompiled );
+      }
+      
+      // done
+      break;
+    }
+  }
+  
+  // re-enable interrupts
+  Interrupt_Enable( );
+  
+  // return the compiled state
+  return( ptCompiled );
+}
+
+/******************************************************************************
+ * @function CompileEvents
+ *
+ * @brief compile the events
+ *
+ * This function will copy the events of the state into the compiled events, 
+ * sorted by event.  If an event appears more than once, the first is kept to
+ * match the table search.  If there is not enough room, the state is left
+ * invalid and the table search is used
+ *
+ * @param[in]   ptCompiled  pointer to the compiled state
+ *
+ *****************************************************************************/
+static void CompileEvents( PCOMPILEDSTATE ptCompiled )
+{
+  STATEEXECENGEVENT const*  ptEvents;
+  PSTATEEXECENGEVENT        ptSorted;
+  STATEEXECENGARG           xEvent;
+  U8                        nEventIndex, nIdx, nNumEvents;
+  BOOL                      bDuplicate;
+  
+  // get the event table
+  ptEvents = ( PSTATEEXECENGEVENT )PGM_RDWORD( ptCompiled->ptStates[ ptCompiled->nState ].ptEventTable );
+  ptSorted = &atCompiledEvents[ wNumCompiledEvents ];
+  nNumEvents = 0;
+  ptCompiled->bValid = TRUE;
+  
+  // for each event in the table
+  for ( nEventIndex = 0; ( ptEvents != NULL ) && (( xEvent = GetEventFromTable( ptEvents, nEventIndex )) != 0 ); nEventIndex++ )
+  {
+    // find the insert point
+    for ( nIdx = nNumEvents, bDuplicate = FALSE; ( nIdx > 0 ) && ( ptSorted[ nIdx - 1 ].xEvent >= xEvent ); nIdx-- )
+    {
+      // check for a duplicate
+      if ( ptSorted[ nIdx - 1 ].xEvent == xEvent )
+      {
+        bDuplicate = TRUE;
+        break;
+      }
+    }
+    
+    // skip duplicates
+    if ( !bDuplicate )
+    {
+      // check for room
+      if (( wNumCompiledEvents + nNumEvents ) >= STATEEXECENG_NUM_COMPILED_EVENTS )
+      {
+        // not valid/exit
+        ptCompiled->bValid = FALSE;
+        nNumEvents = 0;
+        break;
+      }
+      
+      // insert it
+      memmove( &ptSorted[ nIdx + 1 ], &ptSorted[ nIdx ], ( nNumEvents - nIdx ) * STATEEXECENGEVENT_SIZE );
+      ptSorted[ nIdx ].xEvent = xEvent;
+      ptSorted[ nIdx ].nNextState = PGM_RDBYTE( ptEvents[ nEventIndex ].nNextState );
+      ptSorted[ nIdx ].bExecuteExit = PGM_RDBYTE( ptEvents[ nEventIndex ].bExecuteExit );
+      nNumEvents++;
+    }
+  }
+  
+  // store the offset/count
+  ptCompiled->wOffset = wNumCompiledEvents;
+  ptCompiled->nNumEvents = nNumEvents;
+  wNumCompiledEvents += nNumEvents;
+}
+
+/******************************************************************************
+ * @function SearchCompiledEvents
+ *
+ * @brief search the compiled events
+ *
+ * This function will perform a binary search of the compiled events
+ *
+ * @param[in]   ptCompiled  pointer to the compiled state
+ * @param[in]   xEvent      event to find
+ *
+ * @return      pointer to the event or NULL if not found
+ *
+ *****************************************************************************/
+static STATEEXECENGEVENT const* SearchCompiledEvents( PCOMPILEDSTATE ptCompiled, STATEEXECENGARG xEvent )
+{
+  STATEEXECENGEVENT const*  ptEvents;
+  STATEEXECENGEVENT const*  ptEvent = NULL;
+  U8                        nLow, nHigh, nMid;
+  
+  // get the events
+  ptEvents = &atCompiledEvents[ ptCompiled->wOffset ];
+  nLow = 0;
+  nHigh = ptCompiled->nNumEvents;
+  
+  // search
+  while( nLow < nHigh )
+  {
+    // compute the middle/test it
+    nMid = ( nLow + nHigh ) >> 1;
+    if ( ptEvents[ nMid ].xEvent < xEvent )
+    {
+      nLow = nMid + 1;
+    }
+    else if ( ptEvents[ nMid ].xEvent > xEvent )
+    {
+      nHigh = nMid;
+    }
+    else
+    {
+      // found it
+      ptEvent = &ptEvents[ nMid ];
+      break;
+    }
+  }
+  
+  // return the event
+  return( ptEvent );
+}
+#endif // STATEEXECENG_ENABLE_COMPILED_EVENTS
+
 /**@} EOF StateExecutionEngine.c */
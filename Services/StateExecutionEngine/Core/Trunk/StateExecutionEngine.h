@@ -122,12 +122,20 @@ typedef struct _STATEEXECENGCONTROL
   BOOL                      bFlushEvent;  ///< flush event flag
   STATEEXECENGTABLE const*  ptStates;     ///< pointer to the states for this instance
   //  PVOID                     pvArg;        ///< pointer to an user supplied argument
+  #if ( STATEEXECENG_ENABLE_COMPILED_EVENTS == 1 )
+  U8                        nCompiledState; ///< state of the compiled index
+  U8                        nCompiledIdx;   ///< compiled state index
+  #endif // STATEEXECENG_ENABLE_COMPILED_EVENTS
 } STATEEXECENGCONTROL, *PSTATEEXECENGCONTROL;
 #define STATEEXECENGCONTROL_SIZE  sizeof( STATEEXECENGCONTROL )
 
 // global function prototypes --------------------------------------------------
 extern  void  StateExecutionEngine_Initialize( PSTATEEXECENGCONTROL ptControl, U8 nDefaultState );
 extern  void  StateExecutionEngine_Process( PSTATEEXECENGCONTROL ptControl, STATEEXECENGARG xEvent );
+#if ( STATEEXECENG_ENABLE_HIT_COUNTERS == 1 )
+extern  BOOL  StateExecutionEngine_GetHitCount( PSTATEEXECENGCONTROL ptControl, U8 nState, PU32 puHits );
+extern  void  StateExecutionEngine_ClearHitCounts( void );
+#endif // STATEEXECENG_ENABLE_HIT_COUNTERS
 
 /**@} EOF StateExecutionEngine.h */
 
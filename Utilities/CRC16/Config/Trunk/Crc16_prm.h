@@ -0,0 +1,40 @@
+/******************************************************************************
+ * @file CRC16_prm.h
+ *
+ * @brief CRC16 parameter declarations
+ *
+ * This file provides the parameter declarations for the CRC16 module
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Cyber Integration 
+ * LLC. It is the exclusive property of Cyber Integration, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Cyber Integration, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Cyber Integration, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ * 
+ *
+ * \addtogroup CRC16
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _CRC16_PRM_H
+#define _CRC16_PRM_H
+
+// Macros and Defines ---------------------------------------------------------
+/// define the macro to use the 256 entry table ( 512 bytes ) instead of the nibble table - set to 1 to enable
+#define CRC16_ENABLE_TABLE256                     ( 0 )
+
+/// define the macro to use the slice-by-4 tables ( 2K ), implies the 256 entry table - set to 1 to enable
+#define CRC16_ENABLE_SLICEBY4                     ( 0 )
+
+/// define the macro to use PCLMUL folding on x86 hosts when the CPU supports it - set to 1 to enable
+#define CRC16_ENABLE_HWACCEL                      ( 0 )
+
+/**@} EOF CRC16_prm.h */
+
+#endif  // _CRC16_PRM_H
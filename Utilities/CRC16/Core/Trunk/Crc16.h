@@ -28,6 +28,7 @@
 // system includes ------------------------------------------------------------
 
 // local includes -------------------------------------------------------------
+#include "CRC16/Crc16_prm.h"
 
 // library includes -----------------------------------------------------------
 #include "Types/Types.h"
@@ -44,6 +45,7 @@
 extern	U16	CRC16_GetInitialValue( void );
 extern	U16	CRC16_CalculateByte( U16 wOldCrc, U8 nData );
 extern	U16	CRC16_CalculateBlock( PU8 pnData, U16 wLength );
+extern	U16	CRC16_Update( U16 wCrc, PU8 pnData, U16 wLength );
 
 /**@} EOF CRC16.h */
 
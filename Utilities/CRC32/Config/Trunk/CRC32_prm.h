@@ -0,0 +1,37 @@
+/******************************************************************************
+ * @file CRC32_prm.h
+ *
+ * @brief CRC32 parameter declarations
+ *
+ * This file provides the parameter declarations for the CRC32 module
+ *
+ * @copyright Copyright (c) 2012 Cyber Intergration
+ * This document contains proprietary data and information of Endurance Products 
+ * LLC. It is the exclusive property of Endurance Products, LLC and will not be 
+ * disclosed in any form to any party without prior written permission of 
+ * Endurance Products, LLC. This document may not be reproduced or further used 
+ * without the prior written permission of Endurance Products, LLC.
+ *
+ * Version History
+ * ======
+ * $Log: $
+ * 
+ *
+ * \addtogroup CRC32
+ * @{
+ *****************************************************************************/
+ 
+// ensure only one instantiation
+#ifndef _CRC32_PRM_H
+#define _CRC32_PRM_H
+
+// Macros and Defines ---------------------------------------------------------
+/// define the macro to use the slice-by-8 tables ( 8K ) instead of the nibble table - set to 1 to enable
+#define CRC32_ENABLE_SLICEBY8                     ( 0 )
+
+/// define the macro to use PCLMUL folding on x86 hosts when the CPU supports it - set to 1 to enable
+#define CRC32_ENABLE_HWACCEL                      ( 0 )
+
+/**@} EOF CRC32_prm.h */
+
+#endif  // _CRC32_PRM_H
@@ -28,6 +28,7 @@
 // system includes ------------------------------------------------------------
 
 // local includes -------------------------------------------------------------
+#include "CRC32/CRC32_prm.h"
 
 // library includes -----------------------------------------------------------
 #include "Types/Types.h"
@@ -44,6 +45,9 @@
 extern	U32	CRC32_GetInitialValue( void );
 extern	U32	CRC32_CalculateByte( U32 uOldCrc, U8 nData );
 extern	U32	CRC32_CalculateBlock( PU8 pnData, U32 uLength );
+extern	U32	CRC32_Begin( void );
+extern	U32	CRC32_Update( U32 uCrc, PU8 pnData, U32 uLength );
+extern	U32	CRC32_Final( U32 uCrc );
 
 /**@} EOF CRC32.h */
 